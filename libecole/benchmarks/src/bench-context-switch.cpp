@@ -0,0 +1,130 @@
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+
+#include <ucontext.h>
+
+#include "ecole/dynamics/branching.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/utility/coroutine-stack.hpp"
+#include "ecole/utility/execution-context.hpp"
+
+#include "bench-context-switch.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** Number of switches per second, timing a function making the given number of switches. */
+template <typename Func> auto switches_per_second(std::size_t n_switches, Func&& make_switches) -> double {
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	make_switches();
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	return static_cast<double>(n_switches) / std::chrono::duration<double>(wall_time_after - wall_time_before).count();
+}
+
+/** Two contexts switching back and forth with ``swapcontext``, as coroutines used to. */
+struct SwapcontextPingPong {
+	utility::CoroutineStack stack;
+	ucontext_t main_context = {};
+	ucontext_t other_context = {};
+
+	static SwapcontextPingPong* current;
+
+	static void run() {
+		while (true) {
+			swapcontext(&current->other_context, &current->main_context);
+		}
+	}
+
+	auto operator()(std::size_t n_switches) -> void {
+		if (getcontext(&other_context) != 0) {
+			throw std::runtime_error{"Could not get the current context."};
+		}
+		other_context.uc_stack.ss_sp = stack.data();
+		other_context.uc_stack.ss_size = stack.size();
+		other_context.uc_link = nullptr;
+		makecontext(&other_context, &SwapcontextPingPong::run, 0);
+		current = this;
+		for (std::size_t i = 0; i < n_switches / 2; ++i) {
+			swapcontext(&main_context, &other_context);
+		}
+	}
+};
+
+SwapcontextPingPong* SwapcontextPingPong::current = nullptr;
+
+/** Two contexts switching back and forth with an ExecutionContext. */
+struct ExecutionContextPingPong {
+	utility::CoroutineStack stack;
+	utility::ExecutionContext main_context;
+	std::optional<utility::ExecutionContext> other_context;
+
+	static void run(void* self) noexcept {
+		auto* const ping_pong = static_cast<ExecutionContextPingPong*>(self);
+		while (true) {
+			ping_pong->other_context->switch_to(ping_pong->main_context);
+		}
+	}
+
+	auto operator()(std::size_t n_switches) -> void {
+		other_context.emplace(stack, &ExecutionContextPingPong::run, this);
+		for (std::size_t i = 0; i < n_switches / 2; ++i) {
+			main_context.switch_to(*other_context);
+		}
+	}
+};
+
+}  // namespace
+
+auto ContextSwitchResult::csv_title() -> std::string {
+	return make_csv("backend", "n_switches", "swapcontext_switches_per_s", "execution_context_switches_per_s");
+}
+
+auto ContextSwitchResult::csv() -> std::string {
+	return make_csv(backend, n_switches, swapcontext_switches_per_s, execution_context_switches_per_s);
+}
+
+auto benchmark_context_switch(std::size_t n_switches) -> ContextSwitchResult {
+	// The contexts are never finished, so they outlive the benchmark with their stack
+	auto swapcontext_ping_pong = SwapcontextPingPong{};
+	auto execution_context_ping_pong = ExecutionContextPingPong{};
+	return {
+		utility::ExecutionContext::backend(),
+		n_switches,
+		switches_per_second(n_switches, [&] { swapcontext_ping_pong(n_switches); }),
+		switches_per_second(n_switches, [&] { execution_context_ping_pong(n_switches); }),
+	};
+}
+
+auto StepsResult::csv_title() -> std::string {
+	return merge_csv(InstanceFeatures::csv_title(), make_csv("backend", "n_steps", "steps_per_s"));
+}
+
+auto StepsResult::csv() -> std::string {
+	return merge_csv(instance.csv(), make_csv(backend, n_steps, steps_per_s));
+}
+
+auto benchmark_steps(scip::Model const& model) -> StepsResult {
+	auto m = model.copy_orig();
+	auto dyn = dynamics::BranchingDynamics{};
+	auto n_steps = std::size_t{0};
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	auto [done, action_set] = dyn.reset_dynamics(m);
+	while (!done) {
+		std::tie(done, action_set) = dyn.step_dynamics(m, action_set.value()[0]);
+		++n_steps;
+	}
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	return {
+		InstanceFeatures::from_model(model.copy_orig()),
+		utility::ExecutionContext::backend(),
+		n_steps,
+		static_cast<double>(n_steps) / std::chrono::duration<double>(wall_time_after - wall_time_before).count(),
+	};
+}
+
+}  // namespace ecole::benchmark
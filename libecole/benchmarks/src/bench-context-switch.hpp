@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct ContextSwitchResult {
+	std::string backend;
+	std::size_t n_switches = 0;
+	double swapcontext_switches_per_s = 0.;
+	double execution_context_switches_per_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the rate of context switches of the coroutines against ``swapcontext``.
+ *
+ * Switches go back and forth between the calling thread and a context that does nothing else.
+ */
+auto benchmark_context_switch(std::size_t n_switches) -> ContextSwitchResult;
+
+struct StepsResult {
+	InstanceFeatures instance;
+	std::string backend;
+	std::size_t n_steps = 0;
+	double steps_per_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the rate of steps of the branching dynamics, each of which switches twice between contexts.
+ *
+ * The context switch backend is selected when building Ecole, so backends are compared across builds.
+ */
+auto benchmark_steps(scip::Model const& model) -> StepsResult;
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,80 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ecole/scip/model.hpp"
+
+#include "bench-copy.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+auto benchmark_copy(
+	scip::Model const& model,
+	InstanceFeatures const& instance,
+	std::size_t n_threads,
+	std::size_t n_copies_per_thread) -> CopyResult {
+	auto own_models = std::vector<scip::Model>{};
+	own_models.reserve(n_threads);
+	auto own_model_ptrs = std::vector<scip::Model const*>{};
+	for (std::size_t i = 0; i < n_threads; ++i) {
+		own_models.push_back(model.copy_orig());
+		own_model_ptrs.push_back(&own_models.back());
+	}
+	auto const shared_model_ptrs = std::vector<scip::Model const*>(n_threads, &model);
+
+	auto const copy_orig = [](scip::Model const& m) { return m.copy_orig(); };
+	return {
+		instance,
+		n_threads,
+		n_copies_per_thread,
+		measure_parallel_throughput(shared_model_ptrs, n_copies_per_thread, copy_orig),
+		measure_parallel_throughput(own_model_ptrs, n_copies_per_thread, copy_orig),
+		measure_parallel_throughput(own_model_ptrs, n_copies_per_thread, [](auto const& m) { return m.copy(); }),
+	};
+}
+
+}  // namespace
+
+auto CopyResult::csv_title() -> std::string {
+	return merge_csv(
+		InstanceFeatures::csv_title(),
+		make_csv("n_threads", "n_copies_per_thread", "shared_copy_orig_per_s", "copy_orig_per_s", "copy_per_s"));
+}
+
+auto CopyResult::csv() -> std::string {
+	return merge_csv(
+		instance.csv(),
+		make_csv(n_threads, n_copies_per_thread, shared_copy_orig_per_s, copy_orig_per_s, copy_per_s));
+}
+
+auto CopyScalingResult::csv_title() -> std::string {
+	return CopyResult::csv_title();
+}
+
+auto CopyScalingResult::csv() -> std::string {
+	auto lines = std::vector<std::string>{};
+	lines.reserve(results.size());
+	for (auto& result : results) {
+		lines.push_back(result.csv());
+	}
+	return fmt::format("{}", fmt::join(lines, "\n"));
+}
+
+auto benchmark_copy_scaling(
+	scip::Model const& model,
+	std::vector<std::size_t> const& n_threads,
+	std::size_t n_copies_per_thread) -> CopyScalingResult {
+	auto const instance = InstanceFeatures::from_model(model.copy_orig());
+	auto result = CopyScalingResult{};
+	for (auto const n : n_threads) {
+		result.results.push_back(benchmark_copy(model, instance, n, n_copies_per_thread));
+	}
+	return result;
+}
+
+}  // namespace ecole::benchmark
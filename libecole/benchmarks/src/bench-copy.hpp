@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct CopyResult {
+	InstanceFeatures instance;
+	std::size_t n_threads = 0;
+	std::size_t n_copies_per_thread = 0;
+	double shared_copy_orig_per_s = 0.;
+	double copy_orig_per_s = 0.;
+	double copy_per_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/** Results for increasing number of threads, with one csv line per number of threads. */
+struct CopyScalingResult {
+	std::vector<CopyResult> results;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the throughput of concurrent Model copies.
+ *
+ * Threads either all copy the same Model (as when resetting environments on the same instance), or each copy their
+ * own Model.
+ */
+auto benchmark_copy_scaling(
+	scip::Model const& model,
+	std::vector<std::size_t> const& n_threads,
+	std::size_t n_copies_per_thread) -> CopyScalingResult;
+
+}  // namespace ecole::benchmark
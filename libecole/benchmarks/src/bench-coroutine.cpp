@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <sys/resource.h>
+
+#include "ecole/dynamics/branching.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/utility/coroutine-stack.hpp"
+
+#include "bench-coroutine.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+auto n_minor_page_faults() -> std::size_t {
+	struct rusage usage {};
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<std::size_t>(usage.ru_minflt);
+}
+
+/** Time the reset of the branching dynamics, which starts the solving coroutine. */
+auto measure_resets(scip::Model const& model, std::size_t n_resets, bool pooled) -> StackMetrics {
+	auto metrics = StackMetrics{};
+	auto const faults_before = n_minor_page_faults();
+	for (std::size_t i = 0; i < n_resets; ++i) {
+		if (!pooled) {
+			utility::CoroutineStack::release_free_list();
+		}
+		// Copy outside of the timed section, and destroy the model (releasing the stack) after it
+		auto m = model.copy_orig();
+		auto dyn = dynamics::BranchingDynamics{};
+		auto const wall_time_before = std::chrono::steady_clock::now();
+		dyn.reset_dynamics(m);
+		auto const wall_time_after = std::chrono::steady_clock::now();
+		metrics.reset_wall_time_s += std::chrono::duration<double>(wall_time_after - wall_time_before).count();
+	}
+	metrics.n_minor_page_faults = n_minor_page_faults() - faults_before;
+	return metrics;
+}
+
+/** Size of each of the two stacks embedded in the executor of a coroutine before they were mapped and pooled. */
+constexpr std::size_t fixed_stack_size = 18192;
+/** Top of the stacks written when acquiring them, as the first frames of a coroutine would. */
+constexpr std::size_t touched_size = 16UL * 1024UL;
+constexpr std::size_t touch_stride = 4096;
+
+/** Write one byte per page at the top of a stack, since stacks grow downward. */
+void touch_top(char* data, std::size_t size) {
+	auto* const top = static_cast<char volatile*>(data) + size;
+	for (std::size_t offset = 1; offset <= std::min(size, touched_size); offset += touch_stride) {
+		*(top - offset) = 0;
+	}
+}
+
+/** The executor of the former design, whose stacks were allocated along with it. */
+struct FixedStacks {
+	char stack_main[fixed_stack_size];       // NOLINT(cppcoreguidelines-avoid-c-arrays)
+	char stack_generator[fixed_stack_size];  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+};
+
+/** Time getting a stack and writing its top, with the given design. */
+template <typename AcquireFunc> auto measure_acquires(std::size_t n_acquires, AcquireFunc&& acquire) -> AcquireMetrics {
+	auto metrics = AcquireMetrics{};
+	auto const faults_before = n_minor_page_faults();
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < n_acquires; ++i) {
+		acquire();
+	}
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	metrics.wall_time_s = std::chrono::duration<double>(wall_time_after - wall_time_before).count();
+	metrics.n_minor_page_faults = n_minor_page_faults() - faults_before;
+	return metrics;
+}
+
+auto measure_fixed_acquires(std::size_t n_acquires) -> AcquireMetrics {
+	return measure_acquires(n_acquires, [] {
+		// Not value initialized, as the members of the former executor
+		auto const stacks = std::unique_ptr<FixedStacks>{new FixedStacks};
+		touch_top(stacks->stack_generator, fixed_stack_size);
+	});
+}
+
+auto measure_mapped_acquires(std::size_t n_acquires, bool pooled) -> AcquireMetrics {
+	return measure_acquires(n_acquires, [pooled] {
+		if (!pooled) {
+			utility::CoroutineStack::release_free_list();
+		}
+		auto const stack = utility::CoroutineStack{};
+		touch_top(static_cast<char*>(stack.data()), stack.size());
+	});
+}
+
+}  // namespace
+
+auto StackMetrics::csv_title(std::string_view prefix) -> std::string {
+	return make_csv(fmt::format("{}reset_wall_time_s", prefix), fmt::format("{}n_minor_page_faults", prefix));
+}
+
+auto StackMetrics::csv() -> std::string {
+	return make_csv(reset_wall_time_s, n_minor_page_faults);
+}
+
+auto AcquireMetrics::csv_title(std::string_view prefix) -> std::string {
+	return make_csv(fmt::format("{}acquire_wall_time_s", prefix), fmt::format("{}acquire_n_minor_page_faults", prefix));
+}
+
+auto AcquireMetrics::csv() -> std::string {
+	return make_csv(wall_time_s, n_minor_page_faults);
+}
+
+auto CoroutineResult::csv_title() -> std::string {
+	return merge_csv(
+		InstanceFeatures::csv_title(),
+		make_csv("n_resets"),
+		StackMetrics::csv_title("pooled:"),
+		StackMetrics::csv_title("unpooled:"),
+		AcquireMetrics::csv_title("fixed:"),
+		AcquireMetrics::csv_title("pooled:"),
+		AcquireMetrics::csv_title("unpooled:"));
+}
+
+auto CoroutineResult::csv() -> std::string {
+	return merge_csv(
+		instance.csv(),
+		make_csv(n_resets),
+		pooled_stack_metrics.csv(),
+		unpooled_stack_metrics.csv(),
+		fixed_acquire_metrics.csv(),
+		pooled_acquire_metrics.csv(),
+		unpooled_acquire_metrics.csv());
+}
+
+auto benchmark_coroutine(scip::Model const& model, std::size_t n_resets) -> CoroutineResult {
+	// Warm up the free list so that the first pooled reset does not map a stack.
+	utility::CoroutineStack{}.size();
+	return {
+		InstanceFeatures::from_model(model.copy_orig()),
+		n_resets,
+		measure_resets(model, n_resets, true),
+		measure_resets(model, n_resets, false),
+		measure_fixed_acquires(n_resets),
+		measure_mapped_acquires(n_resets, true),
+		measure_mapped_acquires(n_resets, false),
+	};
+}
+
+}  // namespace ecole::benchmark
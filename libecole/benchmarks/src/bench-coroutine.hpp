@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct StackMetrics {
+	double reset_wall_time_s = 0.;
+	std::size_t n_minor_page_faults = 0;
+
+	static auto csv_title(std::string_view prefix = "") -> std::string;
+	auto csv() -> std::string;
+};
+
+/** Cost of getting a stack and writing the first frames of a coroutine on it, without running the solver. */
+struct AcquireMetrics {
+	double wall_time_s = 0.;
+	std::size_t n_minor_page_faults = 0;
+
+	static auto csv_title(std::string_view prefix = "") -> std::string;
+	auto csv() -> std::string;
+};
+
+struct CoroutineResult {
+	InstanceFeatures instance;
+	std::size_t n_resets = 0;
+	StackMetrics pooled_stack_metrics;
+	StackMetrics unpooled_stack_metrics;
+	/** Baseline of the former design, with two fixed-size stacks allocated with every coroutine. */
+	AcquireMetrics fixed_acquire_metrics;
+	AcquireMetrics pooled_acquire_metrics;
+	AcquireMetrics unpooled_acquire_metrics;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the latency of starting the solving coroutine with and without reusing coroutine stacks.
+ *
+ * The former fixed-size stacks are too small to run the solver on most instances, so they are only compared on the
+ * cost of getting a stack.
+ */
+auto benchmark_coroutine(scip::Model const& model, std::size_t n_resets) -> CoroutineResult;
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,55 @@
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ecole/scip/callback.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-fork.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** Models paused at their first branching node. */
+auto make_solving_models(scip::Model const& model, std::size_t n_models) -> std::vector<scip::Model> {
+	auto models = std::vector<scip::Model>{};
+	models.reserve(n_models);
+	for (std::size_t i = 0; i < n_models; ++i) {
+		models.push_back(model.copy_orig());
+		if (!models.back().solve_iter(scip::callback::BranchruleConstructor{}).has_value()) {
+			throw std::runtime_error{"Instance solved before branching."};
+		}
+	}
+	return models;
+}
+
+}  // namespace
+
+auto ForkResult::csv_title() -> std::string {
+	return merge_csv(
+		InstanceFeatures::csv_title(), make_csv("n_threads", "n_copies_per_thread", "copy_per_s", "fork_per_s"));
+}
+
+auto ForkResult::csv() -> std::string {
+	return merge_csv(instance.csv(), make_csv(n_threads, n_copies_per_thread, copy_per_s, fork_per_s));
+}
+
+auto benchmark_fork(scip::Model const& model, std::size_t n_threads, std::size_t n_copies_per_thread) -> ForkResult {
+	auto const models = make_solving_models(model, n_threads);
+	auto model_ptrs = std::vector<scip::Model const*>{};
+	for (auto const& m : models) {
+		model_ptrs.push_back(&m);
+	}
+	return {
+		InstanceFeatures::from_model(model.copy_orig()),
+		n_threads,
+		n_copies_per_thread,
+		measure_parallel_throughput(model_ptrs, n_copies_per_thread, [](auto const& m) { return m.copy(); }),
+		measure_parallel_throughput(model_ptrs, n_copies_per_thread, [](auto const& m) { return m.fork(); }),
+	};
+}
+
+}  // namespace ecole::benchmark
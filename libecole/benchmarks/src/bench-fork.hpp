@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct ForkResult {
+	InstanceFeatures instance;
+	std::size_t n_threads = 0;
+	std::size_t n_copies_per_thread = 0;
+	double copy_per_s = 0.;
+	double fork_per_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the throughput of Model::fork against Model::copy.
+ *
+ * Every thread repeatedly copies its own Model, paused at the first branching node.
+ */
+auto benchmark_fork(scip::Model const& model, std::size_t n_threads, std::size_t n_copies_per_thread) -> ForkResult;
+
+}  // namespace ecole::benchmark
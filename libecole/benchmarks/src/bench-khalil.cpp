@@ -0,0 +1,78 @@
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ecole/dynamics/branching.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-khalil.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+auto benchmark_khalil(
+	scip::Model const& model,
+	InstanceFeatures const& instance,
+	std::size_t n_threads,
+	std::size_t n_extractions) -> KhalilResult {
+	auto result = KhalilResult{instance, n_threads, n_extractions};
+	auto obs_func = observation::Khalil2016{0, n_threads};
+	for (std::size_t i = 0; i < n_extractions; ++i) {
+		// Copy and solve the root node outside of the timed section
+		auto m = model.copy_orig();
+		auto dyn = dynamics::BranchingDynamics{};
+		obs_func.before_reset(m);
+		auto const [done, action_set] = dyn.reset_dynamics(m);
+		if (done) {
+			continue;
+		}
+		auto const wall_time_before = std::chrono::steady_clock::now();
+		obs_func.extract(m, done);
+		auto const wall_time_after = std::chrono::steady_clock::now();
+		result.root_extract_wall_time_s += std::chrono::duration<double>(wall_time_after - wall_time_before).count();
+	}
+	return result;
+}
+
+}  // namespace
+
+auto KhalilResult::csv_title() -> std::string {
+	return merge_csv(InstanceFeatures::csv_title(), make_csv("n_threads", "n_extractions", "root_extract_wall_time_s"));
+}
+
+auto KhalilResult::csv() -> std::string {
+	return merge_csv(instance.csv(), make_csv(n_threads, n_extractions, root_extract_wall_time_s));
+}
+
+auto KhalilScalingResult::csv_title() -> std::string {
+	return KhalilResult::csv_title();
+}
+
+auto KhalilScalingResult::csv() -> std::string {
+	auto lines = std::vector<std::string>{};
+	lines.reserve(results.size());
+	for (auto& result : results) {
+		lines.push_back(result.csv());
+	}
+	return fmt::format("{}", fmt::join(lines, "\n"));
+}
+
+auto benchmark_khalil_scaling(
+	scip::Model const& model,
+	std::vector<std::size_t> const& n_threads,
+	std::size_t n_extractions) -> KhalilScalingResult {
+	auto const instance = InstanceFeatures::from_model(model.copy_orig());
+	auto result = KhalilScalingResult{};
+	for (auto const n : n_threads) {
+		result.results.push_back(benchmark_khalil(model, instance, n, n_extractions));
+	}
+	return result;
+}
+
+}  // namespace ecole::benchmark
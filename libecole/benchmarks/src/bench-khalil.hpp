@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct KhalilResult {
+	InstanceFeatures instance;
+	std::size_t n_threads = 0;
+	std::size_t n_extractions = 0;
+	double root_extract_wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/** Results for increasing number of threads, with one csv line per number of threads. */
+struct KhalilScalingResult {
+	std::vector<KhalilResult> results;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the extraction of Khalil2016 observations at the root node, where static features are computed.
+ *
+ * Zero threads means that static features are computed in the calling thread.
+ */
+auto benchmark_khalil_scaling(
+	scip::Model const& model,
+	std::vector<std::size_t> const& n_threads,
+	std::size_t n_extractions) -> KhalilScalingResult;
+
+}  // namespace ecole::benchmark
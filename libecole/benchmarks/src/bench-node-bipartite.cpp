@@ -0,0 +1,67 @@
+#include <chrono>
+#include <tuple>
+
+#include "ecole/dynamics/branching.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-node-bipartite.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** Extract an observation and add the elapsed time to the total. */
+template <typename ObservationFunction>
+void timed_extract(ObservationFunction& obs_func, scip::Model& model, bool done, double& wall_time_s) {
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	obs_func.extract(model, done);
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	wall_time_s += std::chrono::duration<double>(wall_time_after - wall_time_before).count();
+}
+
+}  // namespace
+
+auto NodeBipartiteResult::csv_title() -> std::string {
+	return merge_csv(
+		InstanceFeatures::csv_title(),
+		make_csv(
+			"n_extractions",
+			"full_extract_wall_time_s",
+			"incremental_extract_wall_time_s",
+			"incremental_csr_extract_wall_time_s"));
+}
+
+auto NodeBipartiteResult::csv() -> std::string {
+	return merge_csv(
+		instance.csv(),
+		make_csv(
+			n_extractions,
+			full_extract_wall_time_s,
+			incremental_extract_wall_time_s,
+			incremental_csr_extract_wall_time_s));
+}
+
+auto benchmark_node_bipartite(scip::Model const& model) -> NodeBipartiteResult {
+	auto result = NodeBipartiteResult{InstanceFeatures::from_model(model.copy_orig())};
+	auto full_func = observation::NodeBipartite{};
+	auto incremental_func = observation::NodeBipartite{false, true};
+	auto incremental_csr_func = observation::NodeBipartite{false, true, true};
+	auto m = model.copy_orig();
+	full_func.before_reset(m);
+	incremental_func.before_reset(m);
+	incremental_csr_func.before_reset(m);
+	auto dyn = dynamics::BranchingDynamics{};
+	auto [done, action_set] = dyn.reset_dynamics(m);
+	while (!done) {
+		timed_extract(full_func, m, done, result.full_extract_wall_time_s);
+		timed_extract(incremental_func, m, done, result.incremental_extract_wall_time_s);
+		timed_extract(incremental_csr_func, m, done, result.incremental_csr_extract_wall_time_s);
+		++result.n_extractions;
+		std::tie(done, action_set) = dyn.step_dynamics(m, action_set.value()[0]);
+	}
+	return result;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct NodeBipartiteResult {
+	InstanceFeatures instance;
+	std::size_t n_extractions = 0;
+	double full_extract_wall_time_s = 0.;
+	double incremental_extract_wall_time_s = 0.;
+	double incremental_csr_extract_wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the extraction of NodeBipartite observations from scratch against the incremental mode.
+ *
+ * All observation functions extract on every node of the same branching episode, so that they see the same changes.
+ */
+auto benchmark_node_bipartite(scip::Model const& model) -> NodeBipartiteResult;
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,96 @@
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <range/v3/view/transform.hpp>
+
+#include "utility/math.hpp"
+
+#include "bench-stats.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** Time the repeated computation of statistics. */
+template <typename Func>
+auto time_stats(std::string implementation, std::size_t n_values, std::size_t n_repeats, Func&& compute)
+	-> StatsResult {
+	// Accumulate a result so that the computation is not optimized away
+	auto volatile sink = 0.;
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < n_repeats; ++i) {
+		sink = sink + compute().stddev;
+	}
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	return {
+		std::move(implementation),
+		n_values,
+		n_repeats,
+		std::chrono::duration<double>(wall_time_after - wall_time_before).count(),
+	};
+}
+
+auto make_values(std::size_t n_values) -> std::vector<double> {
+	auto rng = std::mt19937{};  // NOLINT(cert-msc32-c, cert-msc51-cpp) Same values for all implementations
+	auto distribution = std::normal_distribution<double>{};
+	auto values = std::vector<double>(n_values);
+	for (auto& val : values) {
+		val = distribution(rng);
+	}
+	return values;
+}
+
+}  // namespace
+
+auto StatsResult::csv_title() -> std::string {
+	return make_csv("implementation", "n_values", "n_repeats", "wall_time_s");
+}
+
+auto StatsResult::csv() -> std::string {
+	return make_csv(implementation, n_values, n_repeats, wall_time_s);
+}
+
+auto StatsScalingResult::csv_title() -> std::string {
+	return StatsResult::csv_title();
+}
+
+auto StatsScalingResult::csv() -> std::string {
+	auto lines = std::vector<std::string>{};
+	lines.reserve(results.size());
+	for (auto& result : results) {
+		lines.push_back(result.csv());
+	}
+	return fmt::format("{}", fmt::join(lines, "\n"));
+}
+
+auto benchmark_stats(std::vector<std::size_t> const& n_values, std::size_t n_repeats) -> StatsScalingResult {
+	using utility::StatsKernel;
+	auto const kernels = std::vector<std::pair<StatsKernel, std::string>>{
+		{StatsKernel::scalar, "scalar"},
+		{StatsKernel::avx2, "avx2"},
+		{StatsKernel::avx512, "avx512"},
+	};
+
+	auto result = StatsScalingResult{};
+	for (auto const n : n_values) {
+		auto const values = make_values(n);
+		result.results.push_back(time_stats("views", n, n_repeats, [&values] {
+			return utility::compute_stats(values | ranges::views::transform([](auto val) { return val; }));
+		}));
+		for (auto const& [kernel, name] : kernels) {
+			if (utility::is_supported(kernel)) {
+				auto compute = [&values, kernel = kernel] { return utility::compute_stats(values, kernel); };
+				result.results.push_back(time_stats(name, n, n_repeats, compute));
+			}
+		}
+	}
+	return result;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ecole::benchmark {
+
+struct StatsResult {
+	std::string implementation;
+	std::size_t n_values = 0;
+	std::size_t n_repeats = 0;
+	double wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/** Results for all implementations and sizes, with one csv line each. */
+struct StatsScalingResult {
+	std::vector<StatsResult> results;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the statistics of contiguous values against the views based implementation.
+ *
+ * Each supported vectorized kernel is compared with the statistics computed one element at a time through a range-v3
+ * view, as done in the observation functions.
+ */
+auto benchmark_stats(std::vector<std::size_t> const& n_values, std::size_t n_repeats) -> StatsScalingResult;
+
+}  // namespace ecole::benchmark
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 #include "ecole/scip/model.hpp"
 
@@ -31,4 +35,31 @@ struct Metrics {
 	auto csv() -> std::string;
 };
 
+/**
+ * Number of calls per second made by all threads together.
+ *
+ * One thread is started per model, and calls the function the given number of times on that model.
+ * The same model can be given multiple times to have threads share it.
+ */
+template <typename Func>
+auto measure_parallel_throughput(
+	std::vector<scip::Model const*> const& models, std::size_t n_calls_per_thread, Func&& func) -> double {
+	auto threads = std::vector<std::thread>{};
+	threads.reserve(models.size());
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	for (auto const* model : models) {
+		threads.emplace_back([model, &func, n_calls_per_thread] {
+			for (std::size_t i = 0; i < n_calls_per_thread; ++i) {
+				func(*model);
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	auto const n_calls = static_cast<double>(models.size() * n_calls_per_thread);
+	return n_calls / std::chrono::duration<double>(wall_time_after - wall_time_before).count();
+}
+
 }  // namespace ecole::benchmark
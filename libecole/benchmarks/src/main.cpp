@@ -2,6 +2,8 @@
 #include <iostream>
 #include <optional>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <CLI/CLI.hpp>
 
@@ -11,8 +13,16 @@
 #include "ecole/instance/set-cover.hpp"
 #include "ecole/random.hpp"
 #include "ecole/scip/seed.hpp"
+#include "ecole/utility/coroutine-stack.hpp"
 
 #include "bench-branching.hpp"
+#include "bench-context-switch.hpp"
+#include "bench-copy.hpp"
+#include "bench-coroutine.hpp"
+#include "bench-fork.hpp"
+#include "bench-khalil.hpp"
+#include "bench-node-bipartite.hpp"
+#include "bench-stats.hpp"
 #include "benchmark.hpp"
 
 using namespace ecole::benchmark;
@@ -32,10 +42,10 @@ void seed_model(ecole::scip::Model& model, ecole::RandomGenerator& rng) {
 	model.set_param("randomization/lpseed", seed_distrib(rng));
 }
 
-/** The generators used to benchmark branching dynamics. */
-auto benchmark_branching(std::size_t n_instances, std::size_t n_nodes) {
+/** The generators used to benchmark Ecole. */
+auto make_generators() {
 	using GraphType = typename ecole::instance::IndependentSetGenerator::Parameters::GraphType;
-	auto generators = std::tuple{
+	return std::tuple{
 		SetCoverGenerator{{500, 1000}},                           // NOLINT(readability-magic-numbers)
 		SetCoverGenerator{{1000, 1000}},                          // NOLINT(readability-magic-numbers)
 		SetCoverGenerator{{2000, 1000}},                          // NOLINT(readability-magic-numbers)
@@ -49,9 +59,22 @@ auto benchmark_branching(std::size_t n_instances, std::size_t n_nodes) {
 		IndependentSetGenerator{{1000, GraphType::erdos_renyi}},  // NOLINT(readability-magic-numbers)
 		IndependentSetGenerator{{1500, GraphType::erdos_renyi}},  // NOLINT(readability-magic-numbers)
 	};
+}
+
+/** Large set cover instances, with many more columns than rows. */
+auto make_large_set_cover_generators(std::size_t n_cols) {
+	return std::tuple{
+		SetCoverGenerator{{1000, n_cols}},  // NOLINT(readability-magic-numbers)
+		SetCoverGenerator{{2000, n_cols}},  // NOLINT(readability-magic-numbers)
+	};
+}
+
+/** Run the benchmark function on instances of the given generators and print the resulting csv lines. */
+template <typename Result, typename Generators, typename Func>
+void benchmark_instances(Generators generators, std::size_t n_instances, std::size_t n_nodes, Func&& benchmark_func) {
 	auto rng = ecole::spawn_random_generator();
 
-	std::cout << BranchingResult::csv_title() << '\n';
+	std::cout << Result::csv_title() << '\n';
 	for (std::size_t i = 0; i < n_instances; ++i) {
 		auto benchmark_and_print = [&](auto& gen) noexcept {
 			try {
@@ -60,7 +83,7 @@ auto benchmark_branching(std::size_t n_instances, std::size_t n_nodes) {
 				model.disable_cuts();
 				model.set_param("limits/totalnodes", n_nodes);
 				seed_model(model, rng);
-				std::cout << benchmark_branching(model).csv() << '\n';
+				std::cout << benchmark_func(model).csv() << '\n';
 			} catch (std::exception const& e) {
 				std::cerr << "Error when benchmarking an instance: " << e.what() << '\n';
 			}
@@ -69,6 +92,12 @@ auto benchmark_branching(std::size_t n_instances, std::size_t n_nodes) {
 	}
 }
 
+/** Run the benchmark function on instances of all generators and print the resulting csv lines. */
+template <typename Result, typename Func>
+void benchmark_generated_instances(std::size_t n_instances, std::size_t n_nodes, Func&& benchmark_func) {
+	benchmark_instances<Result>(make_generators(), n_instances, n_nodes, std::forward<Func>(benchmark_func));
+}
+
 int main(int argc, char** argv) {
 	try {
 
@@ -81,12 +110,84 @@ int main(int argc, char** argv) {
 		app.add_option("--node-limit,--nl", n_nodes, "Limit the number of nodes in each run");
 		auto seed = std::optional<ecole::Seed>{};
 		app.add_option("--seed,-s", seed, "Global Ecole random seed");
+		auto* coroutine_app = app.add_subcommand("coroutine", "Benchmark coroutine stack reuse on reset latency");
+		auto n_resets = std::size_t{10};  // NOLINT(readability-magic-numbers)
+		coroutine_app->add_option("--resets", n_resets, "Number of resets measured per instance");
+		auto stack_size = ecole::utility::CoroutineStack::default_size();
+		coroutine_app->add_option("--stack-size", stack_size, "Size in bytes of coroutine stacks");
+		auto* fork_app = app.add_subcommand("fork", "Benchmark the throughput of Model::fork against Model::copy");
+		auto n_threads = std::size_t{1};
+		fork_app->add_option("--threads", n_threads, "Number of threads copying models concurrently");
+		auto n_copies = std::size_t{100};  // NOLINT(readability-magic-numbers)
+		fork_app->add_option("--copies", n_copies, "Number of copies made by each thread");
+		auto* copy_app = app.add_subcommand("copy", "Benchmark the scaling of concurrent Model copies");
+		auto copy_n_threads = std::vector<std::size_t>{1, 2, 4, 8, 16, 32, 64};  // NOLINT(readability-magic-numbers)
+		copy_app->add_option("--threads", copy_n_threads, "Numbers of threads copying models concurrently");
+		copy_app->add_option("--copies", n_copies, "Number of copies made by each thread");
+		auto* khalil_app =
+			app.add_subcommand("khalil", "Benchmark the parallel extraction of Khalil2016 static features");
+		auto khalil_n_threads = std::vector<std::size_t>{0, 1, 2, 4, 8, 16};  // NOLINT(readability-magic-numbers)
+		khalil_app->add_option("--threads", khalil_n_threads, "Numbers of threads computing static features");
+		auto n_extractions = std::size_t{3};  // NOLINT(readability-magic-numbers)
+		khalil_app->add_option("--extractions", n_extractions, "Number of root extractions measured per instance");
+		auto n_cols = std::size_t{100000};  // NOLINT(readability-magic-numbers)
+		khalil_app->add_option("--columns", n_cols, "Number of columns of the set cover instances");
+		auto* node_bipartite_app =
+			app.add_subcommand("node-bipartite", "Benchmark the incremental extraction of NodeBipartite observations");
+		auto* stats_app = app.add_subcommand("stats", "Benchmark the vectorized statistics of contiguous values");
+		auto stats_sizes = std::vector<std::size_t>{10, 100, 1000, 10000, 100000};  // NOLINT(readability-magic-numbers)
+		stats_app->add_option("--values", stats_sizes, "Numbers of values on which to compute statistics");
+		auto n_repeats = std::size_t{10000};  // NOLINT(readability-magic-numbers)
+		stats_app->add_option("--repeats", n_repeats, "Number of times statistics are computed for each size");
+		auto* switch_app = app.add_subcommand("switch", "Benchmark the context switches of coroutines");
+		auto n_switches = std::size_t{10000000};  // NOLINT(readability-magic-numbers)
+		switch_app->add_option("--switches", n_switches, "Number of context switches measured");
+		auto* steps_app = app.add_subcommand("steps", "Benchmark the rate of steps of the branching dynamics");
 		CLI11_PARSE(app, argc, argv);
+		ecole::utility::CoroutineStack::set_default_size(stack_size);
 
 		if (seed.has_value()) {
 			ecole::seed(seed.value());
 		}
-		benchmark_branching(n_instances, n_nodes);
+		if (*coroutine_app) {
+			benchmark_generated_instances<CoroutineResult>(n_instances, n_nodes, [n_resets](auto const& model) {
+				return benchmark_coroutine(model, n_resets);
+			});
+		} else if (*fork_app) {
+			benchmark_generated_instances<ForkResult>(n_instances, n_nodes, [n_threads, n_copies](auto const& model) {
+				return benchmark_fork(model, n_threads, n_copies);
+			});
+		} else if (*khalil_app) {
+			benchmark_instances<KhalilScalingResult>(
+				make_large_set_cover_generators(n_cols),
+				n_instances,
+				n_nodes,
+				[&khalil_n_threads, n_extractions](auto const& model) {
+					return benchmark_khalil_scaling(model, khalil_n_threads, n_extractions);
+				});
+		} else if (*node_bipartite_app) {
+			benchmark_generated_instances<NodeBipartiteResult>(
+				n_instances, n_nodes, [](auto const& model) { return benchmark_node_bipartite(model); });
+		} else if (*stats_app) {
+			// Statistics do not depend on instances
+			std::cout << StatsScalingResult::csv_title() << '\n';
+			std::cout << benchmark_stats(stats_sizes, n_repeats).csv() << '\n';
+		} else if (*switch_app) {
+			// Context switches do not depend on instances
+			std::cout << ContextSwitchResult::csv_title() << '\n';
+			std::cout << benchmark_context_switch(n_switches).csv() << '\n';
+		} else if (*steps_app) {
+			benchmark_generated_instances<StepsResult>(
+				n_instances, n_nodes, [](auto const& model) { return benchmark_steps(model); });
+		} else if (*copy_app) {
+			benchmark_generated_instances<CopyScalingResult>(
+				n_instances, n_nodes, [&copy_n_threads, n_copies](auto const& model) {
+					return benchmark_copy_scaling(model, copy_n_threads, n_copies);
+				});
+		} else {
+			benchmark_generated_instances<BranchingResult>(
+				n_instances, n_nodes, [](auto const& model) { return benchmark_branching(model); });
+		}
 
 	} catch (std::exception const& e) {
 		std::cerr << "An error occured: " << e.what() << '\n';
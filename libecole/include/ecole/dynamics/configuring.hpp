@@ -6,6 +6,7 @@
 #include "ecole/dynamics/parts.hpp"
 #include "ecole/export.hpp"
 #include "ecole/none.hpp"
+#include "ecole/scip/compiled-params.hpp"
 #include "ecole/scip/type.hpp"
 
 namespace ecole::dynamics {
@@ -25,6 +26,10 @@ public:
 	ECOLE_EXPORT auto reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet>;
 
 	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action const& param_dict) const -> std::tuple<bool, ActionSet>;
+
+	/** Set parameters compiled in advance, for instance when the same configurations are evaluated repeatedly. */
+	ECOLE_EXPORT auto step_dynamics(scip::Model& model, scip::CompiledParams const& params) const
+		-> std::tuple<bool, ActionSet>;
 };
 
 }  // namespace ecole::dynamics
@@ -1,18 +1,25 @@
 #pragma once
 
+#include <future>
 #include <map>
+#include <memory>
 #include <random>
+#include <string>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include "ecole/data/parser.hpp"
 #include "ecole/exception.hpp"
 #include "ecole/information/abstract.hpp"
 #include "ecole/random.hpp"
 #include "ecole/reward/abstract.hpp"
+#include "ecole/scip/compiled-params.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/seed.hpp"
 #include "ecole/traits.hpp"
+#include "ecole/utility/completion-queue.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 #include <optional>
 
@@ -49,6 +56,8 @@ public:
 	using Reward = reward::Reward;
 	using Information = trait::information_of_t<InformationFunction>;
 	using InformationMap = information::InformationMap<Information>;
+	using Transition = std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap>;
+	template <typename Tag> using Completion = std::pair<Tag, std::future<Transition>>;
 
 	/**
 	 * Default construct everything and seed environment with random value.
@@ -107,7 +116,7 @@ public:
 		try {
 			// Create clean new Model
 			model() = std::move(new_model);
-			model().set_params(scip_params());
+			model().set_params(compiled_scip_params());
 			dynamics().set_dynamics_random_state(model(), rng());
 
 			// Reset data extraction function and bring model to initial state.
@@ -190,6 +199,78 @@ public:
 		}
 	}
 
+	/**
+	 * Asynchronous version of reset.
+	 *
+	 * The reset, including solving up to the initial state, is run on a dedicated worker thread owned by the
+	 * environment.
+	 * The environment must not be used (nor moved or destroyed) until the returned future is ready.
+	 * Once asynchronous methods are used, subsequent transitions of the episode should also be asynchronous so that the
+	 * solving coroutine of the Model is always resumed from the same thread.
+	 *
+	 * @return A future holding the result of reset, or the exception it raised.
+	 * @see reset
+	 */
+	template <typename... Args> auto reset_async(scip::Model&& new_model, Args... args) -> std::future<Transition> {
+		return async_worker().submit(0, [this, new_model = std::move(new_model), args...]() mutable {
+			return reset(std::move(new_model), std::move(args)...);
+		});
+	}
+
+	template <typename... Args> auto reset_async(std::string filename, Args... args) -> std::future<Transition> {
+		return async_worker().submit(
+			0, [this, filename = std::move(filename), args...]() mutable { return reset(filename, std::move(args)...); });
+	}
+
+	/**
+	 * Asynchronous version of step.
+	 *
+	 * The action and arguments are copied, so they need not outlive the call.
+	 * The same restrictions as in reset_async apply.
+	 *
+	 * @return A future holding the result of step, or the exception it raised.
+	 * @see step
+	 */
+	template <typename... Args> auto step_async(Action action, Args... args) -> std::future<Transition> {
+		return async_worker().submit(
+			0, [this, action = std::move(action), args...]() mutable { return step(action, std::move(args)...); });
+	}
+
+	/**
+	 * Asynchronous reset reporting its completion to a queue.
+	 *
+	 * When the reset completes, the future holding its result is pushed in the queue along with the given tag.
+	 * Sharing a queue among many environments lets a single thread handle results as soon as they are available.
+	 *
+	 * @param queue Where to push the completed reset. Must outlive the asynchronous operation.
+	 * @param tag An identifier returned with the result, for instance the index of the environment.
+	 */
+	template <typename Tag, typename... Args>
+	void reset_async(utility::CompletionQueue<Completion<Tag>>& queue, Tag tag, scip::Model&& new_model, Args... args) {
+		notify_completion(queue, std::move(tag), [this, new_model = std::move(new_model), args...]() mutable {
+			return reset(std::move(new_model), std::move(args)...);
+		});
+	}
+
+	template <typename Tag, typename... Args>
+	void reset_async(utility::CompletionQueue<Completion<Tag>>& queue, Tag tag, std::string filename, Args... args) {
+		notify_completion(queue, std::move(tag), [this, filename = std::move(filename), args...]() mutable {
+			return reset(filename, std::move(args)...);
+		});
+	}
+
+	/**
+	 * Asynchronous step reporting its completion to a queue.
+	 *
+	 * @see reset_async
+	 */
+	template <typename Tag, typename... Args>
+	void step_async(utility::CompletionQueue<Completion<Tag>>& queue, Tag tag, Action action, Args... args) {
+		notify_completion(queue, std::move(tag), [this, action = std::move(action), args...]() mutable {
+			return step(action, std::move(args)...);
+		});
+	}
+
 	auto& dynamics() { return the_dynamics; }
 	auto& model() { return the_model; }
 	auto& observation_function() { return the_observation_function; }
@@ -205,8 +286,38 @@ private:
 	ObservationFunction the_observation_function;
 	InformationFunction the_information_function;
 	std::map<std::string, scip::Param> the_scip_params;
+	// The parameters compiled on the first reset, along with the values they were compiled from.
+	std::optional<std::pair<std::map<std::string, scip::Param>, scip::CompiledParams>> the_compiled_scip_params;
 	RandomGenerator the_rng;
 	bool can_transition = false;
+	// Last so that pending asynchronous operations are completed before other members are destroyed.
+	std::unique_ptr<utility::ThreadPool> the_async_worker;
+
+	/** Lazily create the worker so that synchronous environments do not own a thread. */
+	auto async_worker() -> utility::ThreadPool& {
+		if (the_async_worker == nullptr) {
+			the_async_worker = std::make_unique<utility::ThreadPool>(1);
+		}
+		return *the_async_worker;
+	}
+
+	/** Compile the SCIP parameters on the current model, unless they were not modified since last compiled. */
+	auto compiled_scip_params() -> scip::CompiledParams const& {
+		if (!the_compiled_scip_params.has_value() || the_compiled_scip_params->first != scip_params()) {
+			auto compiled = scip::CompiledParams{model(), scip_params()};
+			the_compiled_scip_params.emplace(scip_params(), std::move(compiled));
+		}
+		return the_compiled_scip_params->second;
+	}
+
+	template <typename Tag, typename Func>
+	void notify_completion(utility::CompletionQueue<Completion<Tag>>& queue, Tag tag, Func&& func) {
+		auto task = std::make_shared<std::packaged_task<Transition()>>(std::forward<Func>(func));
+		async_worker().submit(0, [task, &queue, tag = std::move(tag)]() mutable {
+			(*task)();
+			queue.push({std::move(tag), task->get_future()});
+		});
+	}
 
 	// extract reward, observation and information (in that order)
 	auto extract_reward_observation_information(bool done) -> std::tuple<Reward, OptionalObservation, InformationMap> {
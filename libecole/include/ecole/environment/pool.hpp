@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "ecole/environment/environment.hpp"
+#include "ecole/random.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::environment {
+
+/**
+ * A fixed size collection of environments transitioned in parallel.
+ *
+ * The pool owns a number of identical ecole::environment::Environment and a fixed thread pool.
+ * Calls to reset and step run the dynamics and the data extraction functions of every environment in parallel and
+ * return the results of all environments at once.
+ * A given environment is always run on the same thread, as is required by the solving coroutine of the Model.
+ *
+ * Environments reaching a terminal state are not transitioned anymore until they are reset.
+ *
+ * @tparam Dynamics The ecole::environment::EnvironmentDynamics of every environment.
+ * @tparam ObservationFunction The ecole::observation::ObservationFunction of every environment.
+ * @tparam RewardFunction The ecole::reward::RewardFunction of every environment.
+ * @tparam InformationFunction The ecole::information::InformationFunction of every environment.
+ */
+template <typename Dynamics, typename ObservationFunction, typename RewardFunction, typename InformationFunction>
+class EnvironmentPool {
+public:
+	using Env = Environment<Dynamics, ObservationFunction, RewardFunction, InformationFunction>;
+	using Seed = typename Env::Seed;
+	using OptionalObservation = typename Env::OptionalObservation;
+	using Action = typename Env::Action;
+	using ActionSet = typename Env::ActionSet;
+	using Reward = typename Env::Reward;
+	using InformationMap = typename Env::InformationMap;
+
+	/**
+	 * Results of a transition of all environments, indexed by environment.
+	 *
+	 * Environments that were not transitioned (because they were already in a terminal state) have no observation,
+	 * a default action set, a zero reward, and are marked as done.
+	 */
+	struct Batch {
+		std::vector<OptionalObservation> observations;
+		std::vector<ActionSet> action_sets;
+		std::vector<Reward> rewards;
+		std::vector<bool> dones;
+		std::vector<InformationMap> informations;
+	};
+
+	/**
+	 * Create the environments and the worker threads.
+	 *
+	 * @param n_environments The number of environments in the pool.
+	 * @param n_threads The number of worker threads. Zero runs all environments in the calling thread.
+	 * @param observation_function, reward_function, information_function, scip_params, args Copied into every
+	 *        environment constructor.
+	 */
+	template <typename... Args>
+	EnvironmentPool(
+		std::size_t n_environments,
+		std::size_t n_threads = std::thread::hardware_concurrency(),
+		ObservationFunction const& observation_function = {},
+		RewardFunction const& reward_function = {},
+		InformationFunction const& information_function = {},
+		std::map<std::string, scip::Param> const& scip_params = {},
+		Args const&... args) :
+		the_threads(std::min(n_threads, n_environments)), can_transition(n_environments, false) {
+		the_environments.reserve(n_environments);
+		for (std::size_t i = 0; i < n_environments; ++i) {
+			the_environments.emplace_back(
+				observation_function, reward_function, information_function, scip_params, args...);
+		}
+	}
+
+	/**
+	 * Seed all environments deterministically.
+	 *
+	 * Each environment receives a different seed derived from the given one.
+	 */
+	void seed(Seed new_seed) {
+		auto rng = RandomGenerator{new_seed};
+		for (auto& env : the_environments) {
+			env.seed(rng());
+		}
+	}
+
+	/**
+	 * Reset all environments in parallel.
+	 *
+	 * @param new_models One Model per environment, moved into the environments.
+	 * @return The reset results of every environment.
+	 * @see Environment::reset
+	 */
+	auto reset(nonstd::span<scip::Model> new_models) -> Batch {
+		check_size(new_models.size());
+		return transition([&](Env& env, std::size_t i) { return env.reset(std::move(new_models[i])); });
+	}
+
+	/**
+	 * Reset all environments in parallel from problem files.
+	 *
+	 * @param filenames One problem file per environment, read in parallel.
+	 * @see Environment::reset
+	 */
+	auto reset(nonstd::span<std::string const> filenames) -> Batch {
+		check_size(filenames.size());
+		return transition([&](Env& env, std::size_t i) { return env.reset(filenames[i]); });
+	}
+
+	/**
+	 * Transition all non terminal environments in parallel.
+	 *
+	 * @param actions One action per environment. Actions given to terminated environments are ignored.
+	 * @return The step results of every environment.
+	 * @see Environment::step
+	 */
+	auto step(nonstd::span<Action const> actions) -> Batch {
+		check_size(actions.size());
+		return transition(
+			[&](Env& env, std::size_t i) { return env.step(actions[i]); }, /*only_non_terminal=*/true);
+	}
+
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return the_environments.size(); }
+	[[nodiscard]] auto n_threads() const noexcept -> std::size_t { return the_threads.n_threads(); }
+
+	auto& environment(std::size_t i) { return the_environments.at(i); }
+
+private:
+	std::vector<Env> the_environments;
+	utility::ThreadPool the_threads;
+	std::vector<bool> can_transition;
+
+	void check_size(std::size_t n) const {
+		if (n != size()) {
+			throw std::invalid_argument{
+				"Expected one element per environment (" + std::to_string(size()) + "), but received " + std::to_string(n) +
+				"."};
+		}
+	}
+
+	/** Run the transition function on all environments and gather the results. */
+	template <typename Func> auto transition(Func&& func, bool only_non_terminal = false) -> Batch {
+		using Result = std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap>;
+		auto results = std::vector<Result>(size(), Result{{}, {}, {}, true, {}});
+		// Flags are copied since std::vector<bool> cannot be accessed concurrently while being written.
+		auto to_run = can_transition;
+		if (!only_non_terminal) {
+			to_run.assign(size(), true);
+		}
+
+		try {
+			the_threads.parallel_for(size(), [&](std::size_t i) {
+				if (to_run[i]) {
+					results[i] = func(the_environments[i], i);
+				}
+			});
+		} catch (...) {
+			// Environments that raised keep a terminal default result and must be reset.
+			update_can_transition(results, to_run);
+			throw;
+		}
+		update_can_transition(results, to_run);
+
+		auto batch = Batch{};
+		batch.observations.reserve(size());
+		batch.action_sets.reserve(size());
+		batch.rewards.reserve(size());
+		batch.dones.reserve(size());
+		batch.informations.reserve(size());
+		for (auto& [obs, action_set, reward, done, info] : results) {
+			batch.observations.push_back(std::move(obs));
+			batch.action_sets.push_back(std::move(action_set));
+			batch.rewards.push_back(reward);
+			batch.dones.push_back(done);
+			batch.informations.push_back(std::move(info));
+		}
+		return batch;
+	}
+
+	template <typename Results> void update_can_transition(Results const& results, std::vector<bool> const& ran) {
+		for (std::size_t i = 0; i < size(); ++i) {
+			if (ran[i]) {
+				can_transition[i] = !std::get<bool>(results[i]);
+			}
+		}
+	}
+};
+
+}  // namespace ecole::environment
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "ecole/export.hpp"
 #include "ecole/random.hpp"
 #include "ecole/scip/model.hpp"
@@ -18,6 +20,16 @@ public:
 	 */
 	ECOLE_EXPORT virtual scip::Model next() = 0;
 
+	/**
+	 * Advance the generator past its next instance, and return a function generating that instance.
+	 *
+	 * The function does not use the generator, so it can be called in another thread while the generator moves on to
+	 * the following instances, and calling it gives the same instance as next would have.
+	 * Generators whose instances cannot be generated independently of their state return an empty function and are
+	 * left unchanged, which is the default.
+	 */
+	ECOLE_EXPORT virtual auto next_deferred() -> std::function<scip::Model()> { return {}; }
+
 	/**
 	 * Seed the internal random generator.
 	 */
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,8 @@ public:
 	ECOLE_EXPORT FileGenerator();
 
 	ECOLE_EXPORT auto next() -> scip::Model override;
+	/** Choose the next file, and defer reading it. */
+	ECOLE_EXPORT auto next_deferred() -> std::function<scip::Model()> override;
 	ECOLE_EXPORT void seed(Seed seed) override;
 	[[nodiscard]] ECOLE_EXPORT auto done() const -> bool override;
 
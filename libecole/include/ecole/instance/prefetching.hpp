@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+
+#include "ecole/export.hpp"
+#include "ecole/instance/abstract.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::instance {
+
+/**
+ * Generate instances ahead of time in worker threads.
+ *
+ * Wraps any instance generator so that the instances are generated (or read from files) in the background while the
+ * previous ones are being solved.
+ * The sequence of instances is the one of the wrapped generator, whatever the number of workers.
+ *
+ * Generators that can defer generating their instances (see InstanceGenerator::next_deferred), such as the
+ * FileGenerator, advance their state in the calling thread, and their instances are generated in parallel by all the
+ * workers.
+ * Other generators, such as the random generators whose instances depend on all the random numbers drawn before,
+ * are used in order by the first worker only, so their instances are generated ahead of time but one at a time.
+ */
+class ECOLE_EXPORT PrefetchingGenerator : public InstanceGenerator {
+public:
+	/**
+	 * Start generating the first instances.
+	 *
+	 * @param generator The generator whose instances are generated ahead of time.
+	 * @param n_workers The number of worker threads. Zero generates instances in the calling thread on demand.
+	 * @param queue_size The maximum number of instances generated ahead of time.
+	 */
+	ECOLE_EXPORT PrefetchingGenerator(
+		std::unique_ptr<InstanceGenerator> generator,
+		std::size_t n_workers = 1,
+		std::size_t queue_size = 2);
+
+	/** Wait for the instances being generated and join the worker threads. */
+	ECOLE_EXPORT ~PrefetchingGenerator() override;
+
+	/**
+	 * Return the next instance, waiting for it if it is not ready yet.
+	 *
+	 * @throw IteratorExhausted if the wrapped generator is exhausted.
+	 */
+	ECOLE_EXPORT scip::Model next() override;
+
+	/** Discard the instances generated ahead of time and seed the wrapped generator. */
+	ECOLE_EXPORT void seed(Seed seed) override;
+
+	/**
+	 * Whether the wrapped generator is exhausted.
+	 *
+	 * Generators used by a worker are only known to be exhausted once next has thrown.
+	 */
+	[[nodiscard]] ECOLE_EXPORT bool done() const override;
+
+	[[nodiscard]] ECOLE_EXPORT std::size_t n_workers() const noexcept { return the_threads.n_threads(); }
+
+private:
+	std::unique_ptr<InstanceGenerator> generator;
+	std::size_t queue_size;
+	std::size_t n_slots_submitted = 0;
+	/** Whether the generator defers its instances, until it returns an empty function from next_deferred. */
+	bool defers_generation = true;
+	bool exhausted = false;
+	// Declared after the generator so that pending tasks finish before the generator is destroyed.
+	utility::ThreadPool the_threads;
+	std::deque<std::future<scip::Model>> pending;
+
+	void fill_queue();
+	void clear_queue();
+};
+
+}  // namespace ecole::instance
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <nonstd/span.hpp>
+#include <xtensor/xadapt.hpp>
+
+namespace ecole::observation {
+
+/**
+ * A row major matrix in caller owned memory in which observations are written one after the other.
+ *
+ * The memory is typically allocated once, with a capacity for the largest batch expected, and reused for every batch.
+ * Observation ``i`` is written in rows ``[offsets[i], offsets[i+1])``, offsets being written as observations are
+ * appended.
+ * Rows after the last observation are padding.
+ *
+ * @tparam T The type of the elements in the matrix.
+ */
+template <typename T> class BatchMatrix {
+public:
+	using value_type = T;
+	/** A view of some rows of the matrix, with the same interface as an xtensor. */
+	using Rows = decltype(xt::adapt(
+		std::declval<T*>(),
+		std::declval<std::size_t>(),
+		xt::no_ownership(),
+		std::declval<std::array<std::size_t, 2>>()));
+
+	/**
+	 * Wrap memory owned by the caller.
+	 *
+	 * @param data The elements of the matrix, its size must be a multiple of the number of columns.
+	 * @param n_cols The number of columns, that is the number of features per row.
+	 * @param offsets Where to write the offsets of the observations, with room for one more offset than the maximum
+	 *        number of observations.
+	 */
+	BatchMatrix(nonstd::span<T> data, std::size_t n_cols, nonstd::span<std::size_t> offsets);
+
+	/**
+	 * Reserve the rows of the next observation.
+	 *
+	 * @return The rows reserved, to be written by the caller.
+	 * @throw std::length_error if there is not enough room left for the rows or the offsets.
+	 */
+	auto append(std::size_t n_rows) -> Rows;
+
+	/** Fill the rows after the last observation with a padding value. */
+	void pad(T value);
+
+	/** Forget about all observations, to write a new batch in the same memory. */
+	void clear() noexcept;
+
+	[[nodiscard]] auto n_observations() const noexcept -> std::size_t { return m_n_observations; }
+	[[nodiscard]] auto n_rows() const noexcept -> std::size_t { return m_n_rows; }
+	[[nodiscard]] auto n_cols() const noexcept -> std::size_t { return m_n_cols; }
+	[[nodiscard]] auto capacity() const noexcept -> std::size_t { return m_data.size() / m_n_cols; }
+	/** The offsets written so far, there is one more than the number of observations. */
+	[[nodiscard]] auto offsets() const noexcept -> nonstd::span<std::size_t const> {
+		return m_offsets.first(m_n_observations + 1);
+	}
+
+private:
+	nonstd::span<T> m_data;
+	nonstd::span<std::size_t> m_offsets;
+	std::size_t m_n_cols = 1;
+	std::size_t m_n_rows = 0;
+	std::size_t m_n_observations = 0;
+};
+
+/**
+ * Collate the observations of many models in caller owned memory.
+ *
+ * Observations are written one after the other, in the order of the models, through the ``extract_into`` method of the
+ * observation functions.
+ * Models without an observation (for instance in a terminal state) get an empty segment in the batch, so that the
+ * offsets of observation ``i`` are always at index ``i``.
+ * The batch is cleared beforehand.
+ *
+ * @param obs_funcs A range of pointers to observation functions, one per model.
+ * @param models A range of pointers to the models from which to extract observations.
+ * @param dones A range of boolean indicating whether each model is in a terminal state.
+ * @param batch Where to write the observations.
+ */
+template <typename ObsFuncs, typename Models, typename Dones, typename Batch>
+void collate(ObsFuncs const& obs_funcs, Models const& models, Dones const& dones, Batch& batch);
+
+/***********************************
+ *  Implementation of BatchMatrix  *
+ ***********************************/
+
+template <typename T>
+BatchMatrix<T>::BatchMatrix(nonstd::span<T> data, std::size_t n_cols, nonstd::span<std::size_t> offsets) :
+	m_data{data}, m_offsets{offsets}, m_n_cols{n_cols} {
+	if ((n_cols == 0) || (data.size() % n_cols != 0)) {
+		throw std::invalid_argument{"The size of the data must be a non zero multiple of the number of columns."};
+	}
+	if (offsets.empty()) {
+		throw std::invalid_argument{"There must be room for at least one offset."};
+	}
+	m_offsets[0] = 0;
+}
+
+template <typename T> auto BatchMatrix<T>::append(std::size_t n_rows) -> Rows {
+	if (m_n_observations + 2 > m_offsets.size()) {
+		throw std::length_error{
+			"No room left for the offsets of " + std::to_string(m_n_observations + 1) + " observations."};
+	}
+	if (m_n_rows + n_rows > capacity()) {
+		throw std::length_error{
+			"No room left for " + std::to_string(n_rows) + " rows, " + std::to_string(capacity() - m_n_rows) +
+			" rows are available."};
+	}
+	auto* const begin = m_data.data() + m_n_rows * m_n_cols;
+	m_n_rows += n_rows;
+	m_n_observations++;
+	m_offsets[m_n_observations] = m_n_rows;
+	return xt::adapt(begin, n_rows * m_n_cols, xt::no_ownership(), std::array{n_rows, m_n_cols});
+}
+
+template <typename T> void BatchMatrix<T>::pad(T value) {
+	std::fill(m_data.begin() + static_cast<std::ptrdiff_t>(m_n_rows * m_n_cols), m_data.end(), value);
+}
+
+template <typename T> void BatchMatrix<T>::clear() noexcept {
+	m_n_rows = 0;
+	m_n_observations = 0;
+}
+
+/*******************************
+ *  Implementation of collate  *
+ *******************************/
+
+template <typename ObsFuncs, typename Models, typename Dones, typename Batch>
+void collate(ObsFuncs const& obs_funcs, Models const& models, Dones const& dones, Batch& batch) {
+	if ((std::size(obs_funcs) != std::size(models)) || (std::size(dones) != std::size(models))) {
+		throw std::invalid_argument{"Expected one observation function and one done flag per model."};
+	}
+	batch.clear();
+	for (std::size_t i = 0; i < std::size(models); ++i) {
+		obs_funcs[i]->extract_into(*models[i], dones[i], batch);
+	}
+}
+
+}  // namespace ecole::observation
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace ecole::observation {
+
+/**
+ * A selection of the features computed by an observation function.
+ *
+ * Observation functions do not compute the features that are not selected, and store the selected ones compacted, in
+ * the order of the enum.
+ * The column of a selected feature in the observation is given by @ref column.
+ *
+ * @tparam Feature The enum of the features, with values the index of the features when they are all selected.
+ * @tparam N The number of features in the enum.
+ */
+template <typename Feature, std::size_t N> class FeatureMask {
+public:
+	using feature_type = Feature;
+	/** The column of features that are not selected. */
+	static inline std::size_t constexpr npos = static_cast<std::size_t>(-1);
+
+	/** Select all features. */
+	FeatureMask() noexcept;
+	/** Select only the given features. */
+	FeatureMask(std::initializer_list<Feature> features) noexcept;
+
+	static auto all() noexcept -> FeatureMask { return {}; }
+	static auto none() noexcept -> FeatureMask { return {std::initializer_list<Feature>{}}; }
+
+	auto select(Feature feature) noexcept -> FeatureMask&;
+	auto deselect(Feature feature) noexcept -> FeatureMask&;
+
+	[[nodiscard]] auto is_selected(Feature feature) const noexcept -> bool { return m_selected[index(feature)]; }
+	/** Whether any of the features in the inclusive range [first, last] is selected. */
+	[[nodiscard]] auto any_selected(Feature first, Feature last) const noexcept -> bool;
+	[[nodiscard]] auto all_selected() const noexcept -> bool { return m_selected.all(); }
+	/** The number of selected features, that is the number of columns of the observation. */
+	[[nodiscard]] auto n_selected() const noexcept -> std::size_t { return m_selected.count(); }
+	/** The column of a feature in the observation, or npos if it is not selected. */
+	[[nodiscard]] auto column(Feature feature) const noexcept -> std::size_t { return m_columns[index(feature)]; }
+	/** The selected features, in the order of the columns. */
+	[[nodiscard]] auto features() const -> std::vector<Feature>;
+
+	[[nodiscard]] auto operator==(FeatureMask const& other) const noexcept -> bool {
+		return m_selected == other.m_selected;
+	}
+	[[nodiscard]] auto operator!=(FeatureMask const& other) const noexcept -> bool { return !(*this == other); }
+
+private:
+	std::bitset<N> m_selected;
+	std::array<std::size_t, N> m_columns;
+
+	static constexpr auto index(Feature feature) noexcept -> std::size_t { return static_cast<std::size_t>(feature); }
+
+	void update_columns() noexcept;
+};
+
+/***********************************
+ *  Implementation of FeatureMask  *
+ ***********************************/
+
+template <typename Feature, std::size_t N> FeatureMask<Feature, N>::FeatureMask() noexcept {
+	m_selected.set();
+	update_columns();
+}
+
+template <typename Feature, std::size_t N>
+FeatureMask<Feature, N>::FeatureMask(std::initializer_list<Feature> features) noexcept {
+	for (auto const feature : features) {
+		m_selected.set(index(feature));
+	}
+	update_columns();
+}
+
+template <typename Feature, std::size_t N>
+auto FeatureMask<Feature, N>::select(Feature feature) noexcept -> FeatureMask& {
+	m_selected.set(index(feature));
+	update_columns();
+	return *this;
+}
+
+template <typename Feature, std::size_t N>
+auto FeatureMask<Feature, N>::deselect(Feature feature) noexcept -> FeatureMask& {
+	m_selected.reset(index(feature));
+	update_columns();
+	return *this;
+}
+
+template <typename Feature, std::size_t N>
+auto FeatureMask<Feature, N>::any_selected(Feature first, Feature last) const noexcept -> bool {
+	for (auto i = index(first); i <= index(last); ++i) {
+		if (m_selected[i]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+template <typename Feature, std::size_t N> auto FeatureMask<Feature, N>::features() const -> std::vector<Feature> {
+	auto selected = std::vector<Feature>{};
+	selected.reserve(n_selected());
+	for (std::size_t i = 0; i < N; ++i) {
+		if (m_selected[i]) {
+			selected.push_back(static_cast<Feature>(i));
+		}
+	}
+	return selected;
+}
+
+template <typename Feature, std::size_t N> void FeatureMask<Feature, N>::update_columns() noexcept {
+	auto column = std::size_t{0};
+	for (std::size_t i = 0; i < N; ++i) {
+		m_columns[i] = m_selected[i] ? column++ : npos;
+	}
+}
+
+}  // namespace ecole::observation
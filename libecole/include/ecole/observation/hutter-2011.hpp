@@ -1,16 +1,23 @@
 #pragma once
 
+#include <cstddef>
+#include <filesystem>
+#include <memory>
 #include <optional>
 
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
+#include "ecole/observation/profiler.hpp"
+#include "ecole/utility/file-cache.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::observation {
 
-struct ECOLE_EXPORT Hutter2011Obs {
-	static inline std::size_t constexpr n_features = 33;
+/** Layout of the features in Hutter2011 observations, common to all value types. */
+struct ECOLE_EXPORT Hutter2011Features {
+	static inline std::size_t constexpr n_features = 35;
 
 	enum struct ECOLE_EXPORT Features : std::size_t {
 		/* Problem size features */
@@ -33,9 +40,8 @@ struct ECOLE_EXPORT Hutter2011Obs {
 		node_degree_std,
 		node_degree_25q,
 		node_degree_75q,
-		// Not computed because too expensive
-		// clustering_coef_mean,
-		// clustering_coef_std,
+		clustering_coef_mean,
+		clustering_coef_std,
 		edge_density,
 		/* LP features */
 		lp_slack_mean,
@@ -63,14 +69,72 @@ struct ECOLE_EXPORT Hutter2011Obs {
 		// nb_quadratic_nonzero_coefs,
 		// nb_quadratic_variables,
 	};
+};
+
+/**
+ * Instance features from Hutter et al. (2011).
+ *
+ * @tparam T The floating point type in which features are stored.
+ */
+template <typename T> struct ECOLE_EXPORT BasicHutter2011Obs : Hutter2011Features {
+	using value_type = T;
 
-	xt::xtensor<double, 1> features;
+	xt::xtensor<value_type, 1> features;
 };
 
-class ECOLE_EXPORT Hutter2011 {
+/**
+ * Observation function for instance features from Hutter et al. (2011).
+ *
+ * @tparam T The floating point type in which features are stored.
+ *         Features are computed in SCIP precision and converted once extracted.
+ */
+template <typename T> class ECOLE_EXPORT BasicHutter2011 {
 public:
+	/** Default maximum number of edges in the variable graph, about 2GB of neighbor indices. */
+	static inline std::size_t constexpr default_max_var_graph_edges = std::size_t{1} << 27U;
+
+	/**
+	 * @param copy_model_ Whether to solve the LP relaxation with SCIP on a copy of the model with all variables made
+	 *        continuous, rather than directly in an LP interface loaded with the constraint matrix.
+	 *        Both solve the same LP, but copying and solving the model is much slower.
+	 * @param n_threads The number of threads used to build the variable graph, 0 to build it in the calling thread.
+	 * @param max_var_graph_edges_ The maximum number of edges in the variable graph.
+	 *        Variable graph features are NaN for larger graphs.
+	 * @param cache_directory A directory in which to cache the features, shared between episodes and processes, or
+	 *        empty to always compute them.
+	 *        Entries are keyed by the fingerprint of the model.
+	 */
+	ECOLE_EXPORT BasicHutter2011(
+		bool copy_model_ = false,
+		std::size_t n_threads = 0,
+		std::size_t max_var_graph_edges_ = default_max_var_graph_edges,
+		std::filesystem::path const& cache_directory = {});
+
 	auto before_reset(scip::Model& /*model*/) -> void {}
-	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<Hutter2011Obs>;
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<BasicHutter2011Obs<T>>;
+
+	/**
+	 * Time spent in each group of features, when enabled.
+	 *
+	 * Groups follow the categories of features in the paper, with the LP relaxation solve and the extraction of the
+	 * constraint matrix timed separately.
+	 */
+	[[nodiscard]] auto profiler() noexcept -> FeatureProfiler& { return the_profiler; }
+	[[nodiscard]] auto profiler() const noexcept -> FeatureProfiler const& { return the_profiler; }
+
+private:
+	FeatureProfiler the_profiler;
+	/** Shared by copies of the observation function, null if computing in the calling thread. */
+	std::shared_ptr<utility::ThreadPool> thread_pool;
+	/** Shared by copies of the observation function, null if not caching features. */
+	std::shared_ptr<utility::FileCache> file_cache;
+	std::size_t max_var_graph_edges = default_max_var_graph_edges;
+	bool copy_model = false;
 };
 
+using Hutter2011Obs = BasicHutter2011Obs<double>;
+using Hutter2011 = BasicHutter2011<double>;
+using Hutter2011ObsF32 = BasicHutter2011Obs<float>;
+using Hutter2011F32 = BasicHutter2011<float>;
+
 }  // namespace ecole::observation
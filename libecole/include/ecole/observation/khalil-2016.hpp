@@ -1,16 +1,24 @@
 #pragma once
 
 #include <cstddef>
+#include <filesystem>
+#include <memory>
 #include <optional>
 
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
+#include "ecole/observation/collate.hpp"
+#include "ecole/observation/feature-mask.hpp"
+#include "ecole/observation/profiler.hpp"
+#include "ecole/utility/file-cache.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::observation {
 
-struct ECOLE_EXPORT Khalil2016Obs {
+/** Layout of the features in Khalil2016 observations, common to all value types. */
+struct ECOLE_EXPORT Khalil2016Features {
 	static inline std::size_t constexpr n_static_features = 18;
 	static inline std::size_t constexpr n_dynamic_features = 54;
 	static inline std::size_t constexpr n_features = n_static_features + n_dynamic_features;
@@ -104,21 +112,82 @@ struct ECOLE_EXPORT Khalil2016Obs {
 		active_coef_weight4_max,
 	};
 
-	xt::xtensor<double, 2> features;
+	using FeaturesMask = FeatureMask<Features, n_features>;
 };
 
-class ECOLE_EXPORT Khalil2016 {
+/**
+ * Branching candidates features from Khalil et al. (2016).
+ *
+ * @tparam T The floating point type in which features are stored.
+ */
+template <typename T> struct ECOLE_EXPORT BasicKhalil2016Obs : Khalil2016Features {
+	using value_type = T;
+
+	/** One row per variable, and one column per selected feature. */
+	xt::xtensor<value_type, 2> features;
+};
+
+/**
+ * Observation function for branching candidates features from Khalil et al. (2016).
+ *
+ * @tparam T The floating point type in which features are stored.
+ *         Features are computed in SCIP precision and written directly in this type.
+ */
+template <typename T> class ECOLE_EXPORT BasicKhalil2016 {
 public:
-	// candidates = 0: lp candidates, 1: pseudo candidates, 2 all variables
-	ECOLE_EXPORT Khalil2016(int candidates = 0) noexcept;
+	/**
+	 * @param candidates The variables observed, 0 for LP candidates, 1 for pseudo candidates, 2 for all variables.
+	 * @param n_threads The number of threads used to compute static features at the root node, 0 to compute them in
+	 *        the calling thread.
+	 *        The features are the same whatever the number of threads.
+	 * @param mask The features to compute, the others are not stored in the observation.
+	 * @param cache_directory A directory in which to cache the static features at the root node, shared between
+	 *        episodes and processes, or empty to always compute them.
+	 *        Entries are keyed by the fingerprint of the model, which includes the LP at the root node.
+	 */
+	ECOLE_EXPORT BasicKhalil2016(
+		int candidates = 0,
+		std::size_t n_threads = 0,
+		Khalil2016Features::FeaturesMask mask = {},
+		std::filesystem::path const& cache_directory = {});
 
 	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
 
-	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<Khalil2016Obs>;
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<BasicKhalil2016Obs<T>>;
+
+	/**
+	 * Write the features in the next rows of a batch, one row per variable.
+	 *
+	 * @return Whether an observation was written, otherwise an empty one is appended to the batch.
+	 * @see collate
+	 */
+	ECOLE_EXPORT auto extract_into(scip::Model& model, bool done, BatchMatrix<T>& batch) -> bool;
+
+	/**
+	 * Time spent in each group of features, when enabled.
+	 *
+	 * Groups are the static features at the root node, the row summaries shared between candidates, the copy of the
+	 * static features, and the groups of dynamic features of the paper.
+	 * When enabled, every group is computed for all candidates before the next one.
+	 */
+	[[nodiscard]] auto profiler() noexcept -> FeatureProfiler& { return the_profiler; }
+	[[nodiscard]] auto profiler() const noexcept -> FeatureProfiler const& { return the_profiler; }
 
 private:
 	int candidates;
+	Khalil2016Features::FeaturesMask mask;
+	/** Static features computed at the root node, kept in SCIP precision. */
 	xt::xtensor<double, 2> static_features;
+	/** Shared by copies of the observation function, null if computing in the calling thread. */
+	std::shared_ptr<utility::ThreadPool> thread_pool;
+	/** Shared by copies of the observation function, null if not caching static features. */
+	std::shared_ptr<utility::FileCache> file_cache;
+	FeatureProfiler the_profiler;
 };
 
+using Khalil2016Obs = BasicKhalil2016Obs<double>;
+using Khalil2016 = BasicKhalil2016<double>;
+using Khalil2016ObsF32 = BasicKhalil2016Obs<float>;
+using Khalil2016F32 = BasicKhalil2016<float>;
+
 }  // namespace ecole::observation
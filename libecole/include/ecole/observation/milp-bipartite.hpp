@@ -1,19 +1,24 @@
 #pragma once
 
+#include <cstddef>
+#include <filesystem>
+#include <memory>
 #include <optional>
 
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
+#include "ecole/observation/feature-mask.hpp"
+#include "ecole/observation/profiler.hpp"
+#include "ecole/utility/file-cache.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::observation {
 
-class ECOLE_EXPORT MilpBipartiteObs {
-public:
-	using value_type = double;
-
+/** Layout of the features in MilpBipartite observations, common to all value types. */
+struct ECOLE_EXPORT MilpBipartiteFeatures {
 	static inline std::size_t constexpr n_variable_features = 9;
 	enum struct ECOLE_EXPORT VariableFeatures : std::size_t {
 		objective = 0,
@@ -31,21 +36,72 @@ public:
 		bias = 0,
 	};
 
+	using VariableFeaturesMask = FeatureMask<VariableFeatures, n_variable_features>;
+};
+
+/**
+ * Bipartite graph observation of the MILP during presolving.
+ *
+ * @tparam T The floating point type in which features are stored.
+ */
+template <typename T> struct ECOLE_EXPORT BasicMilpBipartiteObs : MilpBipartiteFeatures {
+	using value_type = T;
+
+	/** One row per variable, and one column per selected variable feature. */
 	xt::xtensor<value_type, 2> variable_features;
 	xt::xtensor<value_type, 2> constraint_features;
 	utility::coo_matrix<value_type> edge_features;
 };
 
-class ECOLE_EXPORT MilpBipartite {
+/**
+ * Bipartite graph observation function for the MILP during presolving.
+ *
+ * @tparam T The floating point type in which features are stored.
+ *         Variable features are written directly in this type, constraints are converted from SCIP precision.
+ */
+template <typename T> class ECOLE_EXPORT BasicMilpBipartite {
 public:
-	MilpBipartite(bool normalize_ = false) : normalize{normalize_} {}
+	/**
+	 * @param normalize_ Whether to normalize the objective and the constraints.
+	 * @param n_threads The number of threads used to extract the constraint matrix, 0 to extract it in the calling
+	 *        thread.
+	 * @param variable_mask_ The variable features to compute, the others are not stored in the observation.
+	 * @param cache_directory A directory in which to cache the observations, shared between episodes and processes,
+	 *        or empty to always compute them.
+	 *        Entries are keyed by the fingerprint of the model.
+	 */
+	ECOLE_EXPORT BasicMilpBipartite(
+		bool normalize_ = false,
+		std::size_t n_threads = 0,
+		MilpBipartiteFeatures::VariableFeaturesMask variable_mask_ = {},
+		std::filesystem::path const& cache_directory = {});
 
 	auto before_reset(scip::Model& /*model*/) -> void {}
 
-	ECOLE_EXPORT auto extract(scip::Model& model, bool done) const -> std::optional<MilpBipartiteObs>;
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) const -> std::optional<BasicMilpBipartiteObs<T>>;
+
+	/**
+	 * Time spent in each group of features, when enabled.
+	 *
+	 * Groups are the constraint matrix, with the constraint features and edges, and the variable features.
+	 */
+	[[nodiscard]] auto profiler() noexcept -> FeatureProfiler& { return the_profiler; }
+	[[nodiscard]] auto profiler() const noexcept -> FeatureProfiler const& { return the_profiler; }
 
 private:
+	MilpBipartiteFeatures::VariableFeaturesMask variable_mask;
+	/** Timing does not change the observations, hence can be recorded by the const extract. */
+	mutable FeatureProfiler the_profiler;
+	/** Shared by copies of the observation function, null if computing in the calling thread. */
+	std::shared_ptr<utility::ThreadPool> thread_pool;
+	/** Shared by copies of the observation function, null if not caching observations. */
+	std::shared_ptr<utility::FileCache> file_cache;
 	bool normalize = false;
 };
 
+using MilpBipartiteObs = BasicMilpBipartiteObs<double>;
+using MilpBipartite = BasicMilpBipartite<double>;
+using MilpBipartiteObsF32 = BasicMilpBipartiteObs<float>;
+using MilpBipartiteF32 = BasicMilpBipartite<float>;
+
 }  // namespace ecole::observation
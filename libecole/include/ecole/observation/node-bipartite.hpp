@@ -1,18 +1,21 @@
 #pragma once
 
 #include <optional>
+#include <string>
 
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
+#include "ecole/observation/collate.hpp"
+#include "ecole/observation/feature-mask.hpp"
+#include "ecole/observation/profiler.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
 
 namespace ecole::observation {
 
-struct ECOLE_EXPORT NodeBipartiteObs {
-	using value_type = double;
-
+/** Layout of the features in NodeBipartite observations, common to all value types. */
+struct ECOLE_EXPORT NodeBipartiteFeatures {
 	static inline std::size_t constexpr n_static_variable_features = 5;
 	static inline std::size_t constexpr n_dynamic_variable_features = 14;
 	static inline std::size_t constexpr n_variable_features = n_static_variable_features + n_dynamic_variable_features;
@@ -55,23 +58,126 @@ struct ECOLE_EXPORT NodeBipartiteObs {
 		scaled_age,
 	};
 
+	using VariableFeaturesMask = FeatureMask<VariableFeatures, n_variable_features>;
+	using RowFeaturesMask = FeatureMask<RowFeatures, n_row_features>;
+};
+
+/**
+ * Bipartite graph observation of a branch-and-bound node.
+ *
+ * @tparam T The floating point type in which features are stored.
+ */
+template <typename T> struct ECOLE_EXPORT BasicNodeBipartiteObs : NodeBipartiteFeatures {
+	using value_type = T;
+
+	/** One row per variable, and one column per selected variable feature. */
 	xt::xtensor<value_type, 2> variable_features;
+	/** One row per side of the LP rows, and one column per selected row feature. */
 	xt::xtensor<value_type, 2> row_features;
+	/** Edges in the coordinate format, empty if the CSR format is requested. */
 	utility::coo_matrix<value_type> edge_features;
+	/** Edges in the CSR format, empty unless requested. */
+	utility::csr_matrix<value_type> edge_features_csr;
 };
 
-class ECOLE_EXPORT NodeBipartite {
+/**
+ * Bipartite graph observations of many nodes written in caller owned memory.
+ *
+ * The graphs are written as a single disconnected graph.
+ * Edge indices are stored with shape (nnz, 2), the first column being the row index and the second the variable index,
+ * shifted by the number of rows and variables of the previous observations in the batch.
+ *
+ * @tparam T The floating point type in which features are stored.
+ */
+template <typename T> struct ECOLE_EXPORT NodeBipartiteBatch {
+	/** Batch with one column per selected variable feature. */
+	BatchMatrix<T> variable_features;
+	/** Batch with one column per selected row feature. */
+	BatchMatrix<T> row_features;
+	/** Batch with a single column. */
+	BatchMatrix<T> edge_values;
+	/** Batch with two columns. */
+	BatchMatrix<std::size_t> edge_indices;
+
+	void clear() noexcept {
+		variable_features.clear();
+		row_features.clear();
+		edge_values.clear();
+		edge_indices.clear();
+	}
+};
+
+/**
+ * Bipartite graph observation function on branch-and-bound nodes.
+ *
+ * @tparam T The floating point type in which features are stored.
+ *         Features are computed in SCIP precision and written directly in this type, so that single precision
+ *         observations do not require a double precision copy.
+ */
+template <typename T> class ECOLE_EXPORT BasicNodeBipartite {
 public:
-	NodeBipartite(bool cache = false) : use_cache{cache} {}
+	/**
+	 * @param cache Whether to reuse static features computed at the root node within an episode.
+	 * @param incremental Whether to update the previous observation rather than recomputing it entirely.
+	 *        Changes in the LP (rows, variable bounds, and solutions found) are tracked using SCIP events.
+	 *        Static features, bound and incumbent features, and the static features and edges of the rows that did
+	 *        not change in the LP are reused.
+	 *        Features depending on the LP solution, which are most dynamic features, are still recomputed for all
+	 *        variables and rows after every LP solve, so the saving is mostly on the rows and edges.
+	 * @param csr_edges Whether to extract edges in the CSR format rather than in the coordinate format.
+	 *        The index arrays are shared between successive observations when the LP rows are unchanged.
+	 * @param variable_mask The variable features to compute, the others are not stored in the observation.
+	 * @param row_mask The row features to compute, the others are not stored in the observation.
+	 */
+	ECOLE_EXPORT BasicNodeBipartite(
+		bool cache = false,
+		bool incremental = false,
+		bool csr_edges = false,
+		NodeBipartiteFeatures::VariableFeaturesMask variable_mask = {},
+		NodeBipartiteFeatures::RowFeaturesMask row_mask = {});
 
 	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
 
-	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<NodeBipartiteObs>;
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<BasicNodeBipartiteObs<T>>;
+
+	/**
+	 * Write the observation in the next rows of a batch.
+	 *
+	 * Unless the observation is cached, features are written directly in the batch without intermediate tensors.
+	 *
+	 * @return Whether an observation was written, otherwise an empty one is appended to the batch.
+	 * @see collate
+	 */
+	ECOLE_EXPORT auto extract_into(scip::Model& model, bool done, NodeBipartiteBatch<T>& batch) -> bool;
+
+	/**
+	 * Time spent in each group of features, when enabled.
+	 *
+	 * Groups are the static and dynamic variable features, the row features, and the edges.
+	 */
+	[[nodiscard]] auto profiler() noexcept -> FeatureProfiler& { return the_profiler; }
+	[[nodiscard]] auto profiler() const noexcept -> FeatureProfiler const& { return the_profiler; }
 
 private:
-	NodeBipartiteObs the_cache;
+	BasicNodeBipartiteObs<T> the_cache;
+	/** Index arrays of the last edges extracted, to be shared if unchanged. */
+	utility::csr_matrix<T> the_edges_pattern;
+	std::string eventhdlr_name;
+	NodeBipartiteFeatures::VariableFeaturesMask variable_mask;
+	NodeBipartiteFeatures::RowFeaturesMask row_mask;
+	FeatureProfiler the_profiler;
 	bool use_cache = false;
+	bool use_incremental = false;
+	bool use_csr_edges = false;
 	bool cache_computed = false;
+
+	/** Update the cache for the current node, and return whether it holds the observation. */
+	auto update_cache(scip::Model& model) -> bool;
 };
 
+using NodeBipartiteObs = BasicNodeBipartiteObs<double>;
+using NodeBipartite = BasicNodeBipartite<double>;
+using NodeBipartiteObsF32 = BasicNodeBipartiteObs<float>;
+using NodeBipartiteF32 = BasicNodeBipartite<float>;
+
 }  // namespace ecole::observation
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include <scip/scip.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/export.hpp"
+#include "ecole/observation/abstract.hpp"
+
+namespace ecole::observation {
+
+struct ECOLE_EXPORT PartialStrongBranchingScoresObs {
+	/** The score of every candidate, NaN for other variables. */
+	xt::xtensor<double, 1> scores;
+	/** Whether the score of a variable was computed with strong branching, rather than with its pseudocosts. */
+	xt::xtensor<bool, 1> is_exact;
+};
+
+/**
+ * Strong branching scores of the most promising candidates, within a budget.
+ *
+ * Candidates are sorted by decreasing pseudocost score, and strong branching is run on them in that order until one
+ * of the limits is reached.
+ * The budgets are checked before every candidate, so the last one evaluated can exceed them.
+ * Other candidates keep their pseudocost score.
+ */
+class ECOLE_EXPORT PartialStrongBranchingScores {
+public:
+	/**
+	 * @param pseudo_candidates Whether to score the pseudo candidates rather than the LP candidates.
+	 * @param max_candidates The maximum number of candidates evaluated with strong branching, or no limit.
+	 * @param max_lp_iterations The maximum number of LP iterations of strong branching, or no limit.
+	 * @param time_limit The maximum time spent in strong branching, in seconds, or no limit.
+	 */
+	ECOLE_EXPORT PartialStrongBranchingScores(
+		bool pseudo_candidates = false,
+		std::optional<std::size_t> max_candidates = {},
+		std::optional<SCIP_Longint> max_lp_iterations = {},
+		std::optional<double> time_limit = {});
+
+	auto before_reset(scip::Model& /*model*/) -> void {}
+
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) const -> std::optional<PartialStrongBranchingScoresObs>;
+
+private:
+	bool pseudo_candidates;
+	std::optional<std::size_t> max_candidates;
+	std::optional<SCIP_Longint> max_lp_iterations;
+	std::optional<double> time_limit;
+};
+
+}  // namespace ecole::observation
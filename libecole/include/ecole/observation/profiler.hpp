@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ecole/export.hpp"
+#include "ecole/utility/chrono.hpp"
+
+namespace ecole::observation {
+
+/** Cumulative time spent computing a group of features. */
+struct ECOLE_EXPORT ProfiledGroup {
+	std::string name;
+	std::size_t n_calls = 0;
+	/** Elapsed time in seconds. */
+	double wall_time = 0.;
+	/** CPU time of the process in seconds, including the one of worker threads. */
+	double cpu_time = 0.;
+};
+
+/**
+ * Record the time spent in each group of features of an observation function.
+ *
+ * Observation functions time their feature groups (such as static variable features, edges, or the LP relaxation
+ * solve) with @ref time.
+ * When the profiler is disabled, which is the default, timing a group does not read any clock.
+ */
+class ECOLE_EXPORT FeatureProfiler {
+public:
+	/** Time a group of features from its construction to its destruction. */
+	class ECOLE_EXPORT Scope {
+	public:
+		ECOLE_EXPORT Scope(FeatureProfiler* profiler, std::string_view group);
+		Scope(Scope const&) = delete;
+		Scope(Scope&&) = delete;
+		auto operator=(Scope const&) -> Scope& = delete;
+		auto operator=(Scope&&) -> Scope& = delete;
+		ECOLE_EXPORT ~Scope();
+
+	private:
+		FeatureProfiler* m_profiler;
+		std::string_view m_group;
+		std::chrono::steady_clock::time_point m_wall_start;
+		utility::cpu_clock::time_point m_cpu_start;
+	};
+
+	FeatureProfiler(bool enabled = false) noexcept : m_enabled{enabled} {}
+
+	[[nodiscard]] auto enabled() const noexcept -> bool { return m_enabled; }
+	/** Enable or disable recording, keeping the times recorded so far. */
+	void enable(bool enabled = true) noexcept { m_enabled = enabled; }
+	/** Forget the times recorded so far. */
+	void reset() noexcept { m_groups.clear(); }
+
+	/**
+	 * Time a group of features until the returned scope is destroyed.
+	 *
+	 * The group name must outlive the scope.
+	 */
+	[[nodiscard]] auto time(std::string_view group) -> Scope { return {m_enabled ? this : nullptr, group}; }
+
+	/** Add a call to a group of features, whether or not the profiler is enabled. */
+	ECOLE_EXPORT void record(std::string_view group, double wall_time, double cpu_time);
+
+	/** The groups recorded so far, in the order in which they were first recorded. */
+	[[nodiscard]] auto groups() const noexcept -> std::vector<ProfiledGroup> const& { return m_groups; }
+	/** The group with the given name, or nullptr if it was never recorded. */
+	[[nodiscard]] ECOLE_EXPORT auto group(std::string_view name) const noexcept -> ProfiledGroup const*;
+
+private:
+	std::vector<ProfiledGroup> m_groups;
+	bool m_enabled = false;
+};
+
+}  // namespace ecole::observation
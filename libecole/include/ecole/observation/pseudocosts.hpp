@@ -6,6 +6,7 @@
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
+#include "ecole/observation/collate.hpp"
 
 namespace ecole::observation {
 
@@ -14,6 +15,14 @@ public:
 	auto before_reset(scip::Model& /*model*/) -> void {}
 
 	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<xt::xtensor<double, 1>>;
+
+	/**
+	 * Write the pseudocosts in the next rows of a single column batch, one row per variable.
+	 *
+	 * @return Whether an observation was written, otherwise an empty one is appended to the batch.
+	 * @see collate
+	 */
+	ECOLE_EXPORT auto extract_into(scip::Model& model, bool done, BatchMatrix<double>& batch) -> bool;
 };
 
 }  // namespace ecole::observation
@@ -1,26 +1,42 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <optional>
 
+#include <scip/scip.h>
 #include <xtensor/xtensor.hpp>
 #include <xtensor/xview.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::observation {
 
 class ECOLE_EXPORT StrongBranchingScores {
 public:
-	ECOLE_EXPORT StrongBranchingScores(bool pseudo_candidates = false);
+	/**
+	 * @param pseudo_candidates Whether to score the pseudo candidates rather than the LP candidates.
+	 * @param n_threads The number of threads used to evaluate the candidates, 0 to run SCIP vanillafullstrong branching
+	 *        rule in the calling thread.
+	 *        With threads, every thread solves the children of the candidates on its own copy of the node LP.
+	 */
+	ECOLE_EXPORT StrongBranchingScores(bool pseudo_candidates = false, std::size_t n_threads = 0);
 
-	auto before_reset(scip::Model& /*model*/) -> void {}
+	/** Look up the handles of the parameters of the vanillafullstrong branching rule for the episode. */
+	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
 
 	ECOLE_EXPORT auto extract(scip::Model& model, bool done) const -> std::optional<xt::xtensor<double, 1>>;
 
 private:
 	bool pseudo_candidates;
+	/** Shared by copies of the observation function, null if computing in the calling thread. */
+	std::shared_ptr<utility::ThreadPool> thread_pool;
+	/** The model of the current episode, in which the handles of the vanillafullstrong parameters were looked up. */
+	SCIP const* params_scip = nullptr;
+	std::array<SCIP_PARAM*, 5> vanilla_params = {};
 };
 
 }  // namespace ecole::observation
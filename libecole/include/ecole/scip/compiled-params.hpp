@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <scip/scip.h>
+
+#include "ecole/export.hpp"
+#include "ecole/scip/type.hpp"
+
+namespace ecole::scip {
+
+/* Forward declare model type */
+class Model;
+
+/**
+ * A set of parameter values resolved and validated once, to be set repeatedly on models.
+ *
+ * Setting a parameter by name looks it up in a hash table, and Model::set_param also dispatches on its type.
+ * Here, the parameters are resolved to their type and position in SCIP when compiling, and the values are converted
+ * to that type and checked.
+ * Models with the same plugins as the one used to compile, such as models created with the default plugins, have
+ * their parameters at the same position, so they are set directly through their handle.
+ * Other models fall back to a lookup by name.
+ */
+class ECOLE_EXPORT CompiledParams {
+public:
+	/**
+	 * Resolve the parameters in the given model and convert the values to the type of the parameters.
+	 *
+	 * @throw ScipError if a parameter does not exist, if its value cannot be converted, or if it is not valid.
+	 */
+	ECOLE_EXPORT CompiledParams(Model const& model, std::map<std::string, Param> const& name_values);
+
+	/**
+	 * Set the parameters on a model.
+	 *
+	 * @throw ScipError if a parameter does not exist in the model or has a different type.
+	 */
+	ECOLE_EXPORT void apply(Model& model) const;
+
+	/** Number of parameters set. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return entries.size(); }
+
+private:
+	struct Entry {
+		std::string name;
+		/** Position of the parameter in the compiled model. */
+		std::size_t index;
+		/** Value converted to the exact type of the parameter. */
+		Param value;
+	};
+
+	std::vector<Entry> entries;
+	/** Number of parameters in the compiled model, to recognize models with the same parameters. */
+	std::size_t n_params = 0;
+};
+
+}  // namespace ecole::scip
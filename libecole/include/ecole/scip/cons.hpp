@@ -13,6 +13,7 @@
 #include "ecole/export.hpp"
 #include "ecole/scip/utils.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::scip {
 
@@ -68,7 +69,24 @@ ECOLE_EXPORT auto get_constraint_linear_coefs(SCIP* scip, SCIP_CONS* constraint)
 	std::tuple<std::vector<SCIP_VAR*>, std::vector<SCIP_Real>, std::optional<SCIP_Real>, std::optional<SCIP_Real>>>;
 ECOLE_EXPORT auto get_constraint_coefs(SCIP* scip, SCIP_CONS* constraint)
 	-> std::tuple<std::vector<SCIP_VAR*>, std::vector<SCIP_Real>, std::optional<SCIP_Real>, std::optional<SCIP_Real>>;
-ECOLE_EXPORT auto get_all_constraints(SCIP* scip, bool normalize = false, bool include_variable_bounds = false)
+
+/**
+ * Extract all constraints, and optionally the variable bounds, as a matrix of ``<=`` inequalities and their biases.
+ *
+ * A first pass counts the rows and non zeros of every constraint, so that the matrix is allocated once with its final
+ * size, and a second pass writes every constraint in its own rows.
+ * Before SCIP_STAGE_TRANSFORMED, the second pass is split in contiguous blocks of constraints among the threads of the
+ * pool, if given.
+ * Later, constraints are re-expressed in terms of active variables with SCIP buffer memory, so in the calling thread.
+ * The result does not depend on the number of threads.
+ *
+ * @throw ScipError If a constraint cannot be expressed as a single linear constraint.
+ */
+ECOLE_EXPORT auto get_all_constraints(
+	SCIP* scip,
+	bool normalize = false,
+	bool include_variable_bounds = false,
+	utility::ThreadPool* thread_pool = nullptr)
 	-> std::tuple<utility::coo_matrix<SCIP_Real>, xt::xtensor<SCIP_Real, 1>>;
 
 }  // namespace ecole::scip
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include <scip/scip.h>
+
+#include "ecole/export.hpp"
+#include "ecole/scip/scimpl.hpp"
+
+namespace ecole::scip {
+
+/**
+ * Initialized SCIP instances with the default plugins, kept for reuse by new Model.
+ *
+ * Creating a SCIP instance and including the default plugins registers hundreds of plugins and thousands of
+ * parameters, which dominates the creation of small models.
+ * Instead of being freed, released instances that were created by the pool and still only have the default plugins are
+ * recycled: their problem is freed, and their parameters and message handler are set back to their default state.
+ * Instances with other plugins, such as the callbacks included when iteratively solving, cannot be recycled since SCIP
+ * does not remove plugins.
+ * Neither can instances whose message handler was replaced, nor instances not created by the pool.
+ * The pool is shared by all threads.
+ */
+class ECOLE_EXPORT ModelPool {
+public:
+	ModelPool() = delete;
+
+	/** Take an instance in ``SCIP_STAGE_INIT`` from the pool, or create one and include the default plugins. */
+	ECOLE_EXPORT static auto acquire() -> std::unique_ptr<SCIP, ScipDeleter>;
+
+	/** Give an instance back to the pool if it can be recycled and the pool is not full, or free it. */
+	ECOLE_EXPORT static void release(SCIP* scip) noexcept;
+
+	/**
+	 * Whether the instance was created by ``acquire`` and still has the same plugins, parameters and message handler.
+	 *
+	 * Since plugins cannot be removed, they are compared by their number of each type, and parameters by their number.
+	 */
+	[[nodiscard]] ECOLE_EXPORT static auto has_default_plugins(SCIP* scip) -> bool;
+
+	/** Number of instances currently in the pool. */
+	[[nodiscard]] ECOLE_EXPORT static auto size() noexcept -> std::size_t;
+	/** Maximum number of instances kept for reuse. */
+	[[nodiscard]] ECOLE_EXPORT static auto capacity() noexcept -> std::size_t;
+	/** Change the maximum number of instances kept, freeing the ones in excess. Zero disables the pool. */
+	ECOLE_EXPORT static void set_capacity(std::size_t capacity) noexcept;
+
+	/** Free all instances in the pool. */
+	ECOLE_EXPORT static void clear() noexcept;
+};
+
+}  // namespace ecole::scip
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <functional>
@@ -28,6 +29,8 @@ namespace ecole::scip {
 
 /* Forward declare scip holder type */
 class Scimpl;
+class CompiledParams;
+class ParamSnapshot;
 
 /**
  * A stateful SCIP solver object.
@@ -64,6 +67,20 @@ public:
 	[[nodiscard]] ECOLE_EXPORT Model copy() const;
 	[[nodiscard]] ECOLE_EXPORT Model copy_orig() const;
 
+	/**
+	 * Copy the subproblem of the current node while solving.
+	 *
+	 * The new Model contains the problem restricted to the local bounds of the current node, along with the same
+	 * parameters and (copyable) plugins, and can be solved independently, for instance to evaluate a candidate action.
+	 * Like copy, forks of different models do not wait on one another, and the new Model does not share memory with the
+	 * original one.
+	 * Reverse callbacks used by iterative solving are not copied.
+	 *
+	 * @pre The Model must be in SCIP_STAGE_SOLVING, such as when paused in solve_iter.
+	 * @throw ScipError otherwise.
+	 */
+	[[nodiscard]] ECOLE_EXPORT Model fork() const;
+
 	/**
 	 * Compare if two model share the same SCIP pointer, _i.e._ the same memory.
 	 */
@@ -123,6 +140,8 @@ public:
 	template <typename T> [[nodiscard]] T get_param(std::string const& name) const;
 
 	ECOLE_EXPORT void set_params(std::map<std::string, Param> name_values);
+	/** Set parameters resolved in advance, which avoids looking them up by name. */
+	ECOLE_EXPORT void set_params(CompiledParams const& params);
 	[[nodiscard]] ECOLE_EXPORT std::map<std::string, Param> get_params() const;
 
 	ECOLE_EXPORT void disable_presolve();
@@ -136,6 +155,18 @@ public:
 	[[nodiscard]] ECOLE_EXPORT nonstd::span<SCIP_ROW*> lp_rows() const;
 	[[nodiscard]] ECOLE_EXPORT std::size_t nnz() const noexcept;
 
+	/**
+	 * A hash of the content of the problem in its current state.
+	 *
+	 * Models holding the same problem in the same state, for instance read from the same file, have the same
+	 * fingerprint, whatever their name.
+	 * The fingerprint covers the variables, the objective, and the linear data of the constraints, along with the
+	 * columns and rows of the LP while solving.
+	 * Constraints that do not expose their variables are only hashed by their type.
+	 * Computing it reads the whole problem, which is linear in its number of non zeros.
+	 */
+	[[nodiscard]] ECOLE_EXPORT std::uint64_t fingerprint() const;
+
 	ECOLE_EXPORT void transform_prob();
 	ECOLE_EXPORT void presolve();
 	ECOLE_EXPORT void solve();
@@ -212,6 +243,9 @@ public:
 	ECOLE_EXPORT auto solve_iter_continue(SCIP_RESULT result) -> std::optional<callback::DynamicCall>;
 
 private:
+	/* Uses the hash of the parameters cached in the Scimpl. */
+	friend class ParamSnapshot;
+
 	std::unique_ptr<Scimpl> scimpl;
 };
 
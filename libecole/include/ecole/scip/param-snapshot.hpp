@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ecole/export.hpp"
+#include "ecole/scip/type.hpp"
+
+namespace ecole::scip {
+
+/* Forward declare model type */
+class Model;
+
+/**
+ * The values of all the parameters of a model, stored in the order of SCIPgetParams.
+ *
+ * Unlike Model::get_params, taking a snapshot reads the parameters through their handle and does not store their
+ * names, so it is cheap enough to save and restore the solver configuration around a computation.
+ * A snapshot can be applied or compared to models with the same parameters as the one it was taken from, such as
+ * the model itself, its copies, or models created with the default plugins.
+ * This is checked with a hash of the names and types of the parameters, in order, which is computed when taking the
+ * snapshot and cached in the model it is applied to.
+ */
+class ECOLE_EXPORT ParamSnapshot {
+public:
+	/** Read the current value of all the parameters of the model. */
+	ECOLE_EXPORT explicit ParamSnapshot(Model const& model);
+
+	/**
+	 * Set the parameters of a model to the values of the snapshot.
+	 *
+	 * Only the parameters whose current value differs are changed.
+	 *
+	 * @return The number of parameters changed.
+	 * @throw ScipError if the model does not have the same parameters as the snapshot, in which case it is left
+	 *        untouched.
+	 */
+	ECOLE_EXPORT std::size_t apply(Model& model) const;
+
+	/**
+	 * Positions of the parameters whose value differs between two snapshots.
+	 *
+	 * @throw ScipError if the snapshots were not taken on models with the same parameters.
+	 */
+	[[nodiscard]] ECOLE_EXPORT std::vector<std::size_t> diff(ParamSnapshot const& other) const;
+
+	/** Number of parameters. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return values.size(); }
+	/** Value of the parameter at the given position in SCIPgetParams. */
+	[[nodiscard]] auto operator[](std::size_t i) const noexcept -> Param const& { return values[i]; }
+
+private:
+	std::vector<Param> values;
+	/** Hash of the names and types of the parameters, in order. */
+	std::uint64_t layout_hash = 0;
+};
+
+}  // namespace ecole::scip
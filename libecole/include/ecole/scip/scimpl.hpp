@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
 
@@ -32,16 +35,33 @@ public:
 
 	[[nodiscard]] ECOLE_EXPORT auto copy() const -> Scimpl;
 	[[nodiscard]] ECOLE_EXPORT auto copy_orig() const -> Scimpl;
+	[[nodiscard]] ECOLE_EXPORT auto fork() const -> Scimpl;
 
 	ECOLE_EXPORT auto solve_iter(nonstd::span<callback::DynamicConstructor const> arg_packs)
 		-> std::optional<callback::DynamicCall>;
 	ECOLE_EXPORT auto solve_iter_continue(SCIP_RESULT result) -> std::optional<callback::DynamicCall>;
 
+	/**
+	 * Hash of the names and types of the parameters, in order.
+	 *
+	 * Computed once and cached.
+	 * Parameters are never removed from SCIP, and the ones added by plugins are appended, so the hash is only
+	 * recomputed when the number of parameters changes.
+	 */
+	ECOLE_EXPORT auto param_layout_hash() -> std::uint64_t;
+
 private:
 	using Controller = utility::Coroutine<callback::DynamicCall, SCIP_RESULT>;
 
 	std::unique_ptr<SCIP, ScipDeleter> m_scip;
 	std::unique_ptr<Controller> m_controller;
+	// Copying updates some of the source SCIP data structures (such as statistics and hash tables), hence concurrent
+	// copies of the same source are serialized.
+	// Copies of different sources do not share any state and run concurrently.
+	// Held by pointer to keep Scimpl movable.
+	std::unique_ptr<std::mutex> m_copy_mutex = std::make_unique<std::mutex>();
+	std::size_t m_n_hashed_params = 0;
+	std::uint64_t m_param_layout_hash = 0;
 };
 
 }  // namespace ecole::scip
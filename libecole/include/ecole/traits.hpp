@@ -2,6 +2,7 @@
 
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include "ecole/information/abstract.hpp"
 #include "ecole/reward/abstract.hpp"
@@ -103,9 +104,21 @@ template <typename, typename = void> struct has_step_dynamics : std::false_type
 template <typename T> struct has_step_dynamics<T, std::void_t<decltype(&T::step_dynamics)>> : std::true_type {};
 template <typename T> inline constexpr bool has_step_dynamics_v = has_step_dynamics<T>::value;
 
+/** Result of step_dynamics called with the Action of the dynamics, used when step_dynamics is overloaded. */
+template <typename T>
+using step_dynamics_result_t = decltype(std::declval<T&>().step_dynamics(
+	std::declval<scip::Model&>(), std::declval<typename T::Action const&>()));
+
+template <typename, typename = void> struct has_overloaded_step_dynamics : std::false_type {};
+template <typename T>
+struct has_overloaded_step_dynamics<T, std::void_t<step_dynamics_result_t<T>>> :
+	std::bool_constant<!has_step_dynamics_v<T>> {};
+template <typename T> inline constexpr bool has_overloaded_step_dynamics_v = has_overloaded_step_dynamics<T>::value;
+
 }  // namespace internal
 
-template <typename T> inline constexpr bool is_dynamics_v = internal::has_step_dynamics_v<T>;
+template <typename T>
+inline constexpr bool is_dynamics_v = internal::has_step_dynamics_v<T> || internal::has_overloaded_step_dynamics_v<T>;
 
 /*********************************
  *  Detection of extracted data  *
@@ -155,10 +168,14 @@ template <typename T> struct action_of<T, std::enable_if_t<is_environment_v<T>>>
 	using type = std::decay_t<utility::arg_t<1, decltype(&T::template step<>)>>;
 };
 
-template <typename T> struct action_of<T, std::enable_if_t<is_dynamics_v<T>>> {
+template <typename T> struct action_of<T, std::enable_if_t<internal::has_step_dynamics_v<T>>> {
 	using type = std::decay_t<utility::arg_t<2, decltype(&T::step_dynamics)>>;
 };
 
+template <typename T> struct action_of<T, std::enable_if_t<internal::has_overloaded_step_dynamics_v<T>>> {
+	using type = typename T::Action;
+};
+
 template <typename T> using action_of_t = typename action_of<T>::type;
 
 /*****************************
@@ -171,10 +188,14 @@ template <typename T> struct action_set_of<T, std::enable_if_t<is_environment_v<
 	using type = std::tuple_element_t<1, utility::return_t<decltype(&T::template step<>)>>;
 };
 
-template <typename T> struct action_set_of<T, std::enable_if_t<is_dynamics_v<T>>> {
+template <typename T> struct action_set_of<T, std::enable_if_t<internal::has_step_dynamics_v<T>>> {
 	using type = std::tuple_element_t<1, utility::return_t<decltype(&T::step_dynamics)>>;
 };
 
+template <typename T> struct action_set_of<T, std::enable_if_t<internal::has_overloaded_step_dynamics_v<T>>> {
+	using type = std::tuple_element_t<1, internal::step_dynamics_result_t<T>>;
+};
+
 template <typename T> using action_set_of_t = typename action_set_of<T>::type;
 
 }  // namespace ecole::trait
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace ecole::utility {
+
+/**
+ * A thread safe queue of completed asynchronous operations.
+ *
+ * Producers push items as operations complete, in any order, and a consumer pops them in order of completion.
+ * This lets a single thread wait on many asynchronous operations at once.
+ */
+template <typename T> class CompletionQueue {
+public:
+	/** Add a completed item and wake up one waiting consumer. */
+	void push(T item);
+
+	/** Wait until an item is available and remove it. */
+	auto pop() -> T;
+
+	/** Remove an item if one is available, without waiting. */
+	auto try_pop() -> std::optional<T>;
+
+	/** The number of items currently available. */
+	[[nodiscard]] auto size() const -> std::size_t;
+
+private:
+	mutable std::mutex mutex;
+	std::condition_variable cv;
+	std::deque<T> items;
+};
+
+/***************************************
+ *  Implementation of CompletionQueue  *
+ ***************************************/
+
+template <typename T> void CompletionQueue<T>::push(T item) {
+	{
+		auto lock = std::lock_guard{mutex};
+		items.push_back(std::move(item));
+	}
+	cv.notify_one();
+}
+
+template <typename T> auto CompletionQueue<T>::pop() -> T {
+	auto lock = std::unique_lock{mutex};
+	cv.wait(lock, [this] { return !items.empty(); });
+	auto item = std::move(items.front());
+	items.pop_front();
+	return item;
+}
+
+template <typename T> auto CompletionQueue<T>::try_pop() -> std::optional<T> {
+	auto lock = std::lock_guard{mutex};
+	if (items.empty()) {
+		return {};
+	}
+	auto item = std::move(items.front());
+	items.pop_front();
+	return item;
+}
+
+template <typename T> auto CompletionQueue<T>::size() const -> std::size_t {
+	auto lock = std::lock_guard{mutex};
+	return items.size();
+}
+
+}  // namespace ecole::utility
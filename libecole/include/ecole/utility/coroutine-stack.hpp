@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ecole/export.hpp"
+
+namespace ecole::utility {
+
+/**
+ * A memory region used as the execution stack of a Coroutine.
+ *
+ * Stacks are mapped with ``mmap`` and protected by a guard page, so that an overflow terminates with a segmentation
+ * fault rather than silently corrupting memory.
+ * Since mapped memory is only committed when used, stacks can be large without increasing memory usage.
+ * Released stacks are kept in a free list local to the releasing thread, and reused by subsequent allocations of the
+ * same size on that thread, avoiding mapping a new stack on every new Coroutine.
+ * Up to 16 stacks are kept per thread.
+ * Apart from their top 64 KiB, where the first frames of a Coroutine are written, their memory is given back to the
+ * system with ``madvise(MADV_DONTNEED)`` when released.
+ * Hence a thread keeps at most 1 MiB committed in its free list, rather than the whole size of the stacks deeply used.
+ */
+class ECOLE_EXPORT CoroutineStack {
+public:
+	/** Get a stack from the thread free list, or map a new one. */
+	ECOLE_EXPORT CoroutineStack(std::size_t size = default_size());
+	ECOLE_EXPORT CoroutineStack(CoroutineStack&& other) noexcept;
+	CoroutineStack(CoroutineStack const&) = delete;
+
+	/** Give the stack back to the free list of the current thread. */
+	ECOLE_EXPORT ~CoroutineStack();
+
+	ECOLE_EXPORT auto operator=(CoroutineStack&& other) noexcept -> CoroutineStack&;
+	auto operator=(CoroutineStack const&) -> CoroutineStack& = delete;
+
+	/** Lowest usable address of the stack, above the guard page. */
+	[[nodiscard]] auto data() const noexcept -> void* { return m_data; }
+	/** Usable size of the stack, excluding the guard page. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+	/** Stack size used by new Coroutine, rounded up to a multiple of the page size. */
+	ECOLE_EXPORT static auto default_size() noexcept -> std::size_t;
+	/** Change the stack size used by new Coroutine. Existing Coroutine are unaffected. */
+	ECOLE_EXPORT static void set_default_size(std::size_t size);
+
+	/** Unmap all stacks in the free list of the current thread. */
+	ECOLE_EXPORT static void release_free_list() noexcept;
+
+private:
+	void* m_data = nullptr;
+	std::size_t m_size = 0;
+
+	void release() noexcept;
+};
+
+}  // namespace ecole::utility
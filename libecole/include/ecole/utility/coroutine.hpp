@@ -1,13 +1,14 @@
 #pragma once
 
-#include <condition_variable>
+#include <functional>
+#include <iostream>
 #include <memory>
-#include <mutex>
 #include <optional>
+#include <utility>
 #include <variant>
-#include <ucontext.h>
 
-#define STACK_SIZE 18192
+#include "ecole/utility/coroutine-stack.hpp"
+#include "ecole/utility/execution-context.hpp"
 
 namespace ecole::utility {
 
@@ -73,72 +74,51 @@ public:
 	/** Return whether the message is a ``StopToken``/ */
 	static auto is_stop(MessageOrStop const& message) -> bool;
 
-	class Executor{
-		ucontext_t main_context, generator_context;
-		Message message;
-		MaybeReturn value;
-
-		char stack_main[STACK_SIZE];
-		char stack_generator[STACK_SIZE];
-
-		template <class Function, class... Args>
-		static void run(Function&& f, std::weak_ptr<Executor>* executor, Args&&... args) {
-			std::weak_ptr<Executor> sharedPtr = *executor;
-			f(sharedPtr, args...);
-			sharedPtr.lock()->value.reset();
-			setcontext(&(executor->lock()->main_context));
-		}
-
+	class Executor {
 	public:
 		using StopToken = Coroutine::StopToken;
-		Executor():
-			main_context(),
-			generator_context() {
-		}
 
-		~Executor(){
-			std::flush(std::cout);
-		}
+		~Executor() { std::flush(std::cout); }
 
+		/** Prepare the execution of the function, that starts on the first call to ``wait``. */
 		template <typename Function, typename... Args>
-		void start(std::weak_ptr<Executor>* executor, Function&& func_, Args&&... args_){
-			volatile bool b = true;
-
-			getcontext(&main_context);
-			main_context.uc_stack.ss_sp = stack_main;
-			main_context.uc_stack.ss_size = sizeof(stack_main);
-
-			if (b) {
-				b = false;
-
-				getcontext(&generator_context);
-				generator_context.uc_stack.ss_sp = stack_generator;
-				generator_context.uc_stack.ss_size = sizeof(stack_generator);
-
-				makecontext(
-					&generator_context,
-					(void (*)(void))Executor::run<Function, Args...>,
-					sizeof...(Args) + 2,
-					&func_,
-					executor,
-					&args_...);
-			}
+		void start(std::weak_ptr<Executor>* executor, Function&& func_, Args&&... args_) {
+			// The function and arguments are copied, as the executor starts after the Coroutine constructor returns.
+			body = [weak_executor = *executor, func = std::forward<Function>(func_), args_...]() mutable {
+				func(weak_executor, args_...);
+			};
+			generator_context.emplace(stack_generator, &Executor::run, this);
 		}
 
-		MaybeReturn wait(){
-			swapcontext(&main_context, &generator_context);
+		MaybeReturn wait() {
+			main_context.switch_to(*generator_context);
 			return std::move(value);
 		}
 
-		void resume(Message instruction){
-			message=std::move(instruction);
-		}
+		void resume(Message instruction) { message = std::move(instruction); }
 
-		MessageOrStop yield(Return value){
-			this->value = std::move(value);
-			swapcontext(&generator_context, &main_context);
+		MessageOrStop yield(Return return_value) {
+			value = std::move(return_value);
+			generator_context->switch_to(main_context);
 			return std::move(message);
 		}
+
+	private:
+		// Only the executor needs its own stack, the coroutine runs on the stack of the calling thread.
+		CoroutineStack stack_generator;
+		ExecutionContext main_context;
+		std::optional<ExecutionContext> generator_context;
+		std::function<void()> body;
+		Message message;
+		MaybeReturn value;
+
+		static void run(void* self) noexcept {
+			auto* const executor = static_cast<Executor*>(self);
+			executor->body();
+			executor->value.reset();
+			// The generator context is never resumed after the function has finished.
+			executor->generator_context->switch_to(executor->main_context);
+		}
 	};
 
 private:
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+
+#include "ecole/export.hpp"
+#include "ecole/utility/coroutine-stack.hpp"
+
+namespace ecole::utility {
+
+/**
+ * The saved state of a flow of control, resumed by switching to it.
+ *
+ * This is the context switch used by Coroutine.
+ * Two backends are available, selected when building Ecole with the ``ECOLE_COROUTINE_CONTEXT`` CMake option.
+ * The ``fcontext`` backend, available on x86-64 and AArch64, only saves the callee-saved registers and the stack
+ * pointer, without any system call.
+ * The ``ucontext`` backend uses ``swapcontext``, which also saves the signal mask with a system call on every switch.
+ */
+class ECOLE_EXPORT ExecutionContext {
+public:
+	/** Entry point of a new flow of control, that must never return. */
+	using Entry = void (*)(void*) noexcept;
+
+	/** A context in which the current flow of control is saved when switching away from it. */
+	ECOLE_EXPORT ExecutionContext();
+	/** A context that calls ``entry(arg)`` on the given stack the first time it is switched to. */
+	ECOLE_EXPORT ExecutionContext(CoroutineStack const& stack, Entry entry, void* arg);
+	ExecutionContext(ExecutionContext const&) = delete;
+	ExecutionContext(ExecutionContext&&) = delete;
+	ECOLE_EXPORT ~ExecutionContext();
+
+	auto operator=(ExecutionContext const&) -> ExecutionContext& = delete;
+	auto operator=(ExecutionContext&&) -> ExecutionContext& = delete;
+
+	/** Save the current flow of control in this context and resume the target, until this context is resumed. */
+	ECOLE_EXPORT void switch_to(ExecutionContext& target);
+
+	/** The name of the backend selected at build time. */
+	ECOLE_EXPORT static auto backend() noexcept -> char const*;
+
+private:
+	struct State;
+	std::unique_ptr<State> state;
+};
+
+}  // namespace ecole::utility
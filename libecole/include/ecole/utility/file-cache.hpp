@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "ecole/export.hpp"
+
+namespace ecole::utility {
+
+/** A multidimensional array of doubles, with values in row major order. */
+struct ECOLE_EXPORT CachedArray {
+	std::vector<std::size_t> shape;
+	std::vector<double> values;
+};
+
+/**
+ * A cache of arrays in binary files, shared between threads and processes.
+ *
+ * Every entry is stored in its own file of the cache directory, named after its key.
+ * Entries are written in a temporary file that is then renamed, so that readers, including in other processes, only
+ * ever see complete entries.
+ * Concurrent writers of a key are expected to write the same arrays, and the last rename wins.
+ *
+ * A file is a sequence of native 64 bits words: a magic number, the key, the number of arrays, and for every array
+ * its number of dimensions, its shape, and its values.
+ * Values are hence aligned, so that files can also be memory mapped.
+ */
+class ECOLE_EXPORT FileCache {
+public:
+	using Key = std::uint64_t;
+
+	/** Use the given directory, creating it if it does not exist. */
+	ECOLE_EXPORT FileCache(std::filesystem::path directory);
+
+	[[nodiscard]] auto directory() const noexcept -> std::filesystem::path const& { return m_directory; }
+	/** The file in which the entry of a key is stored. */
+	[[nodiscard]] ECOLE_EXPORT auto path(Key key) const -> std::filesystem::path;
+
+	/** The arrays stored with a key, or nothing if there is no valid entry for it. */
+	[[nodiscard]] ECOLE_EXPORT auto load(Key key) const -> std::optional<std::vector<CachedArray>>;
+
+	/**
+	 * Store arrays with a key, replacing its current entry.
+	 *
+	 * Caching is best effort: if the entry cannot be written, for instance because the disk is full, the cache is left
+	 * unchanged and false is returned.
+	 */
+	ECOLE_EXPORT auto store(Key key, nonstd::span<CachedArray const> arrays) const -> bool;
+
+private:
+	std::filesystem::path m_directory;
+};
+
+}  // namespace ecole::utility
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstddef>
+#include <memory>
 #include <tuple>
 
 #include <xtensor/xtensor.hpp>
@@ -35,6 +36,35 @@ template <typename T> struct coo_matrix {
 	auto operator==(coo_matrix const& other) const -> bool;
 };
 
+/**
+ * Compressed sparse row matrix.
+ *
+ * The non zero values of row ``i`` are ``values[row_ptrs[i]:row_ptrs[i+1]]``, and their columns are given by the same
+ * slice of ``col_indices``.
+ * Index arrays are immutable and reference counted, so that matrices with the same sparsity pattern (such as the
+ * constraint matrix at different nodes when the LP rows are unchanged) share them, and only own their values.
+ */
+template <typename T> struct csr_matrix {
+	using value_type = T;
+	using index_array = xt::xtensor<std::size_t, 1>;
+
+	xt::xtensor<value_type, 1> values;
+	std::shared_ptr<index_array const> row_ptrs = std::make_shared<index_array const>(index_array{0});
+	std::shared_ptr<index_array const> col_indices = std::make_shared<index_array const>(index_array::from_shape({0}));
+	std::array<std::size_t, 2> shape = {0, 0};
+
+	[[nodiscard]] static auto from_coo(coo_matrix<T> const& coo) -> csr_matrix;
+	[[nodiscard]] auto to_coo() const -> coo_matrix<T>;
+
+	[[nodiscard]] auto nnz() const noexcept -> std::size_t { return values.size(); }
+
+	/** Whether the index arrays are the same objects in memory, hence the sparsity patterns are the same. */
+	[[nodiscard]] auto shares_indices_with(csr_matrix const& other) const noexcept -> bool;
+
+	/** Compare the content, whether or not indices are shared. */
+	auto operator==(csr_matrix const& other) const -> bool;
+};
+
 /**********************************
  *  Implementation of coo_matrix  *
  **********************************/
@@ -54,4 +84,53 @@ template <typename T> auto coo_matrix<T>::operator==(coo_matrix const& other) co
 	return std::tie(values, indices, shape) == std::tie(other.values, other.indices, other.shape);
 }
 
+/**********************************
+ *  Implementation of csr_matrix  *
+ **********************************/
+
+/** Assumes that the entries of the coordinate matrix are sorted by rows. */
+template <typename T> auto csr_matrix<T>::from_coo(coo_matrix<T> const& coo) -> csr_matrix {
+	auto const n_rows = coo.shape[0];
+	auto const nnz = coo.nnz();
+	auto row_ptrs = index_array::from_shape({n_rows + 1});
+	auto col_indices = index_array::from_shape({nnz});
+	std::size_t k = 0;
+	for (std::size_t row = 0; row < n_rows; ++row) {
+		row_ptrs[row] = k;
+		while ((k < nnz) && (coo.indices(0, k) == row)) {
+			col_indices[k] = coo.indices(1, k);
+			++k;
+		}
+	}
+	row_ptrs[n_rows] = k;
+	return {
+		coo.values,
+		std::make_shared<index_array const>(std::move(row_ptrs)),
+		std::make_shared<index_array const>(std::move(col_indices)),
+		coo.shape,
+	};
+}
+
+template <typename T> auto csr_matrix<T>::to_coo() const -> coo_matrix<T> {
+	auto indices = decltype(coo_matrix<T>::indices)::from_shape({2, nnz()});
+	for (std::size_t row = 0; row + 1 < row_ptrs->size(); ++row) {
+		for (auto k = (*row_ptrs)[row]; k < (*row_ptrs)[row + 1]; ++k) {
+			indices(0, k) = row;
+			indices(1, k) = (*col_indices)[k];
+		}
+	}
+	return {values, std::move(indices), shape};
+}
+
+template <typename T> auto csr_matrix<T>::shares_indices_with(csr_matrix const& other) const noexcept -> bool {
+	return (row_ptrs == other.row_ptrs) && (col_indices == other.col_indices);
+}
+
+template <typename T> auto csr_matrix<T>::operator==(csr_matrix const& other) const -> bool {
+	if ((shape != other.shape) || (values != other.values)) {
+		return false;
+	}
+	return shares_indices_with(other) || ((*row_ptrs == *other.row_ptrs) && (*col_indices == *other.col_indices));
+}
+
 }  // namespace ecole::utility
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ecole/export.hpp"
+
+namespace ecole::utility {
+
+/**
+ * A fixed size pool of worker threads.
+ *
+ * Every worker has its own task queue so that a task can be pinned to a given thread.
+ * This is required for stateful tasks, such as resuming the solving coroutine of a Model, that must always be run on
+ * the same thread.
+ * A pool with zero thread is valid and runs all tasks synchronously in the calling thread.
+ */
+class ECOLE_EXPORT ThreadPool {
+public:
+	/** Create the worker threads. */
+	ECOLE_EXPORT ThreadPool(std::size_t n_threads = std::thread::hardware_concurrency());
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+
+	/** Finish all pending tasks and join the worker threads. */
+	ECOLE_EXPORT ~ThreadPool();
+
+	auto operator=(ThreadPool const&) -> ThreadPool& = delete;
+	auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+	[[nodiscard]] ECOLE_EXPORT auto n_threads() const noexcept -> std::size_t;
+
+	/**
+	 * Run a function on the given worker thread.
+	 *
+	 * @param worker The index of the worker thread, taken modulo the number of threads.
+	 * @param func A callable without parameters.
+	 * @return A future holding the result or the exception raised by the function.
+	 */
+	template <typename Func> auto submit(std::size_t worker, Func&& func) -> std::future<std::invoke_result_t<Func>>;
+
+	/**
+	 * Call a function on all indices in [0, n) and wait for completion.
+	 *
+	 * Index ``i`` is always processed by worker ``i % n_threads()``, so that repeated calls dispatch the same index to
+	 * the same thread.
+	 * All indices are processed even if some of them raise an exception.
+	 * The exception with the lowest index is then rethrown.
+	 *
+	 * @param n The number of indices to process.
+	 * @param func A callable taking an index as sole parameter.
+	 */
+	template <typename Func> void parallel_for(std::size_t n, Func&& func);
+
+private:
+	using Task = std::function<void()>;
+
+	struct Worker {
+		std::mutex mutex;
+		std::condition_variable cv;
+		std::deque<Task> tasks;
+		bool stop = false;
+		std::thread thread;
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	ECOLE_EXPORT void push(std::size_t worker, Task task);
+	static void work(Worker& worker);
+};
+
+/**********************************
+ *  Implementation of ThreadPool  *
+ **********************************/
+
+template <typename Func>
+auto ThreadPool::submit(std::size_t worker, Func&& func) -> std::future<std::invoke_result_t<Func>> {
+	using Return = std::invoke_result_t<Func>;
+	// std::function needs to be copyable, hence the packaged_task is shared.
+	auto task = std::make_shared<std::packaged_task<Return()>>(std::forward<Func>(func));
+	auto result = task->get_future();
+	push(worker, [task]() { (*task)(); });
+	return result;
+}
+
+template <typename Func> void ThreadPool::parallel_for(std::size_t n, Func&& func) {
+	auto errors = std::vector<std::exception_ptr>(n);
+	auto run = [&errors, &func](std::size_t i) {
+		try {
+			func(i);
+		} catch (...) {
+			errors[i] = std::current_exception();
+		}
+	};
+
+	if (n_threads() == 0) {
+		for (std::size_t i = 0; i < n; ++i) {
+			run(i);
+		}
+	} else {
+		// One task per worker, rather than per index, to limit synchronization.
+		auto const n_tasks = std::min(n, n_threads());
+		auto pending = std::vector<std::future<void>>{};
+		pending.reserve(n_tasks);
+		for (std::size_t worker = 0; worker < n_tasks; ++worker) {
+			pending.push_back(submit(worker, [&run, worker, n, stride = n_threads()]() {
+				for (auto i = worker; i < n; i += stride) {
+					run(i);
+				}
+			}));
+		}
+		for (auto& fut : pending) {
+			fut.wait();
+		}
+	}
+
+	for (auto const& error : errors) {
+		if (error != nullptr) {
+			std::rethrow_exception(error);
+		}
+	}
+}
+
+}  // namespace ecole::utility
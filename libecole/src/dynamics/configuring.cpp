@@ -1,4 +1,5 @@
 #include "ecole/dynamics/configuring.hpp"
+#include "ecole/scip/compiled-params.hpp"
 #include "ecole/scip/model.hpp"
 
 namespace ecole::dynamics {
@@ -16,4 +17,11 @@ auto ConfiguringDynamics::step_dynamics(scip::Model& model, ParamDict const& par
 	return {true, None};
 }
 
+auto ConfiguringDynamics::step_dynamics(scip::Model& model, scip::CompiledParams const& params) const
+	-> std::tuple<bool, NoneType> {
+	model.set_params(params);
+	model.solve();
+	return {true, None};
+}
+
 }  // namespace ecole::dynamics
@@ -1,17 +1,35 @@
 #include <random>
 
+#include <scip/scip.h>
+
 #include "ecole/dynamics/parts.hpp"
+#include "ecole/scip/exception.hpp"
 #include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
 
 namespace ecole::dynamics {
 
+namespace {
+
+/** Set a parameter of known type through its handle, looking it up by name only once. */
+template <typename Func, typename T> void change_param(SCIP* scip, char const* name, Func change, T value) {
+	auto* const param = SCIPgetParam(scip, name);
+	if (param == nullptr) {
+		throw scip::ScipError::from_retcode(SCIP_PARAMETERUNKNOWN);
+	}
+	scip::call(change, scip, param, value);
+}
+
+}  // namespace
+
 auto DefaultSetDynamicsRandomState::set_dynamics_random_state(scip::Model& model, RandomGenerator& rng) const -> void {
 	std::uniform_int_distribution<scip::Seed> seed_distrib{scip::min_seed, scip::max_seed};
-	model.set_param("randomization/permuteconss", true);
-	model.set_param("randomization/permutevars", true);
-	model.set_param("randomization/permutationseed", seed_distrib(rng));
-	model.set_param("randomization/randomseedshift", seed_distrib(rng));
-	model.set_param("randomization/lpseed", seed_distrib(rng));
+	auto* const scip = model.get_scip_ptr();
+	change_param(scip, "randomization/permuteconss", SCIPchgBoolParam, TRUE);
+	change_param(scip, "randomization/permutevars", SCIPchgBoolParam, TRUE);
+	change_param(scip, "randomization/permutationseed", SCIPchgIntParam, seed_distrib(rng));
+	change_param(scip, "randomization/randomseedshift", SCIPchgIntParam, seed_distrib(rng));
+	change_param(scip, "randomization/lpseed", SCIPchgIntParam, seed_distrib(rng));
 }
 
 }  // namespace ecole::dynamics
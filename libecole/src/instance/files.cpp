@@ -43,6 +43,10 @@ FileGenerator::FileGenerator(Parameters parameters_) :
 FileGenerator::FileGenerator() : FileGenerator{Parameters{}} {}
 
 auto FileGenerator::next() -> scip::Model {
+	return next_deferred()();
+}
+
+auto FileGenerator::next_deferred() -> std::function<scip::Model()> {
 	if (done()) {
 		throw IteratorExhausted{};
 	}
@@ -52,17 +56,18 @@ auto FileGenerator::next() -> scip::Model {
 
 	auto choice = std::uniform_int_distribution<std::size_t>{0, files_remaining - 1};
 	auto const idx = choice(rng);
+	auto read_file = [](fs::path file) { return [file = std::move(file)]() { return scip::Model::from_file(file); }; };
 
 	// files_remaining is not used in this case, it is only an alias for files.size().
 	if (parameters.sampling_mode == Parameters::SamplingMode::replace) {
-		return scip::Model::from_file(files[idx]);
+		return read_file(files[idx]);
 	}
 
 	// files[0: files_reamining] are unseen files, while files[files_reamining: -1] are seen.
 	// We mark files[idx] as seen by exchanging it with files[files_remaining]
 	files_remaining--;
 	swap(files[idx], files[files_remaining]);
-	return scip::Model::from_file(files[files_remaining]);
+	return read_file(files[files_remaining]);
 }
 
 void FileGenerator::seed(Seed seed) {
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "ecole/exception.hpp"
+#include "ecole/instance/prefetching.hpp"
+
+namespace ecole::instance {
+
+PrefetchingGenerator::PrefetchingGenerator(
+	std::unique_ptr<InstanceGenerator> generator_,
+	std::size_t n_workers,
+	std::size_t queue_size_) :
+	generator{std::move(generator_)}, queue_size{std::max(queue_size_, std::size_t{1})}, the_threads{n_workers} {
+	exhausted = generator->done();
+	fill_queue();
+}
+
+PrefetchingGenerator::~PrefetchingGenerator() {
+	clear_queue();
+}
+
+scip::Model PrefetchingGenerator::next() {
+	if (n_workers() == 0) {
+		return generator->next();
+	}
+	if (exhausted) {
+		throw IteratorExhausted{};
+	}
+	try {
+		fill_queue();
+		if (pending.empty()) {
+			throw IteratorExhausted{};
+		}
+		auto instance = std::move(pending.front());
+		pending.pop_front();
+		// Replace the slot before waiting so that workers stay busy
+		fill_queue();
+		return instance.get();
+	} catch (IteratorExhausted const&) {
+		// The following instances were generated past the end of the generator
+		exhausted = true;
+		clear_queue();
+		throw;
+	}
+}
+
+void PrefetchingGenerator::seed(Seed seed) {
+	clear_queue();
+	generator->seed(seed);
+	n_slots_submitted = 0;
+	exhausted = generator->done();
+	fill_queue();
+}
+
+bool PrefetchingGenerator::done() const {
+	// The generator cannot be used while a worker may be using it
+	if ((n_workers() == 0) || (defers_generation && !exhausted)) {
+		return pending.empty() && generator->done();
+	}
+	return exhausted;
+}
+
+void PrefetchingGenerator::fill_queue() {
+	if (n_workers() == 0 || exhausted) {
+		return;
+	}
+	while (pending.size() < queue_size) {
+		if (defers_generation) {
+			if (generator->done()) {
+				return;
+			}
+			auto generate = generator->next_deferred();
+			if (generate != nullptr) {
+				// Deferred instances do not use the generator, so they are generated by all workers in turn
+				pending.push_back(the_threads.submit(n_slots_submitted % n_workers(), std::move(generate)));
+				++n_slots_submitted;
+				continue;
+			}
+			// Only known once the first instance is requested
+			defers_generation = false;
+		}
+		// The generator is used in order by the first worker only
+		pending.push_back(the_threads.submit(0, [wrapped = generator.get()]() { return wrapped->next(); }));
+		++n_slots_submitted;
+	}
+}
+
+void PrefetchingGenerator::clear_queue() {
+	for (auto& instance : pending) {
+		instance.wait();
+	}
+	pending.clear();
+}
+
+}  // namespace ecole::instance
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/observation/feature-mask.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/utility/file-cache.hpp"
+#include "ecole/version.hpp"
+
+#include "utility/hash.hpp"
+
+namespace ecole::observation {
+
+/** The cache of the features of an observation function, or null if the directory is empty. */
+inline auto make_file_cache(std::filesystem::path const& cache_directory) -> std::shared_ptr<utility::FileCache> {
+	if (cache_directory.empty()) {
+		return nullptr;
+	}
+	return std::make_shared<utility::FileCache>(cache_directory);
+}
+
+/**
+ * Start the key of a group of features computed on the model in its current state.
+ *
+ * The key depends on the fingerprint of the model, and on the versions of Ecole and SCIP so that entries written by
+ * other versions are not used.
+ * Observation functions then add the parameters that change the features.
+ */
+inline auto feature_cache_key(scip::Model const& model, std::string_view features) -> utility::Hasher {
+	auto hasher = utility::Hasher{model.fingerprint()};
+	auto const ecole_version = version::get_ecole_lib_version();
+	hasher.add(ecole_version.major).add(ecole_version.minor).add(ecole_version.patch).add(ecole_version.revision);
+	auto const scip_version = version::get_scip_lib_version();
+	hasher.add(scip_version.major).add(scip_version.minor).add(scip_version.patch);
+	return hasher.add(features);
+}
+
+template <typename Feature, std::size_t N>
+void add_feature_mask(utility::Hasher& hasher, FeatureMask<Feature, N> const& mask) {
+	for (std::size_t i = 0; i < N; ++i) {
+		hasher.add(mask.is_selected(static_cast<Feature>(i)));
+	}
+}
+
+/** Copy a tensor in an array of the file cache. */
+template <typename T, std::size_t N> auto to_cached_array(xt::xtensor<T, N> const& tensor) -> utility::CachedArray {
+	auto array = utility::CachedArray{{tensor.shape().begin(), tensor.shape().end()}, {}};
+	array.values.reserve(tensor.size());
+	std::transform(tensor.begin(), tensor.end(), std::back_inserter(array.values), [](T value) {
+		return static_cast<double>(value);
+	});
+	return array;
+}
+
+/** Copy an array of the file cache in a tensor, or nothing if it does not have the same number of dimensions. */
+template <typename T, std::size_t N>
+auto from_cached_array(utility::CachedArray const& array) -> std::optional<xt::xtensor<T, N>> {
+	if (array.shape.size() != N) {
+		return {};
+	}
+	auto shape = std::array<std::size_t, N>{};
+	std::copy(array.shape.begin(), array.shape.end(), shape.begin());
+	auto tensor = xt::xtensor<T, N>::from_shape(shape);
+	std::transform(array.values.begin(), array.values.end(), tensor.begin(), [](double value) {
+		return static_cast<T>(value);
+	});
+	return tensor;
+}
+
+}  // namespace ecole::observation
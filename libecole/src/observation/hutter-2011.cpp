@@ -1,17 +1,23 @@
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <range/v3/numeric/accumulate.hpp>
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/iota.hpp>
 #include <range/v3/view/transform.hpp>
+#include <lpi/lpi.h>
 #include <scip/scip.h>
 #include <xtensor/xadapt.hpp>
 #include <xtensor/xindex_view.hpp>
+#include <xtensor/xoperation.hpp>
 #include <xtensor/xsort.hpp>
 #include <xtensor/xtensor.hpp>
 #include <xtensor/xview.hpp>
@@ -21,7 +27,9 @@
 #include "ecole/scip/model.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
 
-#include "utility/graph.hpp"
+#include "observation/feature-cache.hpp"
+#include "scip/lpi.hpp"
+#include "utility/csr-graph.hpp"
 #include "utility/math.hpp"
 
 namespace ecole::observation {
@@ -30,8 +38,9 @@ namespace {
 
 namespace views = ranges::views;
 
-using Features = Hutter2011Obs::Features;
-using value_type = decltype(Hutter2011Obs::features)::value_type;
+using Features = Hutter2011Features::Features;
+/** Features are computed in SCIP precision, and converted once all extracted. */
+using value_type = SCIP_Real;
 using ConstraintMatrix = ecole::utility::coo_matrix<SCIP_Real>;
 std::size_t constexpr cons_axis = 0;
 std::size_t constexpr var_axis = 1;
@@ -124,30 +133,37 @@ template <typename E, typename QT, std::size_t QN> auto quantiles(E&& data, std:
 	return quants;
 }
 
-/** [12-17,20] Variable graph features. */
-template <typename Tensor> void set_var_degrees(Tensor&& out, ConstraintMatrix const& matrix) {
-	auto const n_var = matrix.shape[var_axis];
-	auto const n_cons = matrix.shape[cons_axis];
-	// Build variable graph.
-	// TODO could be optimized if we know matrix.indices[cons_axis] is sorted (or sort it).
-	auto graph = utility::Graph{n_var};
-	for (std::size_t cons = 0; cons < n_cons; ++cons) {
-		auto const vars =
-			xt::eval(xt::filter(xt::row(matrix.indices, var_axis), xt::equal(xt::row(matrix.indices, cons_axis), cons)));
-		auto const* const var_end = vars.end();
-		for (auto const* var1_iter = vars.begin(); var1_iter < var_end; ++var1_iter) {
-			for (auto const* var2_iter = var1_iter + 1; var2_iter < var_end; ++var2_iter) {
-				if (!graph.are_connected(*var1_iter, *var2_iter)) {
-					graph.add_edge({*var1_iter, *var2_iter});
-				}
-			}
+/** The maximum number of variables on which clustering coefficients are computed. */
+std::size_t constexpr max_clustering_samples = 1000;
+/** The number of pairs of neighbors tested to estimate the clustering coefficient of a variable. */
+std::size_t constexpr max_clustering_wedges = 256;
+
+/**
+ * [12-20] Variable graph features.
+ *
+ * Clustering coefficients are estimated on evenly spaced variables, if there are more than
+ * `max_clustering_samples`, by testing at most `max_clustering_wedges` pairs of neighbors of every variable.
+ * If the variable graph has more edges than the maximum given, all variable graph features are NaN.
+ */
+template <typename Tensor>
+void set_var_graph_features(
+	Tensor&& out,
+	ConstraintMatrix const& matrix,
+	std::size_t max_n_edges,
+	utility::ThreadPool* thread_pool) {
+	auto const graph = utility::column_graph(matrix, max_n_edges, thread_pool);
+	if (!graph.has_value()) {
+		for (auto i = idx(Features::node_degree_mean); i <= idx(Features::edge_density); ++i) {
+			out[i] = std::numeric_limits<value_type>::quiet_NaN();
 		}
+		return;
 	}
 
-	// Compute stats
-	auto get_var_degree = [&graph](auto var) { return graph.neighbors(var).size(); };
-	auto var_degrees = views::ints(0UL, n_var) | views::transform(get_var_degree) | ranges::to<std::vector>();
-
+	auto const n_var = graph->n_nodes();
+	auto var_degrees = std::vector<value_type>(n_var);
+	for (std::size_t var = 0; var < n_var; ++var) {
+		var_degrees[var] = static_cast<value_type>(graph->degree(var));
+	}
 	auto const stats = utility::compute_stats(var_degrees);
 	out[idx(Features::node_degree_mean)] = stats.mean;
 	out[idx(Features::node_degree_max)] = stats.max;
@@ -156,12 +172,30 @@ template <typename Tensor> void set_var_degrees(Tensor&& out, ConstraintMatrix c
 	auto const quants = quantiles(xt::adapt(var_degrees), std::array<double, 2>{0.25, 0.75});
 	out[idx(Features::node_degree_25q)] = quants[0];
 	out[idx(Features::node_degree_75q)] = quants[1];
+
+	auto const n_samples = std::min(n_var, max_clustering_samples);
+	auto clustering_coefs = std::vector<value_type>(n_samples);
+	auto const estimate_clustering = [&](std::size_t sample) {
+		clustering_coefs[sample] =
+			graph->estimate_clustering_coefficient(sample * n_var / n_samples, max_clustering_wedges);
+	};
+	if (thread_pool != nullptr) {
+		thread_pool->parallel_for(n_samples, estimate_clustering);
+	} else {
+		for (std::size_t sample = 0; sample < n_samples; ++sample) {
+			estimate_clustering(sample);
+		}
+	}
+	auto const clustering_stats = utility::compute_stats(clustering_coefs);
+	out[idx(Features::clustering_coef_mean)] = clustering_stats.mean;
+	out[idx(Features::clustering_coef_std)] = clustering_stats.stddev;
+
 	auto const n_edges_complete_graph = static_cast<value_type>(n_var * (n_var - 1)) / 2.;
-	out[idx(Features::edge_density)] = static_cast<value_type>(graph.n_edges()) / n_edges_complete_graph;
+	out[idx(Features::edge_density)] = static_cast<value_type>(graph->n_edges()) / n_edges_complete_graph;
 }
 
 /** Solves the LP relaxation of a model by making a copy, and setting all its variables continuous. */
-auto solve_lp_relaxation(scip::Model const& model) {
+auto solve_lp_relaxation_on_copy(scip::Model const& model) {
 	auto relax_model = model.copy();
 	auto* const relax_scip = relax_model.get_scip_ptr();
 	auto const variables = relax_model.variables();
@@ -204,24 +238,111 @@ auto solve_lp_relaxation(scip::Model const& model) {
 	return std::tuple{std::move(optimal_sol_coefs), optimal_value};
 }
 
+/**
+ * Solves the LP relaxation of a model in an LP interface loaded with its constraint matrix.
+ *
+ * The model is neither copied nor modified.
+ * The constraint matrix has one row per side of the constraints, in the form `A x <= b`, and is loaded in the column
+ * format of the LP interface.
+ * If the LP is not solved to optimality, the solution and objective value are NaN.
+ */
+auto solve_lp_relaxation(
+	scip::Model const& model,
+	ConstraintMatrix const& cons_matrix,
+	xt::xtensor<value_type, 1> const& cons_biases) {
+	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
+	auto const variables = model.variables();
+	auto const n_vars = variables.size();
+	auto const n_rows = cons_matrix.shape[cons_axis];
+	auto const nnz = cons_matrix.nnz();
+
+	// The transformed problem is always minimized
+	auto const transformed = SCIPisTransformed(scip) != FALSE;
+	auto const objsen = (!transformed && (SCIPgetObjsense(scip) == SCIP_OBJSENSE_MAXIMIZE)) ? SCIP_OBJSEN_MAXIMIZE :
+	                                                                                          SCIP_OBJSEN_MINIMIZE;
+	auto const lpi = scip::create_lpi(SCIPgetMessagehdlr(scip), "hutter-2011", objsen);
+	auto const infinity = SCIPlpiInfinity(lpi.get());
+
+	auto objective = std::vector<SCIP_Real>(n_vars);
+	auto lower_bounds = std::vector<SCIP_Real>(n_vars);
+	auto upper_bounds = std::vector<SCIP_Real>(n_vars);
+	for (std::size_t var_idx = 0; var_idx < n_vars; ++var_idx) {
+		auto* const var = variables[var_idx];
+		objective[var_idx] = SCIPvarGetObj(var);
+		auto const lb = SCIPvarGetLbGlobal(var);
+		auto const ub = SCIPvarGetUbGlobal(var);
+		lower_bounds[var_idx] = SCIPisInfinity(scip, -lb) ? -infinity : lb;
+		upper_bounds[var_idx] = SCIPisInfinity(scip, ub) ? infinity : ub;
+	}
+	auto const lhs = std::vector<SCIP_Real>(n_rows, -infinity);
+	auto const rhs = std::vector<SCIP_Real>(cons_biases.begin(), cons_biases.end());
+
+	// Convert the coordinate matrix to the column format with a counting sort on the columns
+	auto col_begins = std::vector<int>(n_vars + 1, 0);
+	for (std::size_t i = 0; i < nnz; ++i) {
+		col_begins[cons_matrix.indices(var_axis, i) + 1]++;
+	}
+	for (std::size_t var_idx = 0; var_idx < n_vars; ++var_idx) {
+		col_begins[var_idx + 1] += col_begins[var_idx];
+	}
+	auto row_indices = std::vector<int>(nnz);
+	auto values = std::vector<SCIP_Real>(nnz);
+	auto next_in_col = col_begins;
+	for (std::size_t i = 0; i < nnz; ++i) {
+		auto const pos = static_cast<std::size_t>(next_in_col[cons_matrix.indices(var_axis, i)]++);
+		row_indices[pos] = static_cast<int>(cons_matrix.indices(cons_axis, i));
+		values[pos] = cons_matrix.values[i];
+	}
+
+	scip::call(
+		SCIPlpiLoadColLP,
+		lpi.get(),
+		objsen,
+		static_cast<int>(n_vars),
+		objective.data(),
+		lower_bounds.data(),
+		upper_bounds.data(),
+		nullptr,
+		static_cast<int>(n_rows),
+		lhs.data(),
+		rhs.data(),
+		nullptr,
+		static_cast<int>(nnz),
+		col_begins.data(),
+		row_indices.data(),
+		values.data());
+	scip::call(SCIPlpiSolveDual, lpi.get());
+
+	auto solution = std::vector<SCIP_Real>(n_vars, std::numeric_limits<SCIP_Real>::quiet_NaN());
+	auto lp_objective = std::numeric_limits<SCIP_Real>::quiet_NaN();
+	if (SCIPlpiIsOptimal(lpi.get()) != FALSE) {
+		scip::call(SCIPlpiGetSol, lpi.get(), &lp_objective, solution.data(), nullptr, nullptr, nullptr);
+		lp_objective = transformed ? SCIPretransformObj(scip, lp_objective) : lp_objective + SCIPgetOrigObjoffset(scip);
+	}
+	return std::tuple{std::move(solution), lp_objective};
+}
+
 /** [21-24] LP based features. */
-template <typename Tensor> void set_lp_based_features(Tensor&& out, scip::Model const& model) {
-	auto const [lp_solution, lp_objective] = solve_lp_relaxation(model);
+template <typename Tensor>
+void set_lp_based_features(
+	Tensor&& out,
+	scip::Model const& model,
+	ConstraintMatrix const& cons_matrix,
+	xt::xtensor<value_type, 1> const& cons_biases,
+	bool copy_model) {
+	auto const [lp_solution, lp_objective] =
+		copy_model ? solve_lp_relaxation_on_copy(model) : solve_lp_relaxation(model, cons_matrix, cons_biases);
 
 	// Compute the integer slack vector
 	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
 	int const nb_integer_variables = SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip);
 
 	if (nb_integer_variables > 0) {
-		// Compute the integer slack vector
+		// Compute the integer slack vector of binary and integer variables, which are the first ones in SCIP
 		auto integer_slack = std::vector<value_type>(static_cast<std::size_t>(nb_integer_variables));
-		std::size_t int_var_idx = 0;
-		for (auto& variable : model.variables()) {
-			if (SCIPvarIsIntegral(variable)) {
-				auto lp_solution_coef = lp_solution[int_var_idx];
-				integer_slack[int_var_idx] = std::abs(lp_solution_coef - std::round(lp_solution_coef));
-				int_var_idx++;
-			}
+		for (std::size_t int_var_idx = 0; int_var_idx < integer_slack.size(); ++int_var_idx) {
+			auto const lp_solution_coef = lp_solution[int_var_idx];
+			integer_slack[int_var_idx] = std::abs(lp_solution_coef - std::round(lp_solution_coef));
 		}
 
 		// Compute statistics of the integer slack vector
@@ -362,32 +483,100 @@ template <typename Tensor> void set_variable_type_features(Tensor&& out, scip::M
 	out[idx(Features::ratio_continuous_vars)] = nb_cont_vars / (nb_int_vars + nb_cont_vars);
 }
 
-auto extract_features(scip::Model& model) {
-	auto observation = xt::xtensor<value_type, 1>::from_shape({Hutter2011Obs::n_features});
-	auto const [cons_matrix, cons_biases] = scip::get_all_constraints(model.get_scip_ptr());
+/** Call a function setting a group of features, timing it with the profiler. */
+template <typename Func> void set_timed(FeatureProfiler& profiler, std::string_view group, Func&& func) {
+	auto const timer = profiler.time(group);
+	func();
+}
 
-	set_problem_size(observation, cons_matrix);
-	set_var_cons_degrees(observation, cons_matrix);
-	set_var_degrees(observation, cons_matrix);
-	set_lp_based_features(observation, model);
-	set_obj_features(observation, model, cons_matrix);
-	set_cons_matrix_features(observation, cons_matrix, cons_biases);
-	set_variable_type_features(observation, model);
+auto extract_features(
+	scip::Model& model,
+	bool copy_model,
+	std::size_t max_var_graph_edges,
+	utility::ThreadPool* thread_pool,
+	FeatureProfiler& profiler) {
+	auto observation = xt::xtensor<value_type, 1>::from_shape({Hutter2011Features::n_features});
+	auto const constraints = [&] {
+		auto const timer = profiler.time("constraint matrix");
+		return scip::get_all_constraints(model.get_scip_ptr());
+	}();
+	// Not structured bindings since they cannot be captured in C++17
+	auto const& cons_matrix = std::get<0>(constraints);
+	auto const& cons_biases = std::get<1>(constraints);
+
+	set_timed(profiler, "problem size", [&] { set_problem_size(observation, cons_matrix); });
+	set_timed(profiler, "variable constraint graph", [&] { set_var_cons_degrees(observation, cons_matrix); });
+	set_timed(profiler, "variable graph", [&] {
+		set_var_graph_features(observation, cons_matrix, max_var_graph_edges, thread_pool);
+	});
+	set_timed(profiler, "LP relaxation solve", [&] {
+		set_lp_based_features(observation, model, cons_matrix, cons_biases, copy_model);
+	});
+	set_timed(profiler, "objective function", [&] { set_obj_features(observation, model, cons_matrix); });
+	set_timed(profiler, "linear constraint matrix", [&] {
+		set_cons_matrix_features(observation, cons_matrix, cons_biases);
+	});
+	set_timed(profiler, "variable types", [&] { set_variable_type_features(observation, model); });
 
 	return observation;
 }
 
+/** Features loaded from the file cache when it holds them for the model, otherwise computed and stored in it. */
+auto extract_features(
+	scip::Model& model,
+	bool copy_model,
+	std::size_t max_var_graph_edges,
+	utility::ThreadPool* thread_pool,
+	FeatureProfiler& profiler,
+	utility::FileCache const* file_cache) {
+	if (file_cache == nullptr) {
+		return extract_features(model, copy_model, max_var_graph_edges, thread_pool, profiler);
+	}
+	auto const key = feature_cache_key(model, "Hutter2011 features").add(copy_model).add(max_var_graph_edges).value();
+	if (auto const arrays = file_cache->load(key); arrays.has_value() && (arrays->size() == 1)) {
+		auto features = from_cached_array<value_type, 1>(arrays->front());
+		if (features.has_value() && (features->size() == Hutter2011Features::n_features)) {
+			return std::move(features).value();
+		}
+	}
+	auto features = extract_features(model, copy_model, max_var_graph_edges, thread_pool, profiler);
+	auto const arrays = std::array{to_cached_array(features)};
+	file_cache->store(key, arrays);
+	return features;
+}
+
 }  // namespace
 
 /*************************************
  *  Observation extracting function  *
  *************************************/
 
-auto Hutter2011::extract(scip::Model& model, bool /* done */) -> std::optional<Hutter2011Obs> {
+template <typename T>
+BasicHutter2011<T>::BasicHutter2011(
+	bool copy_model_,
+	std::size_t n_threads,
+	std::size_t max_var_graph_edges_,
+	std::filesystem::path const& cache_directory) :
+	thread_pool(n_threads > 0 ? std::make_shared<utility::ThreadPool>(n_threads) : nullptr),
+	file_cache(make_file_cache(cache_directory)),
+	max_var_graph_edges(max_var_graph_edges_),
+	copy_model(copy_model_) {}
+
+template <typename T>
+auto BasicHutter2011<T>::extract(scip::Model& model, bool /* done */) -> std::optional<BasicHutter2011Obs<T>> {
 	if (model.stage() >= SCIP_STAGE_SOLVING) {
 		return {};
 	}
-	return {{extract_features(model)}};
+	auto features =
+		extract_features(model, copy_model, max_var_graph_edges, thread_pool.get(), the_profiler, file_cache.get());
+	if constexpr (std::is_same_v<T, value_type>) {
+		return {{{}, std::move(features)}};
+	} else {
+		return {{{}, xt::cast<T>(features)}};
+	}
 }
 
+template class BasicHutter2011<double>;
+template class BasicHutter2011<float>;
+
 }  // namespace ecole::observation
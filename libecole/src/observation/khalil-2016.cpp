@@ -1,15 +1,22 @@
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <nonstd/span.hpp>
 #include <range/v3/numeric/accumulate.hpp>
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/filter.hpp>
 #include <range/v3/view/transform.hpp>
 #include <range/v3/view/zip.hpp>
 #include <xtensor/xfixed.hpp>
+#include <xtensor/xoperation.hpp>
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/khalil-2016.hpp"
@@ -17,6 +24,8 @@
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/row.hpp"
 
+#include "observation/feature-cache.hpp"
+#include "observation/masked-row.hpp"
 #include "utility/math.hpp"
 
 namespace ecole::observation {
@@ -25,8 +34,9 @@ namespace {
 
 namespace views = ranges::views;
 
-using Features = Khalil2016Obs::Features;
-using value_type = decltype(Khalil2016Obs::features)::value_type;
+using Features = Khalil2016Features::Features;
+using FeaturesMask = Khalil2016Features::FeaturesMask;
+using value_type = SCIP_Real;
 
 using ecole::utility::safe_div;
 using ecole::utility::square;
@@ -51,10 +61,30 @@ template <typename Range> auto sum_positive_negative(Range range) noexcept {
 	return std::pair{positive_sum, negative_sum};
 }
 
-/** Convert an enum to its underlying index. */
-template <typename E> constexpr auto idx(E e) {
-	return static_cast<std::underlying_type_t<E>>(e);
-}
+/**
+ * The coefficients of a column split by sign.
+ *
+ * The buffers are reused for all the columns of a block, so that the statistics are computed on contiguous values
+ * without allocating for each column.
+ */
+struct SignedCoefficients {
+	std::vector<SCIP_Real> positive;
+	std::vector<SCIP_Real> negative;
+
+	void split(nonstd::span<SCIP_Real const> const coefficients) {
+		positive.clear();
+		negative.clear();
+		for (auto const coef : coefficients) {
+			if (coef > 0.) {
+				positive.push_back(coef);
+			} else if (coef < 0.) {
+				negative.push_back(coef);
+			}
+		}
+	}
+};
+
+/* Feature extraction functions write in a MaskedRow, and skip the groups of features that are not selected. */
 
 /******************************************
  *  Static features extraction functions  *
@@ -72,10 +102,13 @@ template <typename E> constexpr auto idx(E e) {
  * Value of the coefficient (raw, positive only, negative only).
  */
 template <typename Tensor> void set_objective_function_coefficient(Tensor&& out, SCIP_COL* const col) noexcept {
+	if (!out.any_selected(Features::obj_coef, Features::obj_coef_neg_part)) {
+		return;
+	}
 	auto const obj = SCIPcolGetObj(col);
-	out[idx(Features::obj_coef)] = obj;
-	out[idx(Features::obj_coef_pos_part)] = std::max(obj, 0.);
-	out[idx(Features::obj_coef_neg_part)] = std::min(obj, 0.);
+	set_feature(out, Features::obj_coef, obj);
+	set_feature(out, Features::obj_coef_pos_part, std::max(obj, 0.));
+	set_feature(out, Features::obj_coef_neg_part, std::min(obj, 0.));
 }
 
 /**
@@ -84,7 +117,7 @@ template <typename Tensor> void set_objective_function_coefficient(Tensor&& out,
  * Number of constraints that the variable participates in (with a non-zero coefficient).
  */
 template <typename Tensor> void set_number_constraints(Tensor&& out, SCIP_COL* const col) noexcept {
-	out[idx(Features::n_rows)] = static_cast<value_type>(SCIPcolGetNNonz(col));
+	set_feature(out, Features::n_rows, static_cast<value_type>(SCIPcolGetNNonz(col)));
 }
 
 /**
@@ -97,12 +130,15 @@ template <typename Tensor> void set_number_constraints(Tensor&& out, SCIP_COL* c
  */
 template <typename Tensor>
 void set_static_stats_for_constraint_degree(Tensor&& out, nonstd::span<SCIP_ROW*> const rows) noexcept {
+	if (!out.any_selected(Features::rows_deg_mean, Features::rows_deg_max)) {
+		return;
+	}
 	auto row_get_nnz = [](auto const row) { return static_cast<std::size_t>(SCIProwGetNNonz(row)); };
 	auto const stats = utility::compute_stats(rows | ranges::views::transform(row_get_nnz));
-	out[idx(Features::rows_deg_mean)] = stats.mean;
-	out[idx(Features::rows_deg_stddev)] = stats.stddev;
-	out[idx(Features::rows_deg_min)] = stats.min;
-	out[idx(Features::rows_deg_max)] = stats.max;
+	set_feature(out, Features::rows_deg_mean, stats.mean);
+	set_feature(out, Features::rows_deg_stddev, stats.stddev);
+	set_feature(out, Features::rows_deg_min, stats.min);
+	set_feature(out, Features::rows_deg_max, stats.max);
 }
 
 /**
@@ -112,13 +148,16 @@ void set_static_stats_for_constraint_degree(Tensor&& out, nonstd::span<SCIP_ROW*
  * (count, mean, stdev., min, max).
  */
 template <typename Tensor>
-void set_stats_for_constraint_positive_coefficients(Tensor&& out, nonstd::span<SCIP_Real> const coefficients) noexcept {
-	auto const stats = utility::compute_stats(coefficients | views::filter([](auto x) { return x > 0.; }));
-	out[idx(Features::rows_pos_coefs_count)] = stats.count;
-	out[idx(Features::rows_pos_coefs_mean)] = stats.mean;
-	out[idx(Features::rows_pos_coefs_stddev)] = stats.stddev;
-	out[idx(Features::rows_pos_coefs_min)] = stats.min;
-	out[idx(Features::rows_pos_coefs_max)] = stats.max;
+void set_stats_for_constraint_positive_coefficients(Tensor&& out, SignedCoefficients const& coefficients) noexcept {
+	if (!out.any_selected(Features::rows_pos_coefs_count, Features::rows_pos_coefs_max)) {
+		return;
+	}
+	auto const stats = utility::compute_stats(coefficients.positive);
+	set_feature(out, Features::rows_pos_coefs_count, stats.count);
+	set_feature(out, Features::rows_pos_coefs_mean, stats.mean);
+	set_feature(out, Features::rows_pos_coefs_stddev, stats.stddev);
+	set_feature(out, Features::rows_pos_coefs_min, stats.min);
+	set_feature(out, Features::rows_pos_coefs_max, stats.max);
 }
 
 /**
@@ -128,21 +167,29 @@ void set_stats_for_constraint_positive_coefficients(Tensor&& out, nonstd::span<S
  * (count, mean, stdev., min, max).
  */
 template <typename Tensor>
-void set_stats_for_constraint_negative_coefficients(Tensor&& out, nonstd::span<SCIP_Real> const coefficients) noexcept {
-	auto const stats = utility::compute_stats(coefficients | views::filter([](auto x) { return x < 0.; }));
-	out[idx(Features::rows_neg_coefs_count)] = stats.count;
-	out[idx(Features::rows_neg_coefs_mean)] = stats.mean;
-	out[idx(Features::rows_neg_coefs_stddev)] = stats.stddev;
-	out[idx(Features::rows_neg_coefs_min)] = stats.min;
-	out[idx(Features::rows_neg_coefs_max)] = stats.max;
+void set_stats_for_constraint_negative_coefficients(Tensor&& out, SignedCoefficients const& coefficients) noexcept {
+	if (!out.any_selected(Features::rows_neg_coefs_count, Features::rows_neg_coefs_max)) {
+		return;
+	}
+	auto const stats = utility::compute_stats(coefficients.negative);
+	set_feature(out, Features::rows_neg_coefs_count, stats.count);
+	set_feature(out, Features::rows_neg_coefs_mean, stats.mean);
+	set_feature(out, Features::rows_neg_coefs_stddev, stats.stddev);
+	set_feature(out, Features::rows_neg_coefs_min, stats.min);
+	set_feature(out, Features::rows_neg_coefs_max, stats.max);
 }
 
 /**
  * Extract the static features for a single LP columns.
+ *
+ * The coefficients buffers are overwritten.
  */
-template <typename Tensor> void set_static_features(Tensor&& out, SCIP_COL* const col) {
+template <typename Tensor>
+void set_static_features(Tensor&& out, SCIP_COL* const col, SignedCoefficients& coefficients) {
 	auto const rows = scip::get_rows(col);
-	auto const coefficients = scip::get_vals(col);
+	if (out.any_selected(Features::rows_pos_coefs_count, Features::rows_neg_coefs_max)) {
+		coefficients.split(scip::get_vals(col));
+	}
 
 	set_objective_function_coefficient(out, col);
 	set_number_constraints(out, col);
@@ -151,21 +198,92 @@ template <typename Tensor> void set_static_features(Tensor&& out, SCIP_COL* cons
 	set_stats_for_constraint_negative_coefficients(out, coefficients);
 }
 
+/**
+ * The static features to compute at the root node.
+ *
+ * These are the static features selected, and the root degree statistics needed by the dynamic degree ratios.
+ */
+auto static_features_mask(FeaturesMask const& mask) -> FeaturesMask {
+	auto static_mask = FeaturesMask::none();
+	for (std::size_t i = 0; i < Khalil2016Features::n_static_features; ++i) {
+		if (mask.is_selected(static_cast<Features>(i))) {
+			static_mask.select(static_cast<Features>(i));
+		}
+	}
+	if (mask.is_selected(Features::rows_dynamic_deg_mean_ratio)) {
+		static_mask.select(Features::rows_deg_mean);
+	}
+	if (mask.is_selected(Features::rows_dynamic_deg_min_ratio)) {
+		static_mask.select(Features::rows_deg_min);
+	}
+	if (mask.is_selected(Features::rows_dynamic_deg_max_ratio)) {
+		static_mask.select(Features::rows_deg_max);
+	}
+	return static_mask;
+}
+
 /**
  * Extract the static features for all LP columns in a Model.
+ *
+ * If a thread pool is given, columns are split in one contiguous block per thread.
+ * Every column is only read from SCIP and written in its own row, hence the result does not depend on the number of
+ * threads.
  */
-auto extract_static_features(scip::Model& model) {
+auto extract_static_features(scip::Model& model, utility::ThreadPool* thread_pool, FeaturesMask const& static_mask) {
 	auto const columns = model.lp_columns();
-	xt::xtensor<value_type, 2> static_features{{columns.size(), Khalil2016Obs::n_static_features}, 0.};
+	xt::xtensor<value_type, 2> static_features{{columns.size(), static_mask.n_selected()}, 0.};
 
 	auto const n_columns = columns.size();
-	for (std::size_t i = 0; i < n_columns; ++i) {
-		set_static_features(xt::row(static_features, static_cast<std::ptrdiff_t>(i)), columns[i]);
+	auto set_features_for_columns = [&](std::size_t begin, std::size_t end) {
+		auto coefficients = SignedCoefficients{};
+		for (std::size_t i = begin; i < end; ++i) {
+			auto features = masked_row(xt::row(static_features, static_cast<std::ptrdiff_t>(i)), static_mask);
+			set_static_features(features, columns[i], coefficients);
+		}
+	};
+
+	if ((thread_pool == nullptr) || (thread_pool->n_threads() < 2)) {
+		set_features_for_columns(0, n_columns);
+	} else {
+		auto const n_blocks = thread_pool->n_threads();
+		auto const block_size = (n_columns + n_blocks - 1) / n_blocks;
+		thread_pool->parallel_for(n_blocks, [&](std::size_t block) {
+			set_features_for_columns(std::min(block * block_size, n_columns), std::min((block + 1) * block_size, n_columns));
+		});
 	}
 
 	return static_features;
 }
 
+/**
+ * Static features at the root node, loaded from the file cache when it holds them for the model.
+ *
+ * Features computed are stored in the cache, if given.
+ */
+auto extract_static_features(
+	scip::Model& model,
+	utility::ThreadPool* thread_pool,
+	FeaturesMask const& static_mask,
+	utility::FileCache const* file_cache) {
+	if (file_cache == nullptr) {
+		return extract_static_features(model, thread_pool, static_mask);
+	}
+	auto hasher = feature_cache_key(model, "Khalil2016 static features");
+	add_feature_mask(hasher, static_mask);
+	auto const key = hasher.value();
+	if (auto const arrays = file_cache->load(key); arrays.has_value() && (arrays->size() == 1)) {
+		auto features = from_cached_array<value_type, 2>(arrays->front());
+		if (features.has_value() && (features->shape(0) == model.lp_columns().size()) &&
+				(features->shape(1) == static_mask.n_selected())) {
+			return std::move(features).value();
+		}
+	}
+	auto static_features = extract_static_features(model, thread_pool, static_mask);
+	auto const arrays = std::array{to_cached_array(static_features)};
+	file_cache->store(key, arrays);
+	return static_features;
+}
+
 /*******************************************
  *  Dynamic features extraction functions  *
  *******************************************/
@@ -176,6 +294,81 @@ auto extract_static_features(scip::Model& model) {
  * https://dl.acm.org/doi/10.5555/3015812.3015920
  */
 
+/**
+ * Return if a row in the constraints is active in the LP.
+ */
+auto row_is_active(SCIP* const scip, SCIP_ROW* const row) noexcept -> bool {
+	auto const activity = SCIPgetRowActivity(scip, row);
+	auto const lhs = SCIProwGetLhs(row);
+	auto const rhs = SCIProwGetRhs(row);
+	return SCIProwIsInLP(row) && (SCIPisEQ(scip, activity, rhs) || SCIPisEQ(scip, activity, lhs));
+}
+
+/** The quantities of a row needed for the dynamic features of its columns. */
+struct RowSummary {
+	value_type positive_coefs_sum;
+	value_type negative_coefs_sum;
+	/** NaN if infinite. */
+	value_type lhs;
+	/** NaN if infinite. */
+	value_type rhs;
+	bool is_active;
+};
+
+auto summarize_row(SCIP* const scip, SCIP_ROW* const row) noexcept -> RowSummary {
+	auto finite_or_nan = [scip](value_type side) { return SCIPisInfinity(scip, std::abs(side)) ? std::nan("") : side; };
+	auto const [positive_sum, negative_sum] = sum_positive_negative(scip::get_vals(row));
+	return {
+		positive_sum,
+		negative_sum,
+		finite_or_nan(SCIProwGetLhs(row)),
+		finite_or_nan(SCIProwGetRhs(row)),
+		row_is_active(scip, row),
+	};
+}
+
+/**
+ * Summaries of the LP rows at the current node, shared by all branching candidates.
+ *
+ * Every candidate reads the summaries of its rows, rather than scanning the coefficients of every row and querying SCIP
+ * once per candidate.
+ * Summaries are stored as a structure of arrays indexed by the LP position of the rows.
+ * The weights for the stats for active constraints coefficients are only computed for active rows, and left as NaN
+ * otherwise.
+ */
+class RowSummaries {
+public:
+	static inline std::size_t constexpr n_weights = 4;
+
+	/** Empty summaries, when no feature selected needs them. */
+	RowSummaries() = default;
+	/** Summarize the LP rows, computing the weights only if requested. */
+	RowSummaries(scip::Model& model, bool compute_weights);
+
+	/** Summary of a row, computed on the fly for rows not in the LP. */
+	[[nodiscard]] auto get(SCIP* const scip, SCIP_ROW* const row) const noexcept -> RowSummary {
+		if (auto const pos = SCIProwGetLPPos(row); pos >= 0) {
+			auto const i = static_cast<std::size_t>(pos);
+			return {positive_coefs_sum[i], negative_coefs_sum[i], lhs[i], rhs[i], is_active[i] != 0};
+		}
+		return summarize_row(scip, row);
+	}
+
+	/** Weight of an active row in the LP. */
+	[[nodiscard]] auto weight(SCIP_ROW* const row, std::size_t weight_idx) const noexcept -> value_type {
+		assert(SCIProwGetLPPos(row) >= 0);
+		return weights[weight_idx][static_cast<std::size_t>(SCIProwGetLPPos(row))];
+	}
+
+private:
+	std::vector<value_type> positive_coefs_sum;
+	std::vector<value_type> negative_coefs_sum;
+	std::vector<value_type> lhs;
+	std::vector<value_type> rhs;
+	std::vector<unsigned char> is_active;
+	std::array<std::vector<value_type>, n_weights> weights;
+};
+
 /**
  * Slack, ceil distances, and Pseudocosts.
  *
@@ -190,6 +383,9 @@ auto extract_static_features(scip::Model& model) {
  */
 template <typename Tensor>
 void set_slack_ceil_and_pseudocosts(Tensor&& out, SCIP* const scip, SCIP_VAR* const var, SCIP_COL* const col) noexcept {
+	if (!out.any_selected(Features::slack, Features::pseudocost_product)) {
+		return;
+	}
 	auto const solval = SCIPcolGetPrimsol(col);
 	auto const floor_distance = SCIPfeasFrac(scip, solval);
 	auto const ceil_distance = 1. - floor_distance;
@@ -199,13 +395,13 @@ void set_slack_ceil_and_pseudocosts(Tensor&& out, SCIP* const scip, SCIP_VAR* co
 	auto const wpu_approx = std::max(weighted_pseudocost_up, epsilon);
 	auto const wpd_approx = std::max(weighted_pseudocost_down, epsilon);
 	auto const weighted_pseudocost_ratio = safe_div(std::min(wpu_approx, wpd_approx), std::max(wpu_approx, wpd_approx));
-	out[idx(Features::slack)] = std::min(floor_distance, ceil_distance);
-	out[idx(Features::ceil_dist)] = ceil_distance;
-	out[idx(Features::pseudocost_up)] = weighted_pseudocost_up;
-	out[idx(Features::pseudocost_down)] = weighted_pseudocost_down;
-	out[idx(Features::pseudocost_ratio)] = weighted_pseudocost_ratio;
-	out[idx(Features::pseudocost_sum)] = weighted_pseudocost_up + weighted_pseudocost_down;
-	out[idx(Features::pseudocost_product)] = weighted_pseudocost_up * weighted_pseudocost_down;
+	set_feature(out, Features::slack, std::min(floor_distance, ceil_distance));
+	set_feature(out, Features::ceil_dist, ceil_distance);
+	set_feature(out, Features::pseudocost_up, weighted_pseudocost_up);
+	set_feature(out, Features::pseudocost_down, weighted_pseudocost_down);
+	set_feature(out, Features::pseudocost_ratio, weighted_pseudocost_ratio);
+	set_feature(out, Features::pseudocost_sum, weighted_pseudocost_up + weighted_pseudocost_down);
+	set_feature(out, Features::pseudocost_product, weighted_pseudocost_up * weighted_pseudocost_down);
 }
 
 /**
@@ -217,14 +413,17 @@ void set_slack_ceil_and_pseudocosts(Tensor&& out, SCIP* const scip, SCIP_VAR* co
  * N.B. replaced by left, right infeasibility.
  */
 template <typename Tensor> void set_infeasibility_statistics(Tensor&& out, SCIP_VAR* const var) noexcept {
+	if (!out.any_selected(Features::n_cutoff_up, Features::n_cutoff_down_ratio)) {
+		return;
+	}
 	auto const n_infeasibles_up = SCIPvarGetCutoffSum(var, SCIP_BRANCHDIR_UPWARDS);
 	auto const n_infeasibles_down = SCIPvarGetCutoffSum(var, SCIP_BRANCHDIR_DOWNWARDS);
 	auto const n_branchings_up = static_cast<value_type>(SCIPvarGetNBranchings(var, SCIP_BRANCHDIR_UPWARDS));
 	auto const n_branchings_down = static_cast<value_type>(SCIPvarGetNBranchings(var, SCIP_BRANCHDIR_DOWNWARDS));
-	out[idx(Features::n_cutoff_up)] = n_infeasibles_up;
-	out[idx(Features::n_cutoff_down)] = n_infeasibles_down;
-	out[idx(Features::n_cutoff_up_ratio)] = safe_div(n_infeasibles_up, n_branchings_up);
-	out[idx(Features::n_cutoff_down_ratio)] = safe_div(n_infeasibles_down, n_branchings_down);
+	set_feature(out, Features::n_cutoff_up, n_infeasibles_up);
+	set_feature(out, Features::n_cutoff_down, n_infeasibles_down);
+	set_feature(out, Features::n_cutoff_up_ratio, safe_div(n_infeasibles_up, n_branchings_up));
+	set_feature(out, Features::n_cutoff_down_ratio, safe_div(n_infeasibles_down, n_branchings_down));
 }
 
 /**
@@ -235,23 +434,34 @@ template <typename Tensor> void set_infeasibility_statistics(Tensor&& out, SCIP_
  * The ratios of the static mean, maximum and minimum to their dynamic counterparts are also
  * features.
  *
- * The precomputed static features given as input parameters are wrapped in their strong type to
- * avoid passing the wrong ones.
+ * The root degree statistics are read from the precomputed static features, when the ratios are selected.
  */
-template <typename Tensor>
-void set_dynamic_stats_for_constraint_degree(Tensor&& out, nonstd::span<SCIP_ROW*> const rows) noexcept {
+template <typename Tensor, typename TensorIn>
+void set_dynamic_stats_for_constraint_degree(
+	Tensor&& out,
+	TensorIn const& static_features,
+	nonstd::span<SCIP_ROW*> const rows) noexcept {
+	if (!out.any_selected(Features::rows_dynamic_deg_mean, Features::rows_dynamic_deg_max_ratio)) {
+		return;
+	}
 	auto row_get_lp_nnz = [](auto const row) { return static_cast<std::size_t>(SCIProwGetNLPNonz(row)); };
 	auto const stats = utility::compute_stats(rows | views::transform(row_get_lp_nnz));
-	auto const root_deg_mean = out[idx(Features::rows_deg_mean)];
-	auto const root_deg_min = out[idx(Features::rows_deg_min)];
-	auto const root_deg_max = out[idx(Features::rows_deg_max)];
-	out[idx(Features::rows_dynamic_deg_mean)] = stats.mean;
-	out[idx(Features::rows_dynamic_deg_stddev)] = stats.stddev;
-	out[idx(Features::rows_dynamic_deg_min)] = stats.min;
-	out[idx(Features::rows_dynamic_deg_max)] = stats.max;
-	out[idx(Features::rows_dynamic_deg_mean_ratio)] = safe_div(stats.mean, root_deg_mean + stats.mean);
-	out[idx(Features::rows_dynamic_deg_min_ratio)] = safe_div(stats.min, root_deg_min + stats.min);
-	out[idx(Features::rows_dynamic_deg_max_ratio)] = safe_div(stats.max, root_deg_max + stats.max);
+	set_feature(out, Features::rows_dynamic_deg_mean, stats.mean);
+	set_feature(out, Features::rows_dynamic_deg_stddev, stats.stddev);
+	set_feature(out, Features::rows_dynamic_deg_min, stats.min);
+	set_feature(out, Features::rows_dynamic_deg_max, stats.max);
+	if (out.is_selected(Features::rows_dynamic_deg_mean_ratio)) {
+		auto const root_deg_mean = get_feature(static_features, Features::rows_deg_mean);
+		set_feature(out, Features::rows_dynamic_deg_mean_ratio, safe_div(stats.mean, root_deg_mean + stats.mean));
+	}
+	if (out.is_selected(Features::rows_dynamic_deg_min_ratio)) {
+		auto const root_deg_min = get_feature(static_features, Features::rows_deg_min);
+		set_feature(out, Features::rows_dynamic_deg_min_ratio, safe_div(stats.min, root_deg_min + stats.min));
+	}
+	if (out.is_selected(Features::rows_dynamic_deg_max_ratio)) {
+		auto const root_deg_max = get_feature(static_features, Features::rows_deg_max);
+		set_feature(out, Features::rows_dynamic_deg_max_ratio, safe_div(stats.max, root_deg_max + stats.max));
+	}
 }
 
 /**
@@ -264,7 +474,11 @@ void set_min_max_for_ratios_constraint_coeffs_rhs(
 	Tensor&& out,
 	SCIP* const scip,
 	nonstd::span<SCIP_ROW*> const rows,
-	nonstd::span<SCIP_Real> const coefficients) noexcept {
+	nonstd::span<SCIP_Real> const coefficients,
+	RowSummaries const& row_summaries) noexcept {
+	if (!out.any_selected(Features::coef_pos_rhs_ratio_min, Features::coef_neg_rhs_ratio_max)) {
+		return;
+	}
 
 	value_type positive_rhs_ratio_max = -1.;
 	value_type positive_rhs_ratio_min = 1.;
@@ -283,19 +497,20 @@ void set_min_max_for_ratios_constraint_coeffs_rhs(
 	};
 
 	for (auto const [row, coef] : views::zip(rows, coefficients)) {
-		if (auto const rhs = SCIProwGetRhs(row); !SCIPisInfinity(scip, std::abs(rhs))) {
-			rhs_ratio_updates(coef, rhs);
+		auto const summary = row_summaries.get(scip, row);
+		if (!std::isnan(summary.rhs)) {
+			rhs_ratio_updates(coef, summary.rhs);
 		}
-		if (auto const lhs = SCIProwGetLhs(row); !SCIPisInfinity(scip, std::abs(lhs))) {
+		if (!std::isnan(summary.lhs)) {
 			// lhs constraints are multiply by -1 to be considered as rhs constraints.
-			rhs_ratio_updates(-coef, -lhs);
+			rhs_ratio_updates(-coef, -summary.lhs);
 		}
 	}
 
-	out[idx(Features::coef_pos_rhs_ratio_min)] = positive_rhs_ratio_min;
-	out[idx(Features::coef_pos_rhs_ratio_max)] = positive_rhs_ratio_max;
-	out[idx(Features::coef_neg_rhs_ratio_min)] = negative_rhs_ratio_min;
-	out[idx(Features::coef_neg_rhs_ratio_max)] = negative_rhs_ratio_max;
+	set_feature(out, Features::coef_pos_rhs_ratio_min, positive_rhs_ratio_min);
+	set_feature(out, Features::coef_pos_rhs_ratio_max, positive_rhs_ratio_max);
+	set_feature(out, Features::coef_neg_rhs_ratio_min, negative_rhs_ratio_min);
+	set_feature(out, Features::coef_neg_rhs_ratio_max, negative_rhs_ratio_max);
 }
 
 /**
@@ -309,8 +524,13 @@ void set_min_max_for_ratios_constraint_coeffs_rhs(
 template <typename Tensor>
 void set_min_max_for_one_to_all_coefficient_ratios(
 	Tensor&& out,
+	SCIP* const scip,
 	nonstd::span<SCIP_ROW*> const rows,
-	nonstd::span<SCIP_Real> const coefficients) noexcept {
+	nonstd::span<SCIP_Real> const coefficients,
+	RowSummaries const& row_summaries) noexcept {
+	if (!out.any_selected(Features::pos_coef_pos_coef_ratio_min, Features::neg_coef_neg_coef_ratio_max)) {
+		return;
+	}
 
 	value_type positive_positive_ratio_max = 0;
 	value_type positive_positive_ratio_min = 1;
@@ -322,7 +542,9 @@ void set_min_max_for_one_to_all_coefficient_ratios(
 	value_type negative_negative_ratio_min = 1;
 
 	for (auto const [row, coef] : views::zip(rows, coefficients)) {
-		auto const [positive_coeficients_sum, negative_coeficients_sum] = sum_positive_negative(scip::get_vals(row));
+		auto const summary = row_summaries.get(scip, row);
+		auto const positive_coeficients_sum = summary.positive_coefs_sum;
+		auto const negative_coeficients_sum = summary.negative_coefs_sum;
 		if (coef > 0) {
 			auto const positive_ratio = coef / positive_coeficients_sum;
 			auto const negative_ratio = coef / (coef - negative_coeficients_sum);
@@ -340,42 +562,34 @@ void set_min_max_for_one_to_all_coefficient_ratios(
 		}
 	}
 
-	out[idx(Features::pos_coef_pos_coef_ratio_min)] = positive_positive_ratio_min;
-	out[idx(Features::pos_coef_pos_coef_ratio_max)] = positive_positive_ratio_max;
-	out[idx(Features::pos_coef_neg_coef_ratio_min)] = positive_negative_ratio_min;
-	out[idx(Features::pos_coef_neg_coef_ratio_max)] = positive_negative_ratio_max;
-	out[idx(Features::neg_coef_pos_coef_ratio_min)] = negative_positive_ratio_min;
-	out[idx(Features::neg_coef_pos_coef_ratio_max)] = negative_positive_ratio_max;
-	out[idx(Features::neg_coef_neg_coef_ratio_min)] = negative_negative_ratio_min;
-	out[idx(Features::neg_coef_neg_coef_ratio_max)] = negative_negative_ratio_max;
+	set_feature(out, Features::pos_coef_pos_coef_ratio_min, positive_positive_ratio_min);
+	set_feature(out, Features::pos_coef_pos_coef_ratio_max, positive_positive_ratio_max);
+	set_feature(out, Features::pos_coef_neg_coef_ratio_min, positive_negative_ratio_min);
+	set_feature(out, Features::pos_coef_neg_coef_ratio_max, positive_negative_ratio_max);
+	set_feature(out, Features::neg_coef_pos_coef_ratio_min, negative_positive_ratio_min);
+	set_feature(out, Features::neg_coef_pos_coef_ratio_max, negative_positive_ratio_max);
+	set_feature(out, Features::neg_coef_neg_coef_ratio_min, negative_negative_ratio_min);
+	set_feature(out, Features::neg_coef_neg_coef_ratio_max, negative_negative_ratio_max);
 }
 
 /**
- * Return if a row in the constraints is active in the LP.
- */
-auto row_is_active(SCIP* const scip, SCIP_ROW* const row) noexcept -> bool {
-	auto const activity = SCIPgetRowActivity(scip, row);
-	auto const lhs = SCIProwGetLhs(row);
-	auto const rhs = SCIProwGetRhs(row);
-	return SCIProwIsInLP(row) && (SCIPisEQ(scip, activity, rhs) || SCIPisEQ(scip, activity, lhs));
-}
-
-/**
- * Compute the weight necessary for the stats for active constraints coefficients.
+ * Compute the row summaries, including the weight necessary for the stats for active constraints coefficients.
  *
- * The four coefficients are
+ * The four weights are
  *   - unit weight,
  *   - inverse of the sum of the coefficients of all variables in constraint,
  *   - inverse of the sum of the coefficients of only candidate variables in constraint
  *   - dual cost of the constraint.
  * They are computed for every row that is active, as defined by @ref row_is_active.
- * Weights for non activate rows are left as NaN and ununsed.
- * This is equivalent to an unsafe/unchecked masked tensor.
  */
-auto stats_for_active_constraint_coefficients_weights(scip::Model& model) {
+RowSummaries::RowSummaries(scip::Model& model, bool compute_weights) {
 	auto* const scip = model.get_scip_ptr();
 	auto const lp_rows = model.lp_rows();
-	auto const branch_candidates = model.pseudo_branch_cands() | ranges::to<std::set>();
+	// Branching candidates are only needed for the weights
+	auto branch_candidates = std::set<SCIP_VAR*>{};
+	if (compute_weights) {
+		branch_candidates = model.pseudo_branch_cands() | ranges::to<std::set>();
+	}
 
 	/** Check if a column is a branching candidate. */
 	auto is_candidate = [&branch_candidates](auto* col) { return branch_candidates.count(SCIPcolGetVar(col)) > 0; };
@@ -399,25 +613,35 @@ auto stats_for_active_constraint_coefficients_weights(scip::Model& model) {
 	/** Compute the inverse of a number or 1 if the number is zero. */
 	auto safe_inv = [](auto const x) { return x != 0. ? 1. / x : 1.; };
 
-	xt::xtensor<value_type, 2> weights{{lp_rows.size(), 4}, std::nan("")};
-	auto* weights_iter = weights.begin();
+	auto const n_rows = lp_rows.size();
+	positive_coefs_sum.resize(n_rows);
+	negative_coefs_sum.resize(n_rows);
+	lhs.resize(n_rows);
+	rhs.resize(n_rows);
+	is_active.resize(n_rows);
+	if (compute_weights) {
+		for (auto& w : weights) {
+			w.assign(n_rows, std::nan(""));
+		}
+	}
 
-	for (auto* const row : lp_rows) {
-		if (row_is_active(scip, row)) {
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		auto* const row = lp_rows[i];
+		assert(SCIProwGetLPPos(row) == static_cast<int>(i));
+		auto const summary = summarize_row(scip, row);
+		positive_coefs_sum[i] = summary.positive_coefs_sum;
+		negative_coefs_sum[i] = summary.negative_coefs_sum;
+		lhs[i] = summary.lhs;
+		rhs[i] = summary.rhs;
+		is_active[i] = static_cast<unsigned char>(summary.is_active);
+		if (compute_weights && summary.is_active) {
 			auto const row_cols_vals = scip::get_vals(row);
-			*(weights_iter++) = 1.;
-			*(weights_iter++) = safe_inv(sum_abs(row_cols_vals));
-			*(weights_iter++) = safe_inv(sum_abs_if_candidate(scip::get_cols(row), row_cols_vals));
-			*(weights_iter++) = std::abs(SCIProwGetDualsol(row));
-		} else {
-			weights_iter += 4;
+			weights[0][i] = 1.;
+			weights[1][i] = safe_inv(sum_abs(row_cols_vals));
+			weights[2][i] = safe_inv(sum_abs_if_candidate(scip::get_cols(row), row_cols_vals));
+			weights[3][i] = std::abs(SCIProwGetDualsol(row));
 		}
 	}
-
-	// Make sure we iterated over as many element as there are in the tensor
-	assert(weights_iter == weights.cend());
-
-	return weights;
 }
 
 /**
@@ -437,9 +661,12 @@ void set_stats_for_active_constraint_coefficients(
 	SCIP* const scip,
 	nonstd::span<SCIP_ROW*> const rows,
 	nonstd::span<SCIP_Real> const coefficients,
-	xt::xtensor<value_type, 2> const& lp_rows_weights) noexcept {
+	RowSummaries const& row_summaries) noexcept {
+	if (!out.any_selected(Features::active_coef_weight1_count, Features::active_coef_weight4_max)) {
+		return;
+	}
 
-	auto weights_stats = std::array<utility::StatsFeatures<value_type>, 4>{};
+	auto weights_stats = std::array<utility::StatsFeatures<value_type>, RowSummaries::n_weights>{};
 	for (auto& stats : weights_stats) {
 		stats.min = std::numeric_limits<decltype(stats.min)>::max();
 		stats.max = std::numeric_limits<decltype(stats.max)>::min();
@@ -447,15 +674,11 @@ void set_stats_for_active_constraint_coefficients(
 
 	std::size_t n_active_rows = 0UL;
 	for (auto const [row, coef] : views::zip(rows, coefficients)) {
-		auto const row_lp_idx = SCIProwGetLPPos(row);
-
-		if (row_is_active(scip, row)) {
+		if (row_summaries.get(scip, row).is_active) {
 			n_active_rows++;
 
-			assert(row_lp_idx >= 0);
-
 			for (std::size_t weight_idx = 0; weight_idx < weights_stats.size(); ++weight_idx) {
-				auto const weight = lp_rows_weights(row_lp_idx, weight_idx);
+				auto const weight = row_summaries.weight(row, weight_idx);
 				assert(!std::isnan(weight));  // If NaN likely hit a maked value
 				auto const weighted_abs_coef = weight * std::abs(coef);
 
@@ -474,10 +697,9 @@ void set_stats_for_active_constraint_coefficients(
 		}
 
 		for (auto const [row, coef] : views::zip(rows, coefficients)) {
-			auto const row_lp_idx = SCIProwGetLPPos(row);
-			if (row_is_active(scip, row)) {
+			if (row_summaries.get(scip, row).is_active) {
 				for (std::size_t weight_idx = 0; weight_idx < weights_stats.size(); ++weight_idx) {
-					auto const weight = lp_rows_weights(row_lp_idx, weight_idx);
+					auto const weight = row_summaries.weight(row, weight_idx);
 					assert(!std::isnan(weight));  // If NaN likely hit a maked value
 					auto const weighted_abs_coef = weight * std::abs(coef);
 
@@ -497,54 +719,82 @@ void set_stats_for_active_constraint_coefficients(
 		}
 	}
 
-	out[idx(Features::active_coef_weight1_count)] = weights_stats[0].count;
-	out[idx(Features::active_coef_weight1_sum)] = weights_stats[0].sum;
-	out[idx(Features::active_coef_weight1_mean)] = weights_stats[0].mean;
-	out[idx(Features::active_coef_weight1_stddev)] = weights_stats[0].stddev;
-	out[idx(Features::active_coef_weight1_min)] = weights_stats[0].min;
-	out[idx(Features::active_coef_weight1_max)] = weights_stats[0].max;
-	out[idx(Features::active_coef_weight2_count)] = weights_stats[1].count;
-	out[idx(Features::active_coef_weight2_sum)] = weights_stats[1].sum;
-	out[idx(Features::active_coef_weight2_mean)] = weights_stats[1].mean;
-	out[idx(Features::active_coef_weight2_stddev)] = weights_stats[1].stddev;
-	out[idx(Features::active_coef_weight2_min)] = weights_stats[1].min;
-	out[idx(Features::active_coef_weight2_max)] = weights_stats[1].max;
-	out[idx(Features::active_coef_weight3_count)] = weights_stats[2].count;
-	out[idx(Features::active_coef_weight3_sum)] = weights_stats[2].sum;
-	out[idx(Features::active_coef_weight3_mean)] = weights_stats[2].mean;
-	out[idx(Features::active_coef_weight3_stddev)] = weights_stats[2].stddev;
-	out[idx(Features::active_coef_weight3_min)] = weights_stats[2].min;
-	out[idx(Features::active_coef_weight3_max)] = weights_stats[2].max;
-	out[idx(Features::active_coef_weight4_count)] = weights_stats[3].count;
-	out[idx(Features::active_coef_weight4_sum)] = weights_stats[3].sum;
-	out[idx(Features::active_coef_weight4_mean)] = weights_stats[3].mean;
-	out[idx(Features::active_coef_weight4_stddev)] = weights_stats[3].stddev;
-	out[idx(Features::active_coef_weight4_min)] = weights_stats[3].min;
-	out[idx(Features::active_coef_weight4_max)] = weights_stats[3].max;
+	set_feature(out, Features::active_coef_weight1_count, weights_stats[0].count);
+	set_feature(out, Features::active_coef_weight1_sum, weights_stats[0].sum);
+	set_feature(out, Features::active_coef_weight1_mean, weights_stats[0].mean);
+	set_feature(out, Features::active_coef_weight1_stddev, weights_stats[0].stddev);
+	set_feature(out, Features::active_coef_weight1_min, weights_stats[0].min);
+	set_feature(out, Features::active_coef_weight1_max, weights_stats[0].max);
+	set_feature(out, Features::active_coef_weight2_count, weights_stats[1].count);
+	set_feature(out, Features::active_coef_weight2_sum, weights_stats[1].sum);
+	set_feature(out, Features::active_coef_weight2_mean, weights_stats[1].mean);
+	set_feature(out, Features::active_coef_weight2_stddev, weights_stats[1].stddev);
+	set_feature(out, Features::active_coef_weight2_min, weights_stats[1].min);
+	set_feature(out, Features::active_coef_weight2_max, weights_stats[1].max);
+	set_feature(out, Features::active_coef_weight3_count, weights_stats[2].count);
+	set_feature(out, Features::active_coef_weight3_sum, weights_stats[2].sum);
+	set_feature(out, Features::active_coef_weight3_mean, weights_stats[2].mean);
+	set_feature(out, Features::active_coef_weight3_stddev, weights_stats[2].stddev);
+	set_feature(out, Features::active_coef_weight3_min, weights_stats[2].min);
+	set_feature(out, Features::active_coef_weight3_max, weights_stats[2].max);
+	set_feature(out, Features::active_coef_weight4_count, weights_stats[3].count);
+	set_feature(out, Features::active_coef_weight4_sum, weights_stats[3].sum);
+	set_feature(out, Features::active_coef_weight4_mean, weights_stats[3].mean);
+	set_feature(out, Features::active_coef_weight4_stddev, weights_stats[3].stddev);
+	set_feature(out, Features::active_coef_weight4_min, weights_stats[3].min);
+	set_feature(out, Features::active_coef_weight4_max, weights_stats[3].max);
 }
 
+/** The groups of dynamic features, by the name under which they are profiled. */
+std::array<std::string_view, 6> constexpr dynamic_groups = {
+	"slack, ceil distances and pseudocosts",
+	"infeasibility statistics",
+	"constraint degrees",
+	"ratios of constraint coefficients to rhs",
+	"one-to-all coefficient ratios",
+	"active constraint coefficients",
+};
+
+/** Select all groups of dynamic features in @ref set_dynamic_features. */
+std::size_t constexpr all_dynamic_groups = dynamic_groups.size();
+
 /**
  * Extract the dynamic features for a single branching candidate variable.
  *
- * The precomputed static features given as input parameters are wrapped in their strong type to
- * avoid passing the wrong ones.
+ * The precomputed static features of the variable are needed for the ratios of constraint degrees.
+ * A single group of features, as indexed in `dynamic_groups`, can be extracted with the last parameter.
  */
-template <typename Tensor>
+template <typename Tensor, typename TensorIn>
 void set_dynamic_features(
 	Tensor&& out,
+	TensorIn const& static_features,
 	SCIP* const scip,
 	SCIP_VAR* const var,
-	xt::xtensor<value_type, 2> const& lp_rows_weights) {
+	RowSummaries const& row_summaries,
+	std::size_t group = all_dynamic_groups) {
 	auto* const col = SCIPvarGetCol(var);
 	auto const rows = scip::get_rows(col);
 	auto const coefficients = scip::get_vals(col);
+	auto const in_group = [group](std::size_t g) { return (group == all_dynamic_groups) || (group == g); };
 
-	set_slack_ceil_and_pseudocosts(out, scip, var, col);
-	set_infeasibility_statistics(out, var);
-	set_dynamic_stats_for_constraint_degree(out, rows);
-	set_min_max_for_ratios_constraint_coeffs_rhs(out, scip, rows, coefficients);
-	set_min_max_for_one_to_all_coefficient_ratios(out, rows, coefficients);
-	set_stats_for_active_constraint_coefficients(out, scip, rows, coefficients, lp_rows_weights);
+	if (in_group(0)) {
+		set_slack_ceil_and_pseudocosts(out, scip, var, col);
+	}
+	if (in_group(1)) {
+		set_infeasibility_statistics(out, var);
+	}
+	if (in_group(2)) {
+		set_dynamic_stats_for_constraint_degree(out, static_features, rows);
+	}
+	if (in_group(3)) {
+		set_min_max_for_ratios_constraint_coeffs_rhs(out, scip, rows, coefficients, row_summaries);
+	}
+	if (in_group(4)) {
+		set_min_max_for_one_to_all_coefficient_ratios(out, scip, rows, coefficients, row_summaries);
+	}
+	if (in_group(5)) {
+		set_stats_for_active_constraint_coefficients(out, scip, rows, coefficients, row_summaries);
+	}
 }
 
 /**
@@ -552,32 +802,90 @@ void set_dynamic_features(
  *
  * The static features have been computed for all LP columns and stored in the order of `LPcolumns`.
  * We need to find the one associated with the given variable.
+ * Root degree statistics may have been computed only for the dynamic ratios, and are not written unless selected.
  */
 template <typename TensorOut, typename TensorIn>
 void set_precomputed_static_features(TensorOut&& var_features, TensorIn const& var_static_features) {
-	using namespace xt::placeholders;
-	xt::view(var_features, xt::range(_, Khalil2016Obs::n_static_features)) = var_static_features;
+	for (std::size_t i = 0; i < Khalil2016Features::n_static_features; ++i) {
+		auto const feature = static_cast<Features>(i);
+		if (var_static_features.is_selected(feature)) {
+			set_feature(var_features, feature, get_feature(var_static_features, feature));
+		}
+	}
 }
 
 /******************************
  *  Main extraction function  *
  ******************************/
 
-auto extract_all_features(scip::Model& model, int pseudo, xt::xtensor<value_type, 2> const& static_features) {
+/**
+ * Write the features of all variables in a matrix with one row per variable, non candidates are set to NaN.
+ *
+ * Only the selected features are computed, and written in their compacted column.
+ * When profiling, each group of features is computed for all candidates before the next one, so that every group is
+ * timed once rather than once per candidate.
+ */
+template <typename Tensor>
+void set_all_features(
+	Tensor&& observation,
+	scip::Model& model,
+	int pseudo,
+	xt::xtensor<value_type, 2> const& static_features,
+	FeaturesMask const& mask,
+	FeatureProfiler& profiler) {
+	using T = typename std::decay_t<Tensor>::value_type;
 	auto const branch_cands = pseudo==1 ? model.pseudo_branch_cands() : (pseudo==0 ? model.lp_branch_cands() : model.variables());
-	auto observation = xt::xtensor<value_type, 2>{{model.variables().size(), Khalil2016Obs::n_features}, std::nan("")};
+	observation.fill(std::numeric_limits<T>::quiet_NaN());
 
 	auto* const scip = model.get_scip_ptr();
-	auto const lp_rows_weights = stats_for_active_constraint_coefficients_weights(model);
+	auto const static_mask = static_features_mask(mask);
+	// Row summaries are only needed for the features on the coefficients of the rows, which are the last ones
+	auto const row_summaries = [&] {
+		auto const timer = profiler.time("row summaries");
+		return mask.any_selected(Features::coef_pos_rhs_ratio_min, Features::active_coef_weight4_max) ?
+			RowSummaries{model, mask.any_selected(Features::active_coef_weight1_count, Features::active_coef_weight4_max)} :
+			RowSummaries{};
+	}();
+
+	auto const for_each_candidate = [&](auto&& func) {
+		for (auto* var : branch_cands) {
+			auto const var_idx = SCIPvarGetProbindex(var);
+			auto var_features = masked_row(xt::row(observation, var_idx), mask);
+			auto const var_static_features = masked_row(xt::row(static_features, var_idx), static_mask);
+			func(var_features, var_static_features, var);
+		}
+	};
 
-	for (auto* var : branch_cands) {
-		auto const var_idx = SCIPvarGetProbindex(var);
-		auto var_features = xt::row(observation, var_idx);
-		auto var_static_features = xt::row(static_features, var_idx);
-		set_precomputed_static_features(var_features, var_static_features);
-		set_dynamic_features(var_features, scip, var, lp_rows_weights);
+	if (!profiler.enabled()) {
+		for_each_candidate([&](auto& var_features, auto const& var_static_features, SCIP_VAR* var) {
+			set_precomputed_static_features(var_features, var_static_features);
+			set_dynamic_features(var_features, var_static_features, scip, var, row_summaries);
+		});
+		return;
+	}
+	{
+		auto const timer = profiler.time("copy of static features");
+		for_each_candidate([&](auto& var_features, auto const& var_static_features, SCIP_VAR* /*var*/) {
+			set_precomputed_static_features(var_features, var_static_features);
+		});
 	}
+	for (std::size_t group = 0; group < dynamic_groups.size(); ++group) {
+		auto const timer = profiler.time(dynamic_groups[group]);
+		for_each_candidate([&](auto& var_features, auto const& var_static_features, SCIP_VAR* var) {
+			set_dynamic_features(var_features, var_static_features, scip, var, row_summaries, group);
+		});
+	}
+}
 
+template <typename T>
+auto extract_all_features(
+	scip::Model& model,
+	int pseudo,
+	xt::xtensor<value_type, 2> const& static_features,
+	FeaturesMask const& mask,
+	FeatureProfiler& profiler) {
+	auto observation = xt::xtensor<T, 2>::from_shape({model.variables().size(), mask.n_selected()});
+	set_all_features(observation, model, pseudo, static_features, mask, profiler);
 	return observation;
 }
 
@@ -592,20 +900,54 @@ auto is_on_root_node(scip::Model& model) -> bool {
  *  Observation extracting function  *
  *************************************/
 
-Khalil2016::Khalil2016(int candidates_) noexcept : candidates(candidates_) {}
-
-void Khalil2016::before_reset(scip::Model& /* model */) {
+template <typename T>
+BasicKhalil2016<T>::BasicKhalil2016(
+	int candidates_,
+	std::size_t n_threads,
+	Khalil2016Features::FeaturesMask mask_,
+	std::filesystem::path const& cache_directory) :
+	candidates(candidates_),
+	mask(mask_),
+	thread_pool(n_threads > 0 ? std::make_shared<utility::ThreadPool>(n_threads) : nullptr),
+	file_cache(make_file_cache(cache_directory)) {}
+
+template <typename T> void BasicKhalil2016<T>::before_reset(scip::Model& /* model */) {
 	static_features = decltype(static_features){};
 }
 
-auto Khalil2016::extract(scip::Model& model, bool /* done */) -> std::optional<Khalil2016Obs> {
+template <typename T>
+auto BasicKhalil2016<T>::extract(scip::Model& model, bool /* done */) -> std::optional<BasicKhalil2016Obs<T>> {
 	if (model.stage() == SCIP_STAGE_SOLVING) {
 		if (is_on_root_node(model)) {
-			static_features = extract_static_features(model);
+			auto const timer = the_profiler.time("static features");
+			static_features =
+				extract_static_features(model, thread_pool.get(), static_features_mask(mask), file_cache.get());
 		}
-		return {{extract_all_features(model, candidates, static_features)}};
+		return {{{}, extract_all_features<T>(model, candidates, static_features, mask, the_profiler)}};
 	}
 	return {};
 }
 
+template <typename T>
+auto BasicKhalil2016<T>::extract_into(scip::Model& model, bool /* done */, BatchMatrix<T>& batch) -> bool {
+	if (batch.n_cols() != mask.n_selected()) {
+		throw std::invalid_argument{"Expected " + std::to_string(mask.n_selected()) + " features per row."};
+	}
+	if (model.stage() == SCIP_STAGE_SOLVING) {
+		if (is_on_root_node(model)) {
+			auto const timer = the_profiler.time("static features");
+			static_features =
+				extract_static_features(model, thread_pool.get(), static_features_mask(mask), file_cache.get());
+		}
+		auto observation = batch.append(model.variables().size());
+		set_all_features(observation, model, candidates, static_features, mask, the_profiler);
+		return true;
+	}
+	batch.append(0);
+	return false;
+}
+
+template class BasicKhalil2016<double>;
+template class BasicKhalil2016<float>;
+
 }  // namespace ecole::observation
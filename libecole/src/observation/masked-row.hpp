@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <scip/def.h>
+
+#include "ecole/observation/feature-mask.hpp"
+
+namespace ecole::observation {
+
+/**
+ * A row of an observation in which only the selected features are written.
+ *
+ * Feature extraction functions write features through @ref set_feature, using the complete layout of the features,
+ * and the mask maps them to their compacted column.
+ */
+template <typename Tensor, typename Mask> struct MaskedRow {
+	Tensor row;
+	Mask const& mask;
+
+	[[nodiscard]] auto is_selected(typename Mask::feature_type feature) const noexcept -> bool {
+		return mask.is_selected(feature);
+	}
+	[[nodiscard]] auto any_selected(typename Mask::feature_type first, typename Mask::feature_type last) const noexcept
+		-> bool {
+		return mask.any_selected(first, last);
+	}
+};
+
+template <typename Tensor, typename Mask> auto masked_row(Tensor&& row, Mask const& mask) -> MaskedRow<Tensor, Mask> {
+	return {std::forward<Tensor>(row), mask};
+}
+
+/** Write a feature if it is selected, converting it to the value type of the observation. */
+template <typename Tensor, typename Mask>
+void set_feature(MaskedRow<Tensor, Mask>& out, typename Mask::feature_type feature, SCIP_Real value) {
+	if (auto const col = out.mask.column(feature); col != Mask::npos) {
+		out.row[col] = static_cast<typename std::decay_t<Tensor>::value_type>(value);
+	}
+}
+
+/** Read a selected feature previously written, in SCIP precision. */
+template <typename Tensor, typename Mask>
+auto get_feature(MaskedRow<Tensor, Mask> const& in, typename Mask::feature_type feature) -> SCIP_Real {
+	assert(in.mask.is_selected(feature));
+	return static_cast<SCIP_Real>(in.row[in.mask.column(feature)]);
+}
+
+}  // namespace ecole::observation
@@ -1,11 +1,14 @@
 #include <type_traits>
 
+#include <array>
 #include <cmath>
 #include <cstddef>
+#include <vector>
 #include <scip/scip.h>
 #include <scip/struct_lp.h>
 #include <xtensor/xadapt.hpp>
 #include <xtensor/xnorm.hpp>
+#include <xtensor/xoperation.hpp>
 #include <xtensor/xview.hpp>
 
 #include "ecole/exception.hpp"
@@ -14,6 +17,9 @@
 #include "ecole/scip/model.hpp"
 #include "ecole/utility/unreachable.hpp"
 
+#include "observation/feature-cache.hpp"
+#include "observation/masked-row.hpp"
+
 namespace ecole::observation {
 
 namespace {
@@ -22,12 +28,12 @@ namespace {
  *  Common helpers   *
  *********************/
 
-using xmatrix = decltype(MilpBipartiteObs::variable_features);
-using value_type = xmatrix::value_type;
-using coo_xmatrix = utility::coo_matrix<value_type>;
+using value_type = SCIP_Real;
+template <typename T> using xmatrix = xt::xtensor<T, 2>;
 
-using VariableFeatures = MilpBipartiteObs::VariableFeatures;
-using ConstraintFeatures = MilpBipartiteObs::ConstraintFeatures;
+using VariableFeatures = MilpBipartiteFeatures::VariableFeatures;
+using ConstraintFeatures = MilpBipartiteFeatures::ConstraintFeatures;
+using VariableFeaturesMask = MilpBipartiteFeatures::VariableFeaturesMask;
 
 /******************************************
  *  Variable extraction functions         *
@@ -51,10 +57,7 @@ SCIP_Real obj_l2_norm(SCIP* const scip, scip::Model& model) noexcept {
 	return norm > 0 ? norm : 1.;
 }
 
-/** Convert an enum to its underlying index. */
-template <typename E> constexpr auto idx(E e) {
-	return static_cast<std::underlying_type_t<E>>(e);
-}
+/* Feature extraction functions write in a MaskedRow, which skips the features that are not selected. */
 
 template <typename Features>
 void set_static_features_for_var(
@@ -64,52 +67,53 @@ void set_static_features_for_var(
 	std::optional<value_type> obj_norm = {}) {
 	double const objsense = (SCIPgetObjsense(scip) == SCIP_OBJSENSE_MINIMIZE) ? 1. : -1.;
 
-	out[idx(VariableFeatures::objective)] = objsense * SCIPvarGetObj(var);
-	if (obj_norm.has_value()) {
-		out[idx(VariableFeatures::objective)] /= obj_norm.value();
-	}
+	auto const objective = objsense * SCIPvarGetObj(var);
+	set_feature(out, VariableFeatures::objective, obj_norm.has_value() ? objective / obj_norm.value() : objective);
 	// One-hot enconding of variable type
-	out[idx(VariableFeatures::is_type_binary)] = 0.;
-	out[idx(VariableFeatures::is_type_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_implicit_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_continuous)] = 0.;
-	switch (SCIPvarGetType(var)) {
-	case SCIP_VARTYPE_BINARY:
-		out[idx(VariableFeatures::is_type_binary)] = 1.;
-		break;
-	case SCIP_VARTYPE_INTEGER:
-		out[idx(VariableFeatures::is_type_integer)] = 1.;
-		break;
-	case SCIP_VARTYPE_IMPLINT:
-		out[idx(VariableFeatures::is_type_implicit_integer)] = 1.;
-		break;
-	case SCIP_VARTYPE_CONTINUOUS:
-		out[idx(VariableFeatures::is_type_continuous)] = 1.;
-		break;
-	default:
-		utility::unreachable();
+	if (out.any_selected(VariableFeatures::is_type_binary, VariableFeatures::is_type_continuous)) {
+		set_feature(out, VariableFeatures::is_type_binary, 0.);
+		set_feature(out, VariableFeatures::is_type_integer, 0.);
+		set_feature(out, VariableFeatures::is_type_implicit_integer, 0.);
+		set_feature(out, VariableFeatures::is_type_continuous, 0.);
+		switch (SCIPvarGetType(var)) {
+		case SCIP_VARTYPE_BINARY:
+			set_feature(out, VariableFeatures::is_type_binary, 1.);
+			break;
+		case SCIP_VARTYPE_INTEGER:
+			set_feature(out, VariableFeatures::is_type_integer, 1.);
+			break;
+		case SCIP_VARTYPE_IMPLINT:
+			set_feature(out, VariableFeatures::is_type_implicit_integer, 1.);
+			break;
+		case SCIP_VARTYPE_CONTINUOUS:
+			set_feature(out, VariableFeatures::is_type_continuous, 1.);
+			break;
+		default:
+			utility::unreachable();
+		}
 	}
 
 	auto const lower_bound = SCIPvarGetLbLocal(var);
 	if (SCIPisInfinity(scip, std::abs(lower_bound))) {
-		out[idx(VariableFeatures::has_lower_bound)] = 0.;
-		out[idx(VariableFeatures::lower_bound)] = 0.;
+		set_feature(out, VariableFeatures::has_lower_bound, 0.);
+		set_feature(out, VariableFeatures::lower_bound, 0.);
 	} else {
-		out[idx(VariableFeatures::has_lower_bound)] = 1.;
-		out[idx(VariableFeatures::lower_bound)] = lower_bound;
+		set_feature(out, VariableFeatures::has_lower_bound, 1.);
+		set_feature(out, VariableFeatures::lower_bound, lower_bound);
 	}
 
 	auto const upper_bound = SCIPvarGetUbLocal(var);
 	if (SCIPisInfinity(scip, std::abs(upper_bound))) {
-		out[idx(VariableFeatures::has_upper_bound)] = 0.;
-		out[idx(VariableFeatures::upper_bound)] = 0.;
+		set_feature(out, VariableFeatures::has_upper_bound, 0.);
+		set_feature(out, VariableFeatures::upper_bound, 0.);
 	} else {
-		out[idx(VariableFeatures::has_upper_bound)] = 1.;
-		out[idx(VariableFeatures::upper_bound)] = upper_bound;
+		set_feature(out, VariableFeatures::has_upper_bound, 1.);
+		set_feature(out, VariableFeatures::upper_bound, upper_bound);
 	}
 }
 
-void set_features_for_all_vars(xmatrix& out, scip::Model& model, bool normalize) {
+template <typename T>
+void set_features_for_all_vars(xmatrix<T>& out, scip::Model& model, bool normalize, VariableFeaturesMask const& mask) {
 	auto* const scip = model.get_scip_ptr();
 
 	// Contant reused in every iterations
@@ -118,7 +122,7 @@ void set_features_for_all_vars(xmatrix& out, scip::Model& model, bool normalize)
 	auto const variables = model.variables();
 	auto const n_vars = variables.size();
 	for (std::size_t var_idx = 0; var_idx < n_vars; ++var_idx) {
-		auto features = xt::row(out, static_cast<std::ptrdiff_t>(var_idx));
+		auto features = masked_row(xt::row(out, static_cast<std::ptrdiff_t>(var_idx)), mask);
 		set_static_features_for_var(features, scip, variables[var_idx], obj_norm);
 	}
 }
@@ -128,26 +132,130 @@ template <typename T> auto vec_to_col(xt::xtensor<T, 1>&& t) -> xt::xtensor<T, 2
 	return xt::xtensor<T, 2>{std::move(t.storage()), {t.size(), 1}, {1, 0}};
 }
 
+/** Convert a tensor in SCIP precision to the value type of the observation, without copy if they are the same. */
+template <typename T, std::size_t N> auto convert(xt::xtensor<value_type, N>&& t) -> xt::xtensor<T, N> {
+	if constexpr (std::is_same_v<T, value_type>) {
+		return std::move(t);
+	} else {
+		return xt::cast<T>(t);
+	}
+}
+
+template <typename T>
+auto extract_observation(
+	scip::Model& model,
+	bool normalize,
+	VariableFeaturesMask const& variable_mask,
+	utility::ThreadPool* thread_pool,
+	FeatureProfiler& profiler) -> BasicMilpBipartiteObs<T> {
+	auto [edge_features, constraint_features] = [&] {
+		auto const timer = profiler.time("constraint matrix");
+		return scip::get_all_constraints(model.get_scip_ptr(), normalize, false, thread_pool);
+	}();
+
+	auto const n_vars = model.variables().size();
+	auto variable_features = xmatrix<T>::from_shape({n_vars, variable_mask.n_selected()});
+	{
+		auto const timer = profiler.time("variable features");
+		set_features_for_all_vars(variable_features, model, normalize, variable_mask);
+	}
+
+	return {
+		{},
+		std::move(variable_features),
+		vec_to_col(convert<T>(std::move(constraint_features))),
+		{convert<T>(std::move(edge_features.values)), std::move(edge_features.indices), edge_features.shape},
+	};
+}
+
+/****************************
+ *  File caching functions  *
+ ****************************/
+
+/* The shape of the edges is not stored since it is given by the number of constraints and variables. */
+
+template <typename T>
+auto to_cached_arrays(BasicMilpBipartiteObs<T> const& obs) -> std::array<utility::CachedArray, 4> {
+	return {
+		to_cached_array(obs.variable_features),
+		to_cached_array(obs.constraint_features),
+		to_cached_array(obs.edge_features.values),
+		to_cached_array(obs.edge_features.indices),
+	};
+}
+
+template <typename T>
+auto from_cached_arrays(
+	std::vector<utility::CachedArray> const& arrays,
+	scip::Model const& model,
+	VariableFeaturesMask const& variable_mask) -> std::optional<BasicMilpBipartiteObs<T>> {
+	if (arrays.size() != 4) {
+		return {};
+	}
+	auto variable_features = from_cached_array<T, 2>(arrays[0]);
+	auto constraint_features = from_cached_array<T, 2>(arrays[1]);
+	auto edge_values = from_cached_array<T, 1>(arrays[2]);
+	auto edge_indices = from_cached_array<std::size_t, 2>(arrays[3]);
+	if (!variable_features.has_value() || !constraint_features.has_value() || !edge_values.has_value() ||
+			!edge_indices.has_value()) {
+		return {};
+	}
+	auto const n_vars = model.variables().size();
+	auto const n_rows = constraint_features->shape(0);
+	if ((variable_features->shape(0) != n_vars) || (variable_features->shape(1) != variable_mask.n_selected()) ||
+			(constraint_features->shape(1) != 1) || (edge_indices->shape(0) != 2) ||
+			(edge_indices->shape(1) != edge_values->size())) {
+		return {};
+	}
+	return BasicMilpBipartiteObs<T>{
+		{},
+		std::move(variable_features).value(),
+		std::move(constraint_features).value(),
+		{std::move(edge_values).value(), std::move(edge_indices).value(), {n_rows, n_vars}},
+	};
+}
+
 }  // namespace
 
 /*************************************
  *  Observation extracting function  *
  *************************************/
 
-auto MilpBipartite::extract(scip::Model& model, bool /* done */) const -> std::optional<MilpBipartiteObs> {
-	if (model.stage() < SCIP_STAGE_SOLVING) {
-		auto [edge_features, constraint_features] = scip::get_all_constraints(model.get_scip_ptr(), normalize);
-
-		auto variable_features = xmatrix::from_shape({model.variables().size(), MilpBipartiteObs::n_variable_features});
-		set_features_for_all_vars(variable_features, model, normalize);
+template <typename T>
+BasicMilpBipartite<T>::BasicMilpBipartite(
+	bool normalize_,
+	std::size_t n_threads,
+	MilpBipartiteFeatures::VariableFeaturesMask variable_mask_,
+	std::filesystem::path const& cache_directory) :
+	variable_mask{variable_mask_},
+	thread_pool(n_threads > 0 ? std::make_shared<utility::ThreadPool>(n_threads) : nullptr),
+	file_cache(make_file_cache(cache_directory)),
+	normalize{normalize_} {}
 
-		return MilpBipartiteObs{
-			std::move(variable_features),
-			vec_to_col(std::move(constraint_features)),
-			std::move(edge_features),
-		};
+template <typename T>
+auto BasicMilpBipartite<T>::extract(scip::Model& model, bool /* done */) const
+	-> std::optional<BasicMilpBipartiteObs<T>> {
+	if (model.stage() >= SCIP_STAGE_SOLVING) {
+		return {};
+	}
+	if (file_cache == nullptr) {
+		return extract_observation<T>(model, normalize, variable_mask, thread_pool.get(), the_profiler);
 	}
-	return {};
+	auto hasher = feature_cache_key(model, "MilpBipartite").add(sizeof(T)).add(normalize);
+	add_feature_mask(hasher, variable_mask);
+	auto const key = hasher.value();
+	if (auto const arrays = file_cache->load(key); arrays.has_value()) {
+		if (auto obs = from_cached_arrays<T>(arrays.value(), model, variable_mask); obs.has_value()) {
+			return obs;
+		}
+	}
+	auto obs = extract_observation<T>(model, normalize, variable_mask, thread_pool.get(), the_profiler);
+	auto const arrays = to_cached_arrays(obs);
+	file_cache->store(key, arrays);
+	return obs;
 }
 
+template class BasicMilpBipartite<double>;
+template class BasicMilpBipartite<float>;
+
 }  // namespace ecole::observation
@@ -1,9 +1,17 @@
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
+#include <objscip/objeventhdlr.h>
 #include <scip/scip.h>
 #include <scip/struct_lp.h>
 #include <xtensor/xview.hpp>
@@ -11,8 +19,11 @@
 #include "ecole/observation/node-bipartite.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/row.hpp"
+#include "ecole/scip/utils.hpp"
 #include "ecole/utility/unreachable.hpp"
 
+#include "observation/masked-row.hpp"
+
 namespace ecole::observation {
 
 namespace {
@@ -21,11 +32,13 @@ namespace {
  *  Common helpers   *
  *********************/
 
-using xmatrix = decltype(NodeBipartiteObs::variable_features);
-using value_type = xmatrix::value_type;
+using value_type = SCIP_Real;
+template <typename T> using xmatrix = xt::xtensor<T, 2>;
 
-using VariableFeatures = NodeBipartiteObs::VariableFeatures;
-using RowFeatures = NodeBipartiteObs::RowFeatures;
+using VariableFeatures = NodeBipartiteFeatures::VariableFeatures;
+using RowFeatures = NodeBipartiteFeatures::RowFeatures;
+using VariableFeaturesMask = NodeBipartiteFeatures::VariableFeaturesMask;
+using RowFeaturesMask = NodeBipartiteFeatures::RowFeaturesMask;
 
 value_type constexpr cste = 5.;
 value_type constexpr nan = std::numeric_limits<value_type>::quiet_NaN();
@@ -93,79 +106,117 @@ std::optional<SCIP_Real> feas_frac(SCIP* const scip, SCIP_VAR* const var) noexce
 	return SCIPfeasFrac(scip, SCIPvarGetLPSol(var));
 }
 
-/** Convert an enum to its underlying index. */
-template <typename E> constexpr auto idx(E e) {
-	return static_cast<std::underlying_type_t<E>>(e);
-}
+/* Feature extraction functions write in a MaskedRow, and skip the groups of features that are not selected. */
 
 template <typename Features>
 void set_static_features_for_var(Features&& out, SCIP_VAR* const var, value_type obj_norm) {
-	out[idx(VariableFeatures::objective)] = SCIPvarGetObj(var) / obj_norm;
+	if (!out.any_selected(VariableFeatures::objective, VariableFeatures::is_type_continuous)) {
+		return;
+	}
+	set_feature(out, VariableFeatures::objective, SCIPvarGetObj(var) / obj_norm);
 	// On-hot enconding of variable type
-	out[idx(VariableFeatures::is_type_binary)] = 0.;
-	out[idx(VariableFeatures::is_type_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_implicit_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_continuous)] = 0.;
+	set_feature(out, VariableFeatures::is_type_binary, 0.);
+	set_feature(out, VariableFeatures::is_type_integer, 0.);
+	set_feature(out, VariableFeatures::is_type_implicit_integer, 0.);
+	set_feature(out, VariableFeatures::is_type_continuous, 0.);
 	switch (SCIPvarGetType(var)) {
 	case SCIP_VARTYPE_BINARY:
-		out[idx(VariableFeatures::is_type_binary)] = 1.;
+		set_feature(out, VariableFeatures::is_type_binary, 1.);
 		break;
 	case SCIP_VARTYPE_INTEGER:
-		out[idx(VariableFeatures::is_type_integer)] = 1.;
+		set_feature(out, VariableFeatures::is_type_integer, 1.);
 		break;
 	case SCIP_VARTYPE_IMPLINT:
-		out[idx(VariableFeatures::is_type_implicit_integer)] = 1.;
+		set_feature(out, VariableFeatures::is_type_implicit_integer, 1.);
 		break;
 	case SCIP_VARTYPE_CONTINUOUS:
-		out[idx(VariableFeatures::is_type_continuous)] = 1.;
+		set_feature(out, VariableFeatures::is_type_continuous, 1.);
 		break;
 	default:
 		utility::unreachable();
 	}
 }
 
+template <typename Features> void set_bound_features_for_var(Features&& out, SCIP* const scip, SCIP_COL* const col) {
+	if (!out.any_selected(VariableFeatures::has_lower_bound, VariableFeatures::has_upper_bound)) {
+		return;
+	}
+	set_feature(out, VariableFeatures::has_lower_bound, static_cast<value_type>(lower_bound(scip, col).has_value()));
+	set_feature(out, VariableFeatures::has_upper_bound, static_cast<value_type>(upper_bound(scip, col).has_value()));
+}
+
 template <typename Features>
-void set_dynamic_features_for_var(
+void set_incumbent_features_for_var(Features&& out, SCIP* const scip, SCIP_VAR* const var) {
+	if (out.is_selected(VariableFeatures::incumbent_value)) {
+		set_feature(out, VariableFeatures::incumbent_value, best_sol_val(scip, var).value_or(nan));
+	}
+	if (out.is_selected(VariableFeatures::average_incumbent_value)) {
+		set_feature(out, VariableFeatures::average_incumbent_value, avg_sol(scip, var).value_or(nan));
+	}
+}
+
+/** Features depending on the LP solution. */
+template <typename Features>
+void set_lp_features_for_var(
 	Features&& out,
 	SCIP* const scip,
 	SCIP_VAR* const var,
 	SCIP_COL* const col,
 	value_type obj_norm,
 	value_type n_lps) {
-	out[idx(VariableFeatures::has_lower_bound)] = static_cast<value_type>(lower_bound(scip, col).has_value());
-	out[idx(VariableFeatures::has_upper_bound)] = static_cast<value_type>(upper_bound(scip, col).has_value());
-	out[idx(VariableFeatures::normed_reduced_cost)] = SCIPgetVarRedcost(scip, var) / obj_norm;
-	out[idx(VariableFeatures::solution_value)] = SCIPvarGetLPSol(var);
-	out[idx(VariableFeatures::solution_frac)] = feas_frac(scip, var).value_or(0.);
-	out[idx(VariableFeatures::is_solution_at_lower_bound)] = static_cast<value_type>(is_prim_sol_at_lb(scip, col));
-	out[idx(VariableFeatures::is_solution_at_upper_bound)] = static_cast<value_type>(is_prim_sol_at_ub(scip, col));
-	out[idx(VariableFeatures::scaled_age)] = static_cast<value_type>(SCIPcolGetAge(col)) / (n_lps + cste);
-	out[idx(VariableFeatures::incumbent_value)] = best_sol_val(scip, var).value_or(nan);
-	out[idx(VariableFeatures::average_incumbent_value)] = avg_sol(scip, var).value_or(nan);
+	if (!out.any_selected(VariableFeatures::normed_reduced_cost, VariableFeatures::scaled_age) &&
+			!out.any_selected(VariableFeatures::is_basis_lower, VariableFeatures::is_basis_zero)) {
+		return;
+	}
+	set_feature(out, VariableFeatures::normed_reduced_cost, SCIPgetVarRedcost(scip, var) / obj_norm);
+	set_feature(out, VariableFeatures::solution_value, SCIPvarGetLPSol(var));
+	set_feature(out, VariableFeatures::solution_frac, feas_frac(scip, var).value_or(0.));
+	set_feature(out, VariableFeatures::is_solution_at_lower_bound, static_cast<value_type>(is_prim_sol_at_lb(scip, col)));
+	set_feature(out, VariableFeatures::is_solution_at_upper_bound, static_cast<value_type>(is_prim_sol_at_ub(scip, col)));
+	set_feature(out, VariableFeatures::scaled_age, static_cast<value_type>(SCIPcolGetAge(col)) / (n_lps + cste));
 	// On-hot encoding
-	out[idx(VariableFeatures::is_basis_lower)] = 0.;
-	out[idx(VariableFeatures::is_basis_basic)] = 0.;
-	out[idx(VariableFeatures::is_basis_upper)] = 0.;
-	out[idx(VariableFeatures::is_basis_zero)] = 0.;
+	set_feature(out, VariableFeatures::is_basis_lower, 0.);
+	set_feature(out, VariableFeatures::is_basis_basic, 0.);
+	set_feature(out, VariableFeatures::is_basis_upper, 0.);
+	set_feature(out, VariableFeatures::is_basis_zero, 0.);
 	switch (SCIPcolGetBasisStatus(col)) {
 	case SCIP_BASESTAT_LOWER:
-		out[idx(VariableFeatures::is_basis_lower)] = 1.;
+		set_feature(out, VariableFeatures::is_basis_lower, 1.);
 		break;
 	case SCIP_BASESTAT_BASIC:
-		out[idx(VariableFeatures::is_basis_basic)] = 1.;
+		set_feature(out, VariableFeatures::is_basis_basic, 1.);
 		break;
 	case SCIP_BASESTAT_UPPER:
-		out[idx(VariableFeatures::is_basis_upper)] = 1.;
+		set_feature(out, VariableFeatures::is_basis_upper, 1.);
 		break;
 	case SCIP_BASESTAT_ZERO:
-		out[idx(VariableFeatures::is_basis_zero)] = 1.;
+		set_feature(out, VariableFeatures::is_basis_zero, 1.);
 		break;
 	default:
 		utility::unreachable();
 	}
 }
 
-void set_features_for_all_vars(xmatrix& out, scip::Model& model, bool const update_static) {
+template <typename Features>
+void set_dynamic_features_for_var(
+	Features&& out,
+	SCIP* const scip,
+	SCIP_VAR* const var,
+	SCIP_COL* const col,
+	value_type obj_norm,
+	value_type n_lps) {
+	set_bound_features_for_var(out, scip, col);
+	set_incumbent_features_for_var(out, scip, var);
+	set_lp_features_for_var(out, scip, var, col, obj_norm, n_lps);
+}
+
+template <typename Matrix>
+void set_features_for_all_vars(
+	Matrix&& out,
+	scip::Model& model,
+	bool const update_static,
+	VariableFeaturesMask const& mask,
+	FeatureProfiler& profiler) {
 	auto* const scip = model.get_scip_ptr();
 
 	// Contant reused in every iterations
@@ -174,14 +225,18 @@ void set_features_for_all_vars(xmatrix& out, scip::Model& model, bool const upda
 
 	auto const variables = model.variables();
 	auto const n_vars = variables.size();
+	if (update_static) {
+		auto const timer = profiler.time("static variable features");
+		for (std::size_t var_idx = 0; var_idx < n_vars; ++var_idx) {
+			auto features = masked_row(xt::row(out, static_cast<std::ptrdiff_t>(var_idx)), mask);
+			set_static_features_for_var(features, variables[var_idx], obj_norm);
+		}
+	}
+	auto const timer = profiler.time("dynamic variable features");
 	for (std::size_t var_idx = 0; var_idx < n_vars; ++var_idx) {
 		auto* const var = variables[var_idx];
-		auto* const col = SCIPvarGetCol(var);
-		auto features = xt::row(out, static_cast<std::ptrdiff_t>(var_idx));
-		if (update_static) {
-			set_static_features_for_var(features, var, obj_norm);
-		}
-		set_dynamic_features_for_var(features, scip, var, col, obj_norm, n_lps);
+		auto features = masked_row(xt::row(out, static_cast<std::ptrdiff_t>(var_idx)), mask);
+		set_dynamic_features_for_var(features, scip, var, SCIPvarGetCol(var), obj_norm, n_lps);
 	}
 }
 
@@ -219,14 +274,20 @@ std::size_t n_ineq_rows(scip::Model& model) {
 
 template <typename Features>
 void set_static_features_for_lhs_row(Features&& out, SCIP* const scip, SCIP_ROW* const row, value_type row_norm) {
-	out[idx(RowFeatures::bias)] = -1. * scip::get_unshifted_lhs(scip, row).value() / row_norm;
-	out[idx(RowFeatures::objective_cosine_similarity)] = -1 * obj_cos_sim(scip, row);
+	if (!out.any_selected(RowFeatures::bias, RowFeatures::objective_cosine_similarity)) {
+		return;
+	}
+	set_feature(out, RowFeatures::bias, -1. * scip::get_unshifted_lhs(scip, row).value() / row_norm);
+	set_feature(out, RowFeatures::objective_cosine_similarity, -1 * obj_cos_sim(scip, row));
 }
 
 template <typename Features>
 void set_static_features_for_rhs_row(Features&& out, SCIP* const scip, SCIP_ROW* const row, value_type row_norm) {
-	out[idx(RowFeatures::bias)] = scip::get_unshifted_rhs(scip, row).value() / row_norm;
-	out[idx(RowFeatures::objective_cosine_similarity)] = obj_cos_sim(scip, row);
+	if (!out.any_selected(RowFeatures::bias, RowFeatures::objective_cosine_similarity)) {
+		return;
+	}
+	set_feature(out, RowFeatures::bias, scip::get_unshifted_rhs(scip, row).value() / row_norm);
+	set_feature(out, RowFeatures::objective_cosine_similarity, obj_cos_sim(scip, row));
 }
 
 template <typename Features>
@@ -237,9 +298,12 @@ void set_dynamic_features_for_lhs_row(
 	value_type row_norm,
 	value_type obj_norm,
 	value_type n_lps) {
-	out[idx(RowFeatures::is_tight)] = static_cast<value_type>(scip::is_at_lhs(scip, row));
-	out[idx(RowFeatures::dual_solution_value)] = -1. * SCIProwGetDualsol(row) / (row_norm * obj_norm);
-	out[idx(RowFeatures::scaled_age)] = static_cast<value_type>(SCIProwGetAge(row)) / (n_lps + cste);
+	if (!out.any_selected(RowFeatures::is_tight, RowFeatures::scaled_age)) {
+		return;
+	}
+	set_feature(out, RowFeatures::is_tight, static_cast<value_type>(scip::is_at_lhs(scip, row)));
+	set_feature(out, RowFeatures::dual_solution_value, -1. * SCIProwGetDualsol(row) / (row_norm * obj_norm));
+	set_feature(out, RowFeatures::scaled_age, static_cast<value_type>(SCIProwGetAge(row)) / (n_lps + cste));
 }
 
 template <typename Features>
@@ -250,12 +314,22 @@ void set_dynamic_features_for_rhs_row(
 	value_type row_norm,
 	value_type obj_norm,
 	value_type n_lps) {
-	out[idx(RowFeatures::is_tight)] = static_cast<value_type>(scip::is_at_rhs(scip, row));
-	out[idx(RowFeatures::dual_solution_value)] = SCIProwGetDualsol(row) / (row_norm * obj_norm);
-	out[idx(RowFeatures::scaled_age)] = static_cast<value_type>(SCIProwGetAge(row)) / (n_lps + cste);
+	if (!out.any_selected(RowFeatures::is_tight, RowFeatures::scaled_age)) {
+		return;
+	}
+	set_feature(out, RowFeatures::is_tight, static_cast<value_type>(scip::is_at_rhs(scip, row)));
+	set_feature(out, RowFeatures::dual_solution_value, SCIProwGetDualsol(row) / (row_norm * obj_norm));
+	set_feature(out, RowFeatures::scaled_age, static_cast<value_type>(SCIProwGetAge(row)) / (n_lps + cste));
 }
 
-auto set_features_for_all_rows(xmatrix& out, scip::Model& model, bool const update_static) {
+template <typename Matrix>
+void set_features_for_all_rows(
+	Matrix&& out,
+	scip::Model& model,
+	bool const update_static,
+	RowFeaturesMask const& mask,
+	FeatureProfiler& profiler) {
+	auto const timer = profiler.time("row features");
 	auto* const scip = model.get_scip_ptr();
 
 	auto const n_lps = static_cast<value_type>(SCIPgetNLPs(scip));
@@ -267,7 +341,7 @@ auto set_features_for_all_rows(xmatrix& out, scip::Model& model, bool const upda
 
 		// Rows are counted once per rhs and once per lhs
 		if (scip::get_unshifted_lhs(scip, row).has_value()) {
-			auto features = xt::row(out, static_cast<std::ptrdiff_t>(feat_row_idx));
+			auto features = masked_row(xt::row(out, static_cast<std::ptrdiff_t>(feat_row_idx)), mask);
 			if (update_static) {
 				set_static_features_for_lhs_row(features, scip, row, row_norm);
 			}
@@ -275,7 +349,7 @@ auto set_features_for_all_rows(xmatrix& out, scip::Model& model, bool const upda
 			feat_row_idx++;
 		}
 		if (scip::get_unshifted_rhs(scip, row).has_value()) {
-			auto features = xt::row(out, static_cast<std::ptrdiff_t>(feat_row_idx));
+			auto features = masked_row(xt::row(out, static_cast<std::ptrdiff_t>(feat_row_idx)), mask);
 			if (update_static) {
 				set_static_features_for_rhs_row(features, scip, row, row_norm);
 			}
@@ -310,45 +384,146 @@ auto matrix_nnz(scip::Model& model) {
 	return nnz;
 }
 
-utility::coo_matrix<value_type> extract_edge_features(scip::Model& model) {
+/**
+ * Call a function on every non zero element of a LP row, once per side of the row.
+ *
+ * The row index is the one of the first side of the row, and is advanced past its last side.
+ */
+template <typename Func> void for_each_row_edge(SCIP* const scip, SCIP_ROW* const row, std::size_t& i, Func&& func) {
+	auto const row_norm = static_cast<value_type>(row_l2_norm(row));
+	auto* const row_cols = SCIProwGetCols(row);
+	auto const* const row_vals = SCIProwGetVals(row);
+	auto const row_nnz = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
+	if (scip::get_unshifted_lhs(scip, row).has_value()) {
+		for (std::size_t k = 0; k < row_nnz; ++k) {
+			func(i, static_cast<std::size_t>(SCIPcolGetVarProbindex(row_cols[k])), -row_vals[k] / row_norm);
+		}
+		i++;
+	}
+	if (scip::get_unshifted_rhs(scip, row).has_value()) {
+		for (std::size_t k = 0; k < row_nnz; ++k) {
+			func(i, static_cast<std::size_t>(SCIPcolGetVarProbindex(row_cols[k])), row_vals[k] / row_norm);
+		}
+		i++;
+	}
+}
+
+/**
+ * Call a function on every non zero element of the constraint matrix, in row order.
+ *
+ * The function is called with the row index, the column (variable) index, and the value.
+ * Row are counted once per right hand side and once per left hand side.
+ */
+template <typename Func> void for_each_edge(scip::Model& model, Func&& func) {
 	auto* const scip = model.get_scip_ptr();
+	std::size_t i = 0;
+	for (auto* const row : model.lp_rows()) {
+		for_each_row_edge(scip, row, i, func);
+	}
+}
 
-	using coo_matrix = utility::coo_matrix<value_type>;
+auto edges_shape(scip::Model& model) -> std::array<std::size_t, 2> {
+	// Change this here for variables
+	return {n_ineq_rows(model), static_cast<std::size_t>(SCIPgetNVars(model.get_scip_ptr()))};
+}
+
+template <typename T> utility::coo_matrix<T> extract_edge_features(scip::Model& model) {
+	using coo_matrix = utility::coo_matrix<T>;
 	auto const nnz = matrix_nnz(model);
 	auto values = decltype(coo_matrix::values)::from_shape({nnz});
 	auto indices = decltype(coo_matrix::indices)::from_shape({2, nnz});
 
-	std::size_t i = 0;
 	std::size_t j = 0;
-	for (auto* const row : model.lp_rows()) {
-		auto const row_norm = static_cast<value_type>(row_l2_norm(row));
-		auto* const row_cols = SCIProwGetCols(row);
-		auto const* const row_vals = SCIProwGetVals(row);
-		auto const row_nnz = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
-		if (scip::get_unshifted_lhs(scip, row).has_value()) {
-			for (std::size_t k = 0; k < row_nnz; ++k) {
-				indices(0, j + k) = i;
-				indices(1, j + k) = static_cast<std::size_t>(SCIPcolGetVarProbindex(row_cols[k]));
-				values[j + k] = -row_vals[k] / row_norm;
-			}
-			j += row_nnz;
-			i++;
-		}
-		if (scip::get_unshifted_rhs(scip, row).has_value()) {
-			for (std::size_t k = 0; k < row_nnz; ++k) {
-				indices(0, j + k) = i;
-				indices(1, j + k) = static_cast<std::size_t>(SCIPcolGetVarProbindex(row_cols[k]));
-				values[j + k] = row_vals[k] / row_norm;
-			}
-			j += row_nnz;
-			i++;
+	for_each_edge(model, [&](std::size_t row_idx, std::size_t col_idx, value_type val) {
+		indices(0, j) = row_idx;
+		indices(1, j) = col_idx;
+		values[j] = static_cast<T>(val);
+		++j;
+	});
+
+	return {std::move(values), std::move(indices), edges_shape(model)};
+}
+
+/**
+ * Write the edge values, checking that the sparsity pattern is the one of the previous edges.
+ *
+ * @return Whether the pattern matches, in which case all values were written.
+ */
+template <typename T>
+auto extract_csr_values_on_pattern(
+	scip::Model& model,
+	utility::csr_matrix<T> const& previous,
+	xt::xtensor<T, 1>& values) -> bool {
+	auto const& row_ptrs = *previous.row_ptrs;
+	auto const& col_indices = *previous.col_indices;
+	auto matches = true;
+	std::size_t j = 0;
+	for_each_edge(model, [&](std::size_t row_idx, std::size_t col_idx, value_type val) {
+		// Edges are walked in row order, so their position must fall within the range of their row
+		matches = matches && (row_ptrs[row_idx] <= j) && (j < row_ptrs[row_idx + 1]) && (col_indices[j] == col_idx);
+		if (matches) {
+			values[j] = static_cast<T>(val);
 		}
+		++j;
+	});
+	return matches;
+}
+
+/**
+ * Extract the edges in the CSR format.
+ *
+ * The index arrays of the previous edges are reused without allocation if the sparsity pattern is unchanged.
+ */
+template <typename T>
+utility::csr_matrix<T> extract_csr_edge_features(scip::Model& model, utility::csr_matrix<T> const& previous) {
+	using csr_matrix = utility::csr_matrix<T>;
+	using index_array = typename csr_matrix::index_array;
+	auto const nnz = matrix_nnz(model);
+	auto const shape = edges_shape(model);
+	auto values = decltype(csr_matrix::values)::from_shape({nnz});
+
+	if ((previous.shape == shape) && (previous.col_indices->size() == nnz) &&
+	    extract_csr_values_on_pattern(model, previous, values)) {
+		return {std::move(values), previous.row_ptrs, previous.col_indices, shape};
 	}
 
-	auto const n_rows = n_ineq_rows(model);
-	// Change this here for variables
-	auto const n_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
-	return {values, indices, {n_rows, n_vars}};
+	// The pattern changed, walk the edges again to build new index arrays
+	auto row_ptrs = index_array::from_shape({shape[0] + 1});
+	auto col_indices = index_array::from_shape({nnz});
+	row_ptrs.fill(0);
+	std::size_t j = 0;
+	for_each_edge(model, [&](std::size_t row_idx, std::size_t col_idx, value_type val) {
+		col_indices[j] = col_idx;
+		values[j] = static_cast<T>(val);
+		++j;
+		row_ptrs[row_idx + 1] = j;
+	});
+	// Rows without any non zero were skipped
+	for (std::size_t i = 1; i < row_ptrs.size(); ++i) {
+		row_ptrs[i] = std::max(row_ptrs[i], row_ptrs[i - 1]);
+	}
+	return {
+		std::move(values),
+		std::make_shared<index_array const>(std::move(row_ptrs)),
+		std::make_shared<index_array const>(std::move(col_indices)),
+		shape,
+	};
+}
+
+/** Set the edges in the requested format, leaving the other one empty. */
+template <typename T>
+void set_edge_features(
+	BasicNodeBipartiteObs<T>& obs,
+	scip::Model& model,
+	bool csr_edges,
+	utility::csr_matrix<T> const& previous,
+	FeatureProfiler& profiler) {
+	auto const timer = profiler.time("edges");
+	if (csr_edges) {
+		obs.edge_features_csr = extract_csr_edge_features(model, previous);
+	} else {
+		obs.edge_features = extract_edge_features<T>(model);
+	}
 }
 
 auto is_on_root_node(scip::Model& model) -> bool {
@@ -356,22 +531,497 @@ auto is_on_root_node(scip::Model& model) -> bool {
 	return SCIPgetCurrentNode(scip) == SCIPgetRootNode(scip);
 }
 
-auto extract_observation_fully(scip::Model& model) -> NodeBipartiteObs {
-	auto obs = NodeBipartiteObs{
+template <typename T>
+auto extract_observation_fully(
+	scip::Model& model,
+	bool csr_edges,
+	utility::csr_matrix<T> const& previous_edges,
+	VariableFeaturesMask const& variable_mask,
+	RowFeaturesMask const& row_mask,
+	FeatureProfiler& profiler) -> BasicNodeBipartiteObs<T> {
+	auto obs = BasicNodeBipartiteObs<T>{
+		{},
 		// Change this here for variables
-		xmatrix::from_shape({model.variables().size(), NodeBipartiteObs::n_variable_features}),
-		xmatrix::from_shape({n_ineq_rows(model), NodeBipartiteObs::n_row_features}),
-		extract_edge_features(model),
+		xmatrix<T>::from_shape({model.variables().size(), variable_mask.n_selected()}),
+		xmatrix<T>::from_shape({n_ineq_rows(model), row_mask.n_selected()}),
+		{},
+		{},
 	};
-	set_features_for_all_vars(obs.variable_features, model, true);
-	set_features_for_all_rows(obs.row_features, model, true);
+	set_edge_features(obs, model, csr_edges, previous_edges, profiler);
+	set_features_for_all_vars(obs.variable_features, model, true, variable_mask, profiler);
+	set_features_for_all_rows(obs.row_features, model, true, row_mask, profiler);
 	return obs;
 }
 
-auto extract_observation_from_cache(scip::Model& model, NodeBipartiteObs obs) -> NodeBipartiteObs {
-	set_features_for_all_vars(obs.variable_features, model, false);
-	set_features_for_all_rows(obs.row_features, model, false);
-	return obs;
+/********************************
+ *  Batch extraction functions  *
+ ********************************/
+
+template <typename T>
+void check_batch_shape(
+	NodeBipartiteBatch<T> const& batch,
+	VariableFeaturesMask const& variable_mask,
+	RowFeaturesMask const& row_mask) {
+	if ((batch.variable_features.n_cols() != variable_mask.n_selected()) ||
+			(batch.row_features.n_cols() != row_mask.n_selected()) || (batch.edge_values.n_cols() != 1) ||
+			(batch.edge_indices.n_cols() != 2)) {
+		throw std::invalid_argument{"The number of columns of the batch does not match the NodeBipartite features."};
+	}
+}
+
+template <typename T> void append_empty_observation(NodeBipartiteBatch<T>& batch) {
+	batch.variable_features.append(0);
+	batch.row_features.append(0);
+	batch.edge_values.append(0);
+	batch.edge_indices.append(0);
+}
+
+/** Write the edges of the current node with indices shifted by the given offsets. */
+template <typename T>
+void append_edges(NodeBipartiteBatch<T>& batch, scip::Model& model, std::size_t row_offset, std::size_t var_offset) {
+	auto const nnz = matrix_nnz(model);
+	auto values = batch.edge_values.append(nnz);
+	auto indices = batch.edge_indices.append(nnz);
+	std::size_t j = 0;
+	for_each_edge(model, [&](std::size_t row_idx, std::size_t col_idx, value_type val) {
+		indices(j, 0) = row_offset + row_idx;
+		indices(j, 1) = var_offset + col_idx;
+		values(j, 0) = static_cast<T>(val);
+		++j;
+	});
+}
+
+/** Write the edges of an observation with indices shifted by the given offsets. */
+template <typename T>
+void append_edges(
+	NodeBipartiteBatch<T>& batch,
+	BasicNodeBipartiteObs<T> const& obs,
+	std::size_t row_offset,
+	std::size_t var_offset) {
+	auto const& coo = obs.edge_features;
+	auto const& csr = obs.edge_features_csr;
+	auto const nnz = coo.nnz() + csr.nnz();  // Only one of them is not empty
+	auto values = batch.edge_values.append(nnz);
+	auto indices = batch.edge_indices.append(nnz);
+	for (std::size_t j = 0; j < coo.nnz(); ++j) {
+		indices(j, 0) = row_offset + coo.indices(0, j);
+		indices(j, 1) = var_offset + coo.indices(1, j);
+		values(j, 0) = coo.values[j];
+	}
+	for (std::size_t row = 0; row + 1 < csr.row_ptrs->size(); ++row) {
+		for (auto j = (*csr.row_ptrs)[row]; j < (*csr.row_ptrs)[row + 1]; ++j) {
+			indices(j, 0) = row_offset + row;
+			indices(j, 1) = var_offset + (*csr.col_indices)[j];
+			values(j, 0) = csr.values[j];
+		}
+	}
+}
+
+/** Copy an existing observation in the batch. */
+template <typename T> void append_observation(NodeBipartiteBatch<T>& batch, BasicNodeBipartiteObs<T> const& obs) {
+	auto const var_offset = batch.variable_features.n_rows();
+	auto const row_offset = batch.row_features.n_rows();
+	auto variable_features = batch.variable_features.append(obs.variable_features.shape()[0]);
+	std::copy(obs.variable_features.begin(), obs.variable_features.end(), variable_features.begin());
+	auto row_features = batch.row_features.append(obs.row_features.shape()[0]);
+	std::copy(obs.row_features.begin(), obs.row_features.end(), row_features.begin());
+	append_edges(batch, obs, row_offset, var_offset);
+}
+
+/** Extract the observation of the current node directly in the batch. */
+template <typename T>
+void append_observation(
+	NodeBipartiteBatch<T>& batch,
+	scip::Model& model,
+	VariableFeaturesMask const& variable_mask,
+	RowFeaturesMask const& row_mask,
+	FeatureProfiler& profiler) {
+	auto const var_offset = batch.variable_features.n_rows();
+	auto const row_offset = batch.row_features.n_rows();
+	// Change this here for variables
+	auto variable_features = batch.variable_features.append(model.variables().size());
+	set_features_for_all_vars(variable_features, model, true, variable_mask, profiler);
+	set_features_for_all_rows(batch.row_features.append(n_ineq_rows(model)), model, true, row_mask, profiler);
+	auto const timer = profiler.time("edges");
+	append_edges(batch, model, row_offset, var_offset);
+}
+
+/***************************************
+ *  Declaration of ChangeEventHandler  *
+ ***************************************/
+
+/** Position of a LP row in the last observation extracted. */
+struct RowPosition {
+	/** Row of the features of its first side. */
+	std::size_t feature_row = 0;
+	/** Position of its first edge. */
+	std::size_t edge = 0;
+	/** Number of non zeros in the LP, which changes when columns enter or leave the LP. */
+	int n_lp_nonz = 0;
+	/** Whether the columns were sorted, since SCIP sorts them without notice. */
+	bool lp_cols_sorted = false;
+};
+
+/**
+ * Record the changes in the LP between two extractions.
+ *
+ * Bound changes are tracked per variable.
+ * The positions of the rows in the last observation are kept for the rows that have not entered, left, or been
+ * modified in the LP since, so that their static features and edges can be reused.
+ */
+class ChangeEventHandler : public ::scip::ObjEventhdlr {
+public:
+	inline static auto constexpr base_name = "ecole::observation::NodeBipartiteEventHandler";
+	inline static auto node_bipartite_counter = 0;
+
+	ChangeEventHandler(SCIP* scip, const char* name_) :
+		ObjEventhdlr(scip, name_, "Event handler tracking LP changes for incremental NodeBipartite") {}
+
+	~ChangeEventHandler() override = default;
+
+	/** Catch row, solution, and variable bound events. */
+	SCIP_RETCODE scip_initsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override;
+	/** Drop all events caught. */
+	SCIP_RETCODE scip_exitsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override;
+	/** Record the change. */
+	SCIP_RETCODE scip_exec(SCIP* scip, SCIP_EVENTHDLR* eventhdlr, SCIP_EVENT* event, SCIP_EVENTDATA* eventdata) override;
+
+	/** Whether rows entered, left, or were modified in the LP, or columns entered or left it. */
+	[[nodiscard]] bool rows_changed(SCIP* scip) noexcept;
+	[[nodiscard]] bool incumbent_changed() const noexcept { return m_incumbent_changed; }
+	/** Number of LPs solved when the last observation was extracted. */
+	[[nodiscard]] SCIP_Longint n_lps() const noexcept { return m_n_lps; }
+	/** Problem indices of the variables whose bounds changed. */
+	[[nodiscard]] std::vector<std::size_t> const& bound_changed_vars() const noexcept { return m_bound_changed_vars; }
+	/** Positions in the last observation of the rows unchanged since. */
+	[[nodiscard]] std::unordered_map<SCIP_ROW*, RowPosition>& row_positions() noexcept { return m_row_positions; }
+
+	/** Forget about changes, called after extracting an observation. */
+	void clear(SCIP* scip) noexcept;
+
+private:
+	static inline auto constexpr global_events = SCIP_EVENTTYPE_ROWADDEDLP | SCIP_EVENTTYPE_ROWDELETEDLP;
+	static inline auto constexpr sol_events = SCIP_EVENTTYPE_SOLFOUND;
+	static inline auto constexpr var_events = SCIP_EVENTTYPE_BOUNDCHANGED;
+	static inline auto constexpr row_events = SCIP_EVENTTYPE_ROWCHANGED;
+
+	bool m_rows_changed = true;
+	bool m_incumbent_changed = true;
+	SCIP_Longint m_n_lps = -1;
+	int m_n_lp_cols = -1;
+	std::vector<std::size_t> m_bound_changed_vars;
+	std::vector<bool> m_is_bound_changed;
+	std::vector<std::pair<SCIP_VAR*, int>> m_var_filter_pos;
+	std::unordered_map<SCIP_ROW*, int> m_row_filter_pos;
+	std::unordered_map<SCIP_ROW*, RowPosition> m_row_positions;
+};
+
+/******************************************
+ *  Implementation of ChangeEventHandler  *
+ ******************************************/
+
+auto ChangeEventHandler::scip_initsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE {
+	SCIP_CALL(SCIPcatchEvent(scip, global_events, eventhdlr, nullptr, nullptr));
+	SCIP_CALL(SCIPcatchEvent(scip, sol_events, eventhdlr, nullptr, nullptr));
+	auto* const* const vars = SCIPgetVars(scip);
+	auto const n_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
+	m_var_filter_pos.resize(n_vars);
+	m_is_bound_changed.assign(n_vars, false);
+	for (std::size_t i = 0; i < n_vars; ++i) {
+		m_var_filter_pos[i].first = vars[i];
+		SCIP_CALL(SCIPcatchVarEvent(scip, vars[i], var_events, eventhdlr, nullptr, &m_var_filter_pos[i].second));
+	}
+	m_rows_changed = true;
+	m_incumbent_changed = true;
+	m_n_lps = -1;
+	m_n_lp_cols = -1;
+	m_row_positions.clear();
+	return SCIP_OKAY;
+}
+
+auto ChangeEventHandler::scip_exitsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE {
+	SCIP_CALL(SCIPdropEvent(scip, global_events, eventhdlr, nullptr, -1));
+	SCIP_CALL(SCIPdropEvent(scip, sol_events, eventhdlr, nullptr, -1));
+	for (auto [var, filter_pos] : m_var_filter_pos) {
+		SCIP_CALL(SCIPdropVarEvent(scip, var, var_events, eventhdlr, nullptr, filter_pos));
+	}
+	for (auto [row, filter_pos] : m_row_filter_pos) {
+		SCIP_CALL(SCIPdropRowEvent(scip, row, row_events, eventhdlr, nullptr, filter_pos));
+	}
+	m_var_filter_pos.clear();
+	m_row_filter_pos.clear();
+	m_row_positions.clear();
+	return SCIP_OKAY;
+}
+
+auto ChangeEventHandler::scip_exec(
+	SCIP* scip,
+	SCIP_EVENTHDLR* eventhdlr,
+	SCIP_EVENT* event,
+	SCIP_EVENTDATA* /*eventdata*/) -> SCIP_RETCODE {
+	auto const type = SCIPeventGetType(event);
+	if ((type & var_events) != 0) {
+		auto const prob_idx = SCIPvarGetProbindex(SCIPeventGetVar(event));
+		if (prob_idx >= 0 && static_cast<std::size_t>(prob_idx) < m_is_bound_changed.size()) {
+			auto const var_idx = static_cast<std::size_t>(prob_idx);
+			if (!m_is_bound_changed[var_idx]) {
+				m_is_bound_changed[var_idx] = true;
+				m_bound_changed_vars.push_back(var_idx);
+			}
+		}
+		return SCIP_OKAY;
+	}
+	if ((type & sol_events) != 0) {
+		m_incumbent_changed = true;
+		return SCIP_OKAY;
+	}
+	m_rows_changed = true;
+	// The row can no longer be reused from the last observation, even if it comes back to the LP.
+	auto* const row = SCIPeventGetRow(event);
+	m_row_positions.erase(row);
+	if ((type & SCIP_EVENTTYPE_ROWADDEDLP) != 0) {
+		// Rows in the LP can still be modified, hence they are tracked while in the LP.
+		if (m_row_filter_pos.count(row) == 0) {
+			SCIP_CALL(SCIPcatchRowEvent(scip, row, row_events, eventhdlr, nullptr, &m_row_filter_pos[row]));
+		}
+	} else if ((type & SCIP_EVENTTYPE_ROWDELETEDLP) != 0) {
+		if (auto iter = m_row_filter_pos.find(row); iter != m_row_filter_pos.end()) {
+			SCIP_CALL(SCIPdropRowEvent(scip, row, row_events, eventhdlr, nullptr, iter->second));
+			m_row_filter_pos.erase(iter);
+		}
+	}
+	return SCIP_OKAY;
+}
+
+bool ChangeEventHandler::rows_changed(SCIP* scip) noexcept {
+	// Columns entering or leaving the LP change the non zeros of the rows without row events.
+	if (SCIPgetNLPCols(scip) != m_n_lp_cols) {
+		m_row_positions.clear();
+		m_rows_changed = true;
+	}
+	return m_rows_changed;
+}
+
+void ChangeEventHandler::clear(SCIP* scip) noexcept {
+	m_rows_changed = false;
+	m_incumbent_changed = false;
+	m_n_lps = SCIPgetNLPs(scip);
+	for (auto const var_idx : m_bound_changed_vars) {
+		m_is_bound_changed[var_idx] = false;
+	}
+	m_n_lp_cols = SCIPgetNLPCols(scip);
+	m_bound_changed_vars.clear();
+}
+
+auto get_eventhdlr(scip::Model& model, std::string const& name) -> ChangeEventHandler& {
+	auto* const base_handler = SCIPfindObjEventhdlr(model.get_scip_ptr(), name.c_str());
+	assert(base_handler != nullptr);
+	auto* const handler = dynamic_cast<ChangeEventHandler*>(base_handler);
+	assert(handler != nullptr);
+	return *handler;
+}
+
+void add_eventhdlr(scip::Model& model, std::string const& name) {
+	if (SCIPfindEventhdlr(model.get_scip_ptr(), name.c_str()) != nullptr) {
+		return;
+	}
+	auto handler = std::make_unique<ChangeEventHandler>(model.get_scip_ptr(), name.c_str());
+	scip::call(SCIPincludeObjEventhdlr, model.get_scip_ptr(), handler.get(), true);
+	// NOLINTNEXTLINE memory ownership is passed to SCIP
+	handler.release();
+}
+
+/** Record the position of all LP rows in an observation extracted from scratch. */
+void record_row_positions(scip::Model& model, std::unordered_map<SCIP_ROW*, RowPosition>& positions) {
+	auto* const scip = model.get_scip_ptr();
+	positions.clear();
+	std::size_t feature_row = 0;
+	std::size_t edge = 0;
+	for (auto* const row : model.lp_rows()) {
+		auto const n_sides = static_cast<std::size_t>(scip::get_unshifted_lhs(scip, row).has_value()) +
+		                     static_cast<std::size_t>(scip::get_unshifted_rhs(scip, row).has_value());
+		auto const n_lp_nonz = SCIProwGetNLPNonz(row);
+		positions[row] = {feature_row, edge, n_lp_nonz, row->lpcolssorted != 0U};
+		feature_row += n_sides;
+		edge += n_sides * static_cast<std::size_t>(n_lp_nonz);
+	}
+}
+
+/**
+ * Rebuild the row features and edges after the LP rows changed.
+ *
+ * Rows are reordered, and the static features and edges of the rows unchanged since the previous observation are
+ * copied from it.
+ * They are computed only for the rows that entered or were modified in the LP.
+ * Dynamic row features are left for the caller to compute.
+ * The static row features are timed with the edges, which dominate.
+ */
+template <typename T>
+void update_rows(
+	scip::Model& model,
+	BasicNodeBipartiteObs<T>& obs,
+	std::unordered_map<SCIP_ROW*, RowPosition>& positions,
+	bool csr_edges,
+	RowFeaturesMask const& row_mask,
+	FeatureProfiler& profiler) {
+	using index_array = typename utility::csr_matrix<T>::index_array;
+	auto const timer = profiler.time("edges");
+	auto* const scip = model.get_scip_ptr();
+	auto const previous_features = std::move(obs.row_features);
+	auto const previous_coo = std::move(obs.edge_features);
+	auto const previous_csr = std::move(obs.edge_features_csr);
+	auto const previous_col = [&](std::size_t j) {
+		return csr_edges ? (*previous_csr.col_indices)[j] : previous_coo.indices(1, j);
+	};
+	auto const previous_value = [&](std::size_t j) {
+		return csr_edges ? previous_csr.values[j] : previous_coo.values[j];
+	};
+
+	auto const n_cols = row_mask.n_selected();
+	auto const nnz = matrix_nnz(model);
+	auto const shape = edges_shape(model);
+	obs.row_features = xmatrix<T>::from_shape({shape[0], n_cols});
+	auto values = xt::xtensor<T, 1>::from_shape({nnz});
+	auto col_indices = index_array::from_shape({nnz});
+	auto row_ptrs = index_array::from_shape({shape[0] + 1});
+	row_ptrs.fill(0);
+
+	auto new_positions = std::unordered_map<SCIP_ROW*, RowPosition>{};
+	new_positions.reserve(positions.size());
+	std::size_t feature_row = 0;
+	std::size_t j = 0;
+	for (auto* const row : model.lp_rows()) {
+		auto const has_lhs = scip::get_unshifted_lhs(scip, row).has_value();
+		auto const has_rhs = scip::get_unshifted_rhs(scip, row).has_value();
+		auto const n_sides = static_cast<std::size_t>(has_lhs) + static_cast<std::size_t>(has_rhs);
+		auto const n_lp_nonz = SCIProwGetNLPNonz(row);
+		auto const position = RowPosition{feature_row, j, n_lp_nonz, row->lpcolssorted != 0U};
+		auto const iter = positions.find(row);
+		auto const reuse = (iter != positions.end()) && (iter->second.n_lp_nonz == position.n_lp_nonz) &&
+		                   (iter->second.lp_cols_sorted == position.lp_cols_sorted);
+		if (reuse) {
+			// Features are contiguous, and the dynamic ones are overwritten by the caller
+			auto const* const first = previous_features.data() + iter->second.feature_row * n_cols;
+			std::copy_n(first, n_sides * n_cols, obs.row_features.data() + feature_row * n_cols);
+			auto const row_nnz = n_sides * static_cast<std::size_t>(n_lp_nonz);
+			for (std::size_t k = 0; k < row_nnz; ++k) {
+				col_indices[j + k] = previous_col(iter->second.edge + k);
+				values[j + k] = previous_value(iter->second.edge + k);
+			}
+			for (std::size_t side = 0; side < n_sides; ++side) {
+				row_ptrs[feature_row + side + 1] = j + (side + 1) * static_cast<std::size_t>(n_lp_nonz);
+			}
+			j += row_nnz;
+			feature_row += n_sides;
+		} else {
+			auto const row_norm = static_cast<value_type>(row_l2_norm(row));
+			if (has_lhs) {
+				auto features = masked_row(xt::row(obs.row_features, static_cast<std::ptrdiff_t>(feature_row)), row_mask);
+				set_static_features_for_lhs_row(features, scip, row, row_norm);
+			}
+			if (has_rhs) {
+				auto const rhs_row = feature_row + static_cast<std::size_t>(has_lhs);
+				auto features = masked_row(xt::row(obs.row_features, static_cast<std::ptrdiff_t>(rhs_row)), row_mask);
+				set_static_features_for_rhs_row(features, scip, row, row_norm);
+			}
+			for_each_row_edge(scip, row, feature_row, [&](std::size_t row_idx, std::size_t col_idx, value_type val) {
+				col_indices[j] = col_idx;
+				values[j] = static_cast<T>(val);
+				++j;
+				row_ptrs[row_idx + 1] = j;
+			});
+			// Sides without any non zero were skipped
+			for (auto i = position.feature_row; i < feature_row; ++i) {
+				row_ptrs[i + 1] = std::max(row_ptrs[i + 1], row_ptrs[i]);
+			}
+		}
+		new_positions.emplace(row, position);
+	}
+	assert(feature_row == shape[0]);
+	assert(j == nnz);
+	positions = std::move(new_positions);
+
+	if (csr_edges) {
+		// The index arrays are still shared when only the values of the rows changed
+		if ((previous_csr.shape == shape) && (*previous_csr.row_ptrs == row_ptrs) &&
+		    (*previous_csr.col_indices == col_indices)) {
+			obs.edge_features_csr = {std::move(values), previous_csr.row_ptrs, previous_csr.col_indices, shape};
+		} else {
+			obs.edge_features_csr = {
+				std::move(values),
+				std::make_shared<index_array const>(std::move(row_ptrs)),
+				std::make_shared<index_array const>(std::move(col_indices)),
+				shape,
+			};
+		}
+	} else {
+		using coo_matrix = utility::coo_matrix<T>;
+		auto indices = decltype(coo_matrix::indices)::from_shape({2, nnz});
+		for (std::size_t i = 0; i < shape[0]; ++i) {
+			for (auto k = row_ptrs[i]; k < row_ptrs[i + 1]; ++k) {
+				indices(0, k) = i;
+				indices(1, k) = col_indices[k];
+			}
+		}
+		obs.edge_features = {std::move(values), std::move(indices), shape};
+	}
+}
+
+/**
+ * Update the previous observation with the changes recorded by the event handler.
+ *
+ * Static features are never recomputed, except for the rows that entered or were modified in the LP.
+ * Features depending on the LP solution, that is most of the dynamic variable and row features, are recomputed for
+ * all variables and rows whenever a LP was solved since the previous observation.
+ * Bound features are recomputed for variables with bound changes, and incumbent features when new solutions are
+ * found.
+ * When the LP rows changed, the edges of the unchanged rows are copied and only the other ones are extracted.
+ */
+template <typename T>
+void update_observation(
+	scip::Model& model,
+	BasicNodeBipartiteObs<T>& obs,
+	ChangeEventHandler& handler,
+	bool csr_edges,
+	VariableFeaturesMask const& variable_mask,
+	RowFeaturesMask const& row_mask,
+	FeatureProfiler& profiler) {
+	auto* const scip = model.get_scip_ptr();
+	auto const lp_solved = SCIPgetNLPs(scip) != handler.n_lps();
+	auto const n_lps = static_cast<value_type>(SCIPgetNLPs(scip));
+	auto const obj_norm = obj_l2_norm(scip);
+
+	auto const variables = model.variables();
+	{
+		auto const timer = profiler.time("dynamic variable features");
+		if (lp_solved || handler.incumbent_changed()) {
+			for (std::size_t var_idx = 0; var_idx < variables.size(); ++var_idx) {
+				auto* const var = variables[var_idx];
+				auto features =
+					masked_row(xt::row(obs.variable_features, static_cast<std::ptrdiff_t>(var_idx)), variable_mask);
+				if (lp_solved) {
+					set_lp_features_for_var(features, scip, var, SCIPvarGetCol(var), obj_norm, n_lps);
+				}
+				if (handler.incumbent_changed()) {
+					set_incumbent_features_for_var(features, scip, var);
+				}
+			}
+		}
+		for (auto const var_idx : handler.bound_changed_vars()) {
+			auto* const var = variables[var_idx];
+			auto features = masked_row(xt::row(obs.variable_features, static_cast<std::ptrdiff_t>(var_idx)), variable_mask);
+			set_bound_features_for_var(features, scip, SCIPvarGetCol(var));
+			// Whether the solution is at a bound depends on the bounds
+			set_lp_features_for_var(features, scip, var, SCIPvarGetCol(var), obj_norm, n_lps);
+		}
+	}
+
+	if (handler.rows_changed(scip)) {
+		update_rows(model, obs, handler.row_positions(), csr_edges, row_mask, profiler);
+		set_features_for_all_rows(obs.row_features, model, false, row_mask, profiler);
+	} else if (lp_solved) {
+		set_features_for_all_rows(obs.row_features, model, false, row_mask, profiler);
+	}
 }
 
 }  // namespace
@@ -380,25 +1030,99 @@ auto extract_observation_from_cache(scip::Model& model, NodeBipartiteObs obs) ->
  *  Observation extracting function  *
  *************************************/
 
-auto NodeBipartite::before_reset(scip::Model& /* model */) -> void {
+template <typename T>
+BasicNodeBipartite<T>::BasicNodeBipartite(
+	bool cache,
+	bool incremental,
+	bool csr_edges,
+	NodeBipartiteFeatures::VariableFeaturesMask variable_mask_,
+	NodeBipartiteFeatures::RowFeaturesMask row_mask_) :
+	variable_mask{variable_mask_},
+	row_mask{row_mask_},
+	use_cache{cache},
+	use_incremental{incremental},
+	use_csr_edges{csr_edges} {
+	if (use_incremental) {
+		static auto m = std::mutex{};
+		auto g = std::lock_guard{m};
+		eventhdlr_name = ChangeEventHandler::base_name + std::to_string(ChangeEventHandler::node_bipartite_counter);
+		ChangeEventHandler::node_bipartite_counter++;
+	}
+}
+
+template <typename T> auto BasicNodeBipartite<T>::before_reset(scip::Model& model) -> void {
 	cache_computed = false;
+	the_edges_pattern = {};
+	if (use_incremental) {
+		add_eventhdlr(model, eventhdlr_name);
+	}
 }
 
-auto NodeBipartite::extract(scip::Model& model, bool /* done */) -> std::optional<NodeBipartiteObs> {
+template <typename T> auto BasicNodeBipartite<T>::update_cache(scip::Model& model) -> bool {
+	if (use_incremental) {
+		auto& handler = get_eventhdlr(model, eventhdlr_name);
+		if (cache_computed && the_cache.variable_features.shape()[0] == model.variables().size()) {
+			update_observation(model, the_cache, handler, use_csr_edges, variable_mask, row_mask, the_profiler);
+		} else {
+			the_cache = extract_observation_fully(
+				model, use_csr_edges, the_cache.edge_features_csr, variable_mask, row_mask, the_profiler);
+			record_row_positions(model, handler.row_positions());
+			cache_computed = true;
+		}
+		handler.clear(model.get_scip_ptr());
+		return true;
+	}
+	if (use_cache) {
+		if (is_on_root_node(model)) {
+			the_cache = extract_observation_fully(
+				model, use_csr_edges, the_cache.edge_features_csr, variable_mask, row_mask, the_profiler);
+			cache_computed = true;
+			return true;
+		}
+		if (cache_computed) {
+			// Static features are kept, and dynamic ones are all overwritten.
+			set_features_for_all_vars(the_cache.variable_features, model, false, variable_mask, the_profiler);
+			set_features_for_all_rows(the_cache.row_features, model, false, row_mask, the_profiler);
+			return true;
+		}
+	}
+	return false;
+}
+
+template <typename T>
+auto BasicNodeBipartite<T>::extract(scip::Model& model, bool /* done */) -> std::optional<BasicNodeBipartiteObs<T>> {
 	if (model.stage() == SCIP_STAGE_SOLVING) {
-		if (use_cache) {
-			if (is_on_root_node(model)) {
-				the_cache = extract_observation_fully(model);
-				cache_computed = true;
-				return the_cache;
-			}
-			if (cache_computed) {
-				return extract_observation_from_cache(model, the_cache);
-			}
+		if (update_cache(model)) {
+			return the_cache;
+		}
+		auto obs =
+			extract_observation_fully(model, use_csr_edges, the_edges_pattern, variable_mask, row_mask, the_profiler);
+		if (use_csr_edges) {
+			// Only the index arrays are needed for sharing them with the next observation.
+			auto const& edges = obs.edge_features_csr;
+			the_edges_pattern = {{}, edges.row_ptrs, edges.col_indices, edges.shape};
 		}
-		return extract_observation_fully(model);
+		return obs;
 	}
 	return {};
 }
 
+template <typename T>
+auto BasicNodeBipartite<T>::extract_into(scip::Model& model, bool /* done */, NodeBipartiteBatch<T>& batch) -> bool {
+	check_batch_shape(batch, variable_mask, row_mask);
+	if (model.stage() == SCIP_STAGE_SOLVING) {
+		if (update_cache(model)) {
+			append_observation(batch, the_cache);
+		} else {
+			append_observation(batch, model, variable_mask, row_mask, the_profiler);
+		}
+		return true;
+	}
+	append_empty_observation(batch);
+	return false;
+}
+
+template class BasicNodeBipartite<double>;
+template class BasicNodeBipartite<float>;
+
 }  // namespace ecole::observation
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <nonstd/span.hpp>
+#include <scip/scip.h>
+
+#include "ecole/observation/partial-strong-branching-scores.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::observation {
+
+namespace {
+
+struct Candidate {
+	SCIP_VAR* var;
+	SCIP_Real lp_value;
+	SCIP_Real pseudocost_score;
+};
+
+/** Get the candidates sorted by decreasing pseudocost score. */
+auto get_sorted_candidates(SCIP* const scip, bool pseudo_candidates) -> std::vector<Candidate> {
+	SCIP_VAR** vars = nullptr;
+	int n_vars = 0;
+	if (pseudo_candidates) {
+		scip::call(SCIPgetPseudoBranchCands, scip, &vars, &n_vars, nullptr);
+	} else {
+		scip::call(SCIPgetLPBranchCands, scip, &vars, nullptr, nullptr, &n_vars, nullptr, nullptr);
+	}
+
+	auto candidates = std::vector<Candidate>{};
+	candidates.reserve(static_cast<std::size_t>(n_vars));
+	for (auto* const var : nonstd::span{vars, static_cast<std::size_t>(n_vars)}) {
+		auto const lp_value = SCIPvarGetLPSol(var);
+		candidates.push_back({var, lp_value, SCIPgetVarPseudocostScore(scip, var, lp_value)});
+	}
+	// Stable to break ties by the order of SCIP
+	std::stable_sort(candidates.begin(), candidates.end(), [](auto const& cand1, auto const& cand2) {
+		return cand1.pseudocost_score > cand2.pseudocost_score;
+	});
+	return candidates;
+}
+
+/** Strong branching mode of SCIP, ended on destruction. */
+class StrongbranchGuard {
+public:
+	StrongbranchGuard(SCIP* const scip_) : scip{scip_} { scip::call(SCIPstartStrongbranch, scip, FALSE); }
+	StrongbranchGuard(StrongbranchGuard const&) = delete;
+	StrongbranchGuard(StrongbranchGuard&&) = delete;
+	~StrongbranchGuard() { SCIPendStrongbranch(scip); }
+
+	auto operator=(StrongbranchGuard const&) -> StrongbranchGuard& = delete;
+	auto operator=(StrongbranchGuard&&) -> StrongbranchGuard& = delete;
+
+private:
+	SCIP* scip;
+};
+
+/**
+ * The strong branching score of a candidate, as computed by the vanillafullstrong branching rule, or nothing on LP
+ * errors.
+ */
+auto strong_branching_score(SCIP* const scip, Candidate const& cand) -> std::optional<SCIP_Real> {
+	SCIP_Real down = 0.;
+	SCIP_Real up = 0.;
+	SCIP_Bool lperror = FALSE;
+	// Branching on an integral value, as for pseudo candidates, creates children at the value minus and plus one
+	auto const get_strongbranch =
+		(SCIPisFeasIntegral(scip, cand.lp_value) != FALSE) ? SCIPgetVarStrongbranchInt : SCIPgetVarStrongbranchFrac;
+	scip::call(
+		get_strongbranch,
+		scip,
+		cand.var,
+		INT_MAX,
+		TRUE,
+		&down,
+		&up,
+		nullptr,
+		nullptr,
+		nullptr,
+		nullptr,
+		nullptr,
+		nullptr,
+		&lperror);
+	if (lperror != FALSE) {
+		return {};
+	}
+	auto const lp_objective = SCIPgetLPObjval(scip);
+	auto const down_gain = std::max(down, lp_objective) - lp_objective;
+	auto const up_gain = std::max(up, lp_objective) - lp_objective;
+	return SCIPgetBranchScore(scip, cand.var, down_gain, up_gain);
+}
+
+}  // namespace
+
+PartialStrongBranchingScores::PartialStrongBranchingScores(
+	bool pseudo_candidates_,
+	std::optional<std::size_t> max_candidates_,
+	std::optional<SCIP_Longint> max_lp_iterations_,
+	std::optional<double> time_limit_) :
+	pseudo_candidates(pseudo_candidates_),
+	max_candidates(max_candidates_),
+	max_lp_iterations(max_lp_iterations_),
+	time_limit(time_limit_) {}
+
+auto PartialStrongBranchingScores::extract(scip::Model& model, bool /* done */) const
+	-> std::optional<PartialStrongBranchingScoresObs> {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return {};
+	}
+
+	auto* const scip = model.get_scip_ptr();
+	auto const nb_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
+	auto obs = PartialStrongBranchingScoresObs{
+		xt::xtensor<double, 1>({nb_vars}, std::nan("")),
+		xt::xtensor<bool, 1>({nb_vars}, false),
+	};
+	if (SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL) {
+		return obs;
+	}
+
+	auto const candidates = get_sorted_candidates(scip, pseudo_candidates);
+	for (auto const& cand : candidates) {
+		obs.scores[static_cast<std::size_t>(SCIPvarGetProbindex(cand.var))] = cand.pseudocost_score;
+	}
+
+	auto const start_time = std::chrono::steady_clock::now();
+	auto const start_lp_iterations = SCIPgetNStrongbranchLPIterations(scip);
+	auto const within_budget = [&](std::size_t n_evaluated) {
+		if (max_candidates.has_value() && n_evaluated >= max_candidates.value()) {
+			return false;
+		}
+		if (max_lp_iterations.has_value() &&
+				SCIPgetNStrongbranchLPIterations(scip) - start_lp_iterations >= max_lp_iterations.value()) {
+			return false;
+		}
+		auto const elapsed = std::chrono::duration<double>{std::chrono::steady_clock::now() - start_time};
+		return !time_limit.has_value() || elapsed.count() < time_limit.value();
+	};
+
+	auto const guard = StrongbranchGuard{scip};
+	auto n_evaluated = std::size_t{0};
+	for (auto const& cand : candidates) {
+		if (SCIPvarGetStatus(cand.var) != SCIP_VARSTATUS_COLUMN) {
+			continue;
+		}
+		if (!within_budget(n_evaluated)) {
+			break;
+		}
+		++n_evaluated;
+		auto const score = strong_branching_score(scip, cand);
+		// The LP cannot be trusted for the remaining candidates
+		if (!score.has_value()) {
+			break;
+		}
+		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(cand.var));
+		obs.scores[var_index] = score.value();
+		obs.is_exact[var_index] = true;
+	}
+	return obs;
+}
+
+}  // namespace ecole::observation
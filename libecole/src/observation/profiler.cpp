@@ -0,0 +1,54 @@
+#include <algorithm>
+
+#include "ecole/observation/profiler.hpp"
+
+namespace ecole::observation {
+
+/**********************************************
+ *  Implementation of FeatureProfiler::Scope  *
+ **********************************************/
+
+FeatureProfiler::Scope::Scope(FeatureProfiler* profiler, std::string_view group) :
+	m_profiler{profiler}, m_group{group} {
+	if (m_profiler != nullptr) {
+		m_wall_start = std::chrono::steady_clock::now();
+		m_cpu_start = utility::cpu_clock::now();
+	}
+}
+
+FeatureProfiler::Scope::~Scope() {
+	if (m_profiler == nullptr) {
+		return;
+	}
+	try {
+		auto const cpu_end = utility::cpu_clock::now();
+		auto const wall_end = std::chrono::steady_clock::now();
+		m_profiler->record(
+			m_group,
+			std::chrono::duration<double>{wall_end - m_wall_start}.count(),
+			std::chrono::duration<double>{cpu_end - m_cpu_start}.count());
+	} catch (...) {
+		// Failing to time a group must not interrupt the extraction of the observation.
+	}
+}
+
+/***************************************
+ *  Implementation of FeatureProfiler  *
+ ***************************************/
+
+void FeatureProfiler::record(std::string_view group, double wall_time, double cpu_time) {
+	auto iter = std::find_if(m_groups.begin(), m_groups.end(), [group](auto const& g) { return g.name == group; });
+	if (iter == m_groups.end()) {
+		iter = m_groups.insert(m_groups.end(), ProfiledGroup{std::string{group}});
+	}
+	iter->n_calls++;
+	iter->wall_time += wall_time;
+	iter->cpu_time += cpu_time;
+}
+
+auto FeatureProfiler::group(std::string_view name) const noexcept -> ProfiledGroup const* {
+	auto const iter = std::find_if(m_groups.begin(), m_groups.end(), [name](auto const& g) { return g.name == name; });
+	return iter != m_groups.end() ? &(*iter) : nullptr;
+}
+
+}  // namespace ecole::observation
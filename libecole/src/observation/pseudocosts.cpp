@@ -1,9 +1,12 @@
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <optional>
+#include <stdexcept>
 
 #include <nonstd/span.hpp>
 #include <range/v3/view/zip.hpp>
+#include <xtensor/xstrided_view.hpp>
 #include <xtensor/xtensor.hpp>
 #include <xtensor/xview.hpp>
 
@@ -28,6 +31,17 @@ auto scip_get_lp_branch_cands(SCIP* const scip) noexcept {
 	};
 }
 
+/** Write the pseudocosts of all variables, NaN for non candidates. */
+template <typename Tensor> void set_pseudocosts(Tensor&& pseudocosts, SCIP* const scip) {
+	auto const [cands, lp_values] = scip_get_lp_branch_cands(scip);
+	std::fill(pseudocosts.begin(), pseudocosts.end(), std::nan(""));
+	for (auto const [var, lp_val] : views::zip(cands, lp_values)) {
+		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		auto const score = SCIPgetVarPseudocostScore(scip, var, lp_val);
+		pseudocosts[var_index] = static_cast<double>(score);
+	}
+}
+
 }  // namespace
 
 std::optional<xt::xtensor<double, 1>> Pseudocosts::extract(scip::Model& model, bool /* done */) {
@@ -36,19 +50,28 @@ std::optional<xt::xtensor<double, 1>> Pseudocosts::extract(scip::Model& model, b
 	}
 
 	auto* const scip = model.get_scip_ptr();
-	auto const [cands, lp_values] = scip_get_lp_branch_cands(scip);
 
 	/* Store pseudocosts in tensor */
 	auto const nb_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
-	xt::xtensor<double, 1> pseudocosts({nb_vars}, std::nan(""));
+	auto pseudocosts = xt::xtensor<double, 1>::from_shape({nb_vars});
+	set_pseudocosts(pseudocosts, scip);
 
-	for (auto const [var, lp_val] : views::zip(cands, lp_values)) {
-		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
-		auto const score = SCIPgetVarPseudocostScore(scip, var, lp_val);
-		pseudocosts[var_index] = static_cast<double>(score);
+	return pseudocosts;
+}
+
+bool Pseudocosts::extract_into(scip::Model& model, bool /* done */, BatchMatrix<double>& batch) {
+	if (batch.n_cols() != 1) {
+		throw std::invalid_argument{"Expected a single pseudocost per row."};
+	}
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		batch.append(0);
+		return false;
 	}
 
-	return pseudocosts;
+	auto* const scip = model.get_scip_ptr();
+	auto const nb_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
+	set_pseudocosts(xt::flatten(batch.append(nb_vars)), scip);
+	return true;
 }
 
 }  // namespace ecole::observation
@@ -1,6 +1,16 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
 
+#include <lpi/lpi.h>
 #include <nonstd/span.hpp>
 #include <range/v3/view/zip.hpp>
 #include <scip/scipdefplugins.h>
@@ -10,12 +20,66 @@
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/utils.hpp"
 
+#include "scip/lpi.hpp"
+
 namespace ecole::observation {
 
 namespace views = ranges::views;
 
 namespace {
 
+using VanillaParams = std::array<SCIP_PARAM*, 5>;
+
+/** The parameters of vanillafullstrong set during extraction, in the order of their handles. */
+constexpr auto vanilla_param_names = std::array<char const*, std::tuple_size_v<VanillaParams>>{
+	"branching/vanillafullstrong/integralcands",
+	"branching/vanillafullstrong/scoreall",
+	"branching/vanillafullstrong/collectscores",
+	"branching/vanillafullstrong/donotbranch",
+	"branching/vanillafullstrong/idempotent",
+};
+
+auto find_vanilla_params(SCIP* const scip) -> VanillaParams {
+	auto params = VanillaParams{};
+	std::transform(vanilla_param_names.begin(), vanilla_param_names.end(), params.begin(), [scip](char const* name) {
+		auto* const param = SCIPgetParam(scip, name);
+		if (param == nullptr) {
+			throw scip::ScipError::from_retcode(SCIP_PARAMETERUNKNOWN);
+		}
+		return param;
+	});
+	return params;
+}
+
+/** Set boolean parameters through their handles, and restore their previous values on destruction. */
+class BoolParamsGuard {
+public:
+	using Values = std::array<SCIP_Bool, std::tuple_size_v<VanillaParams>>;
+
+	BoolParamsGuard(SCIP* const scip_, VanillaParams const& params_, Values const& values) :
+		scip{scip_}, params{params_} {
+		std::transform(params.begin(), params.end(), previous.begin(), SCIPparamGetBool);
+		for (auto const [param, value] : views::zip(params, values)) {
+			scip::call(SCIPchgBoolParam, scip, param, value);
+		}
+	}
+	BoolParamsGuard(BoolParamsGuard const&) = delete;
+	BoolParamsGuard(BoolParamsGuard&&) = delete;
+	~BoolParamsGuard() {
+		for (auto const [param, value] : views::zip(params, previous)) {
+			SCIPchgBoolParam(scip, param, value);
+		}
+	}
+
+	auto operator=(BoolParamsGuard const&) -> BoolParamsGuard& = delete;
+	auto operator=(BoolParamsGuard&&) -> BoolParamsGuard& = delete;
+
+private:
+	SCIP* scip;
+	VanillaParams params;
+	Values previous = {};
+};
+
 /** get vanilla full strong branching scores and variables */
 auto scip_get_vanillafullstrong_data(SCIP* const scip) noexcept {
 	SCIP_VAR** cands = nullptr;
@@ -28,9 +92,314 @@ auto scip_get_vanillafullstrong_data(SCIP* const scip) noexcept {
 	};
 }
 
+/** Run the vanillafullstrong branching rule without branching, and write the scores of its candidates. */
+void set_vanillafullstrong_scores(
+	xt::xtensor<double, 1>& scores,
+	SCIP* const scip,
+	VanillaParams const& params,
+	bool pseudo_candidates) {
+	auto const guard = BoolParamsGuard{scip, params, {pseudo_candidates, TRUE, TRUE, TRUE, TRUE}};
+
+	auto* branchrule = SCIPfindBranchrule(scip, "vanillafullstrong");
+	SCIP_RESULT result;
+	scip::call(branchrule->branchexeclp, scip, branchrule, false, &result);
+	assert(result == SCIP_DIDNOTRUN);
+
+	auto const [cands, cands_scores] = scip_get_vanillafullstrong_data(scip);
+	for (auto const [var, score] : views::zip(cands, cands_scores)) {
+		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		scores[var_index] = static_cast<double>(score);
+	}
+}
+
+/******************************************
+ *  Strong branching on copies of the LP  *
+ ******************************************/
+
+/**
+ * A copy of the LP at the current node, in the row format of the LP interface.
+ *
+ * Infinite bounds and sides are stored as floating point infinities, to be converted for every LP interface.
+ */
+struct NodeLp {
+	std::vector<SCIP_Real> objective;
+	std::vector<SCIP_Real> lower_bounds;
+	std::vector<SCIP_Real> upper_bounds;
+	std::vector<SCIP_Real> lhs;
+	std::vector<SCIP_Real> rhs;
+	std::vector<int> row_begins;
+	std::vector<int> col_indices;
+	std::vector<SCIP_Real> values;
+	/** The basis of the LP solution, empty if the solution is not basic. */
+	std::vector<int> col_basis;
+	std::vector<int> row_basis;
+	SCIP_Real feastol;
+	SCIP_Real dualfeastol;
+};
+
+auto copy_node_lp(SCIP* const scip) -> NodeLp {
+	auto const infinity = std::numeric_limits<SCIP_Real>::infinity();
+	auto const to_lp = [scip, infinity](SCIP_Real value) {
+		if (SCIPisInfinity(scip, std::abs(value))) {
+			return std::copysign(infinity, value);
+		}
+		return value;
+	};
+
+	SCIP_COL** cols = nullptr;
+	int n_cols = 0;
+	scip::call(SCIPgetLPColsData, scip, &cols, &n_cols);
+	SCIP_ROW** rows = nullptr;
+	int n_rows = 0;
+	scip::call(SCIPgetLPRowsData, scip, &rows, &n_rows);
+	auto const lp_cols = nonstd::span{cols, static_cast<std::size_t>(n_cols)};
+	auto const lp_rows = nonstd::span{rows, static_cast<std::size_t>(n_rows)};
+
+	auto lp = NodeLp{};
+	lp.feastol = SCIPgetLPFeastol(scip);
+	lp.dualfeastol = SCIPdualfeastol(scip);
+	for (auto* const col : lp_cols) {
+		lp.objective.push_back(SCIPcolGetObj(col));
+		lp.lower_bounds.push_back(to_lp(SCIPcolGetLb(col)));
+		lp.upper_bounds.push_back(to_lp(SCIPcolGetUb(col)));
+	}
+	for (auto* const row : lp_rows) {
+		// Columns of the LP come first in the row
+		auto const row_nnz = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
+		auto* const* const row_cols = SCIProwGetCols(row);
+		auto const* const row_vals = SCIProwGetVals(row);
+		lp.row_begins.push_back(static_cast<int>(lp.values.size()));
+		for (std::size_t k = 0; k < row_nnz; ++k) {
+			lp.col_indices.push_back(SCIPcolGetLPPos(row_cols[k]));
+			lp.values.push_back(row_vals[k]);
+		}
+		auto const constant = SCIProwGetConstant(row);
+		lp.lhs.push_back(to_lp(SCIProwGetLhs(row)) - constant);
+		lp.rhs.push_back(to_lp(SCIProwGetRhs(row)) - constant);
+	}
+	if (SCIPisLPSolBasic(scip) != FALSE) {
+		std::transform(lp_cols.begin(), lp_cols.end(), std::back_inserter(lp.col_basis), [](auto* col) {
+			return static_cast<int>(SCIPcolGetBasisStatus(col));
+		});
+		std::transform(lp_rows.begin(), lp_rows.end(), std::back_inserter(lp.row_basis), [](auto* row) {
+			return static_cast<int>(SCIProwGetBasisStatus(row));
+		});
+	}
+	return lp;
+}
+
+/** Set a parameter of the LP interface, if it is supported. */
+void set_lpi_param(SCIP_LPI* lpi, SCIP_LPPARAM param, SCIP_Real value) {
+	auto const retcode = SCIPlpiSetRealpar(lpi, param, value);
+	if (retcode != SCIP_OKAY && retcode != SCIP_PARAMETERUNKNOWN) {
+		throw scip::ScipError::from_retcode(retcode);
+	}
+}
+
+/** An LP interface loaded with the node LP, in which the bounds of one column are changed at a time. */
+class LpCopy {
+public:
+	/** Load the LP and solve it, warm started from the basis of SCIP. */
+	LpCopy(NodeLp const& lp, SCIP_MESSAGEHDLR* messagehdlr) :
+		lpi{scip::create_lpi(messagehdlr, "strong-branching", SCIP_OBJSEN_MINIMIZE)},
+		lower_bounds{to_lpi(lp.lower_bounds)},
+		upper_bounds{to_lpi(lp.upper_bounds)} {
+		auto const n_cols = static_cast<int>(lp.objective.size());
+		auto const n_rows = static_cast<int>(lp.lhs.size());
+		set_lpi_param(lpi.get(), SCIP_LPPAR_FEASTOL, lp.feastol);
+		set_lpi_param(lpi.get(), SCIP_LPPAR_DUALFEASTOL, lp.dualfeastol);
+		scip::call(
+			SCIPlpiAddCols,
+			lpi.get(),
+			n_cols,
+			lp.objective.data(),
+			lower_bounds.data(),
+			upper_bounds.data(),
+			nullptr,
+			0,
+			nullptr,
+			nullptr,
+			nullptr);
+		if (n_rows > 0) {
+			auto const lhs = to_lpi(lp.lhs);
+			auto const rhs = to_lpi(lp.rhs);
+			scip::call(
+				SCIPlpiAddRows,
+				lpi.get(),
+				n_rows,
+				lhs.data(),
+				rhs.data(),
+				nullptr,
+				static_cast<int>(lp.values.size()),
+				lp.row_begins.data(),
+				lp.col_indices.data(),
+				lp.values.data());
+		}
+		if (!lp.col_basis.empty()) {
+			scip::call(SCIPlpiSetBase, lpi.get(), lp.col_basis.data(), lp.row_basis.data());
+		}
+
+		scip::call(SCIPlpiSolveDual, lpi.get());
+		if (SCIPlpiIsOptimal(lpi.get()) != FALSE) {
+			scip::call(SCIPlpiGetObjval, lpi.get(), &objective_value);
+			col_basis.resize(static_cast<std::size_t>(n_cols));
+			row_basis.resize(static_cast<std::size_t>(n_rows));
+			scip::call(SCIPlpiGetBase, lpi.get(), col_basis.data(), row_basis.data());
+		}
+	}
+
+	/** The objective value of the node LP in this copy, NaN if it could not be solved. */
+	[[nodiscard]] auto node_objective_value() const noexcept { return objective_value; }
+
+	/**
+	 * The objective value of the LP with new bounds on a column.
+	 *
+	 * The value is infinite if the LP is infeasible, and NaN if it could not be solved.
+	 * The bounds and basis of the node LP are restored afterwards.
+	 */
+	auto child_objective_value(int col, SCIP_Real lb, SCIP_Real ub) -> SCIP_Real {
+		auto const col_idx = static_cast<std::size_t>(col);
+		// Branching on an integral value at one of the bounds leaves an empty domain for one of the children
+		if ((lb > upper_bounds[col_idx]) || (ub < lower_bounds[col_idx])) {
+			return std::numeric_limits<SCIP_Real>::infinity();
+		}
+		lb = std::max(lb, lower_bounds[col_idx]);
+		ub = std::min(ub, upper_bounds[col_idx]);
+		scip::call(SCIPlpiChgBounds, lpi.get(), 1, &col, &lb, &ub);
+		scip::call(SCIPlpiSolveDual, lpi.get());
+
+		auto value = std::numeric_limits<SCIP_Real>::quiet_NaN();
+		if (SCIPlpiIsOptimal(lpi.get()) != FALSE) {
+			scip::call(SCIPlpiGetObjval, lpi.get(), &value);
+		} else if (SCIPlpiIsPrimalInfeasible(lpi.get()) != FALSE) {
+			value = std::numeric_limits<SCIP_Real>::infinity();
+		}
+
+		scip::call(SCIPlpiChgBounds, lpi.get(), 1, &col, &lower_bounds[col_idx], &upper_bounds[col_idx]);
+		scip::call(SCIPlpiSetBase, lpi.get(), col_basis.data(), row_basis.data());
+		return value;
+	}
+
+private:
+	scip::LpiPtr lpi;
+	std::vector<SCIP_Real> lower_bounds;
+	std::vector<SCIP_Real> upper_bounds;
+	std::vector<int> col_basis;
+	std::vector<int> row_basis;
+	SCIP_Real objective_value = std::numeric_limits<SCIP_Real>::quiet_NaN();
+
+	[[nodiscard]] auto to_lpi(std::vector<SCIP_Real> values) const -> std::vector<SCIP_Real> {
+		auto const infinity = SCIPlpiInfinity(lpi.get());
+		for (auto& value : values) {
+			if (std::isinf(value)) {
+				value = std::copysign(infinity, value);
+			}
+		}
+		return values;
+	}
+};
+
+/** A candidate with the bounds of its children, computed in SCIP numerics. */
+struct Candidate {
+	SCIP_VAR* var;
+	int col;
+	SCIP_Real down_ub;
+	SCIP_Real up_lb;
+};
+
+auto get_candidates(SCIP* const scip, bool pseudo_candidates) -> std::vector<Candidate> {
+	SCIP_VAR** vars = nullptr;
+	int n_vars = 0;
+	if (pseudo_candidates) {
+		scip::call(SCIPgetPseudoBranchCands, scip, &vars, &n_vars, nullptr);
+	} else {
+		scip::call(SCIPgetLPBranchCands, scip, &vars, nullptr, nullptr, &n_vars, nullptr, nullptr);
+	}
+
+	auto candidates = std::vector<Candidate>{};
+	candidates.reserve(static_cast<std::size_t>(n_vars));
+	for (auto* const var : nonstd::span{vars, static_cast<std::size_t>(n_vars)}) {
+		if (SCIPvarGetStatus(var) != SCIP_VARSTATUS_COLUMN || SCIPcolGetLPPos(SCIPvarGetCol(var)) < 0) {
+			continue;
+		}
+		// Same children as SCIP strong branching, for fractional and integral values
+		auto const value = SCIPvarGetLPSol(var);
+		candidates.push_back(
+			{var, SCIPcolGetLPPos(SCIPvarGetCol(var)), SCIPfeasCeil(scip, value - 1.), SCIPfeasFloor(scip, value + 1.)});
+	}
+	return candidates;
+}
+
+/**
+ * Score the candidates by solving their children on copies of the node LP in the worker threads.
+ *
+ * The children are solved without iteration limit, and their objective values are bounded by the cutoff bound and
+ * the node LP objective value, as done by SCIP strong branching.
+ * Children are solved independently, without the bound tightening and cutoffs that idempotent strong branching also
+ * skips.
+ */
+void set_parallel_scores(
+	xt::xtensor<double, 1>& scores,
+	SCIP* const scip,
+	bool pseudo_candidates,
+	utility::ThreadPool& thread_pool) {
+	if (SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL) {
+		return;
+	}
+	auto const candidates = get_candidates(scip, pseudo_candidates);
+	if (candidates.empty()) {
+		return;
+	}
+
+	auto const node_lp = copy_node_lp(scip);
+	auto* const messagehdlr = SCIPgetMessagehdlr(scip);
+	auto const lp_objective = SCIPgetLPObjval(scip);
+	auto const nan = std::numeric_limits<SCIP_Real>::quiet_NaN();
+	auto down_values = std::vector<SCIP_Real>(candidates.size(), nan);
+	auto up_values = std::vector<SCIP_Real>(candidates.size(), nan);
+
+	// Candidates are handed out dynamically as the time to solve children varies a lot
+	auto next_candidate = std::atomic<std::size_t>{0};
+	auto const n_workers = std::min(thread_pool.n_threads(), candidates.size());
+	thread_pool.parallel_for(n_workers, [&](std::size_t /*worker*/) {
+		auto lp = LpCopy{node_lp, messagehdlr};
+		// Values are shifted in the objective space of SCIP, which also accounts for loose variables
+		auto const offset = lp_objective - lp.node_objective_value();
+		if (std::isnan(offset)) {
+			return;
+		}
+		for (auto i = next_candidate++; i < candidates.size(); i = next_candidate++) {
+			auto const& cand = candidates[i];
+			auto const inf = std::numeric_limits<SCIP_Real>::infinity();
+			down_values[i] = lp.child_objective_value(cand.col, -inf, cand.down_ub) + offset;
+			up_values[i] = lp.child_objective_value(cand.col, cand.up_lb, inf) + offset;
+		}
+	});
+
+	auto const cutoff = SCIPgetCutoffbound(scip);
+	auto const gain = [cutoff, lp_objective](SCIP_Real value) {
+		return std::max(std::min(value, cutoff), lp_objective) - lp_objective;
+	};
+	for (auto const [cand, down, up] : views::zip(candidates, down_values, up_values)) {
+		if (std::isnan(down) || std::isnan(up)) {
+			continue;
+		}
+		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(cand.var));
+		scores[var_index] = SCIPgetBranchScore(scip, cand.var, gain(down), gain(up));
+	}
+}
+
 }  // namespace
 
-StrongBranchingScores::StrongBranchingScores(bool pseudo_candidates_) : pseudo_candidates(pseudo_candidates_) {}
+StrongBranchingScores::StrongBranchingScores(bool pseudo_candidates_, std::size_t n_threads) :
+	pseudo_candidates(pseudo_candidates_),
+	thread_pool(n_threads > 0 ? std::make_shared<utility::ThreadPool>(n_threads) : nullptr) {}
+
+void StrongBranchingScores::before_reset(scip::Model& model) {
+	// Looked up again at every episode, since a new model can be allocated at the address of a freed one
+	vanilla_params = find_vanilla_params(model.get_scip_ptr());
+	params_scip = model.get_scip_ptr();
+}
 
 std::optional<xt::xtensor<double, 1>> StrongBranchingScores::extract(scip::Model& model, bool /* done */) const {
 	if (model.stage() != SCIP_STAGE_SOLVING) {
@@ -38,44 +407,16 @@ std::optional<xt::xtensor<double, 1>> StrongBranchingScores::extract(scip::Model
 	}
 
 	auto* const scip = model.get_scip_ptr();
-
-	/* store original SCIP parameters */
-	auto const integralcands = model.get_param<bool>("branching/vanillafullstrong/integralcands");
-	auto const scoreall = model.get_param<bool>("branching/vanillafullstrong/scoreall");
-	auto const collectscores = model.get_param<bool>("branching/vanillafullstrong/collectscores");
-	auto const donotbranch = model.get_param<bool>("branching/vanillafullstrong/donotbranch");
-	auto const idempotent = model.get_param<bool>("branching/vanillafullstrong/idempotent");
-
-	/* set parameters for vanilla full strong branching  */
-	model.set_param("branching/vanillafullstrong/integralcands", pseudo_candidates);
-	model.set_param("branching/vanillafullstrong/scoreall", true);
-	model.set_param("branching/vanillafullstrong/collectscores", true);
-	model.set_param("branching/vanillafullstrong/donotbranch", true);
-	model.set_param("branching/vanillafullstrong/idempotent", true);
-
-	/* execute vanilla full strong branching */
-	auto* branchrule = SCIPfindBranchrule(scip, "vanillafullstrong");
-	SCIP_RESULT result;
-	scip::call(branchrule->branchexeclp, scip, branchrule, false, &result);
-	assert(result == SCIP_DIDNOTRUN);
-	auto const [cands, cands_scores] = scip_get_vanillafullstrong_data(scip);
-
-	/* restore model parameters */
-	model.set_param("branching/vanillafullstrong/integralcands", integralcands);
-	model.set_param("branching/vanillafullstrong/scoreall", scoreall);
-	model.set_param("branching/vanillafullstrong/collectscores", collectscores);
-	model.set_param("branching/vanillafullstrong/donotbranch", donotbranch);
-	model.set_param("branching/vanillafullstrong/idempotent", idempotent);
-
-	/* Store strong branching scores in tensor */
 	auto const nb_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
 	auto strong_branching_scores = xt::xtensor<double, 1>({nb_vars}, std::nan(""));
 
-	for (auto const [var, score] : views::zip(cands, cands_scores)) {
-		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
-		strong_branching_scores[var_index] = static_cast<double>(score);
+	if (thread_pool != nullptr) {
+		set_parallel_scores(strong_branching_scores, scip, pseudo_candidates, *thread_pool);
+	} else {
+		// Handles are looked up again if the function was not reset with this model
+		auto const params = (scip == params_scip) ? vanilla_params : find_vanilla_params(scip);
+		set_vanillafullstrong_scores(strong_branching_scores, scip, params, pseudo_candidates);
 	}
-
 	return strong_branching_scores;
 }
 
@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <variant>
+
+#include <scip/scip.h>
+
+#include "ecole/scip/compiled-params.hpp"
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+#include "ecole/utility/unreachable.hpp"
+
+#include "scip/param-handle.hpp"
+
+namespace ecole::scip {
+
+namespace {
+
+/** Convert the value to the exact type of the parameter. */
+auto convert(SCIP_PARAM* param, Param const& value) -> Param {
+	using internal::cast;
+	switch (SCIPparamGetType(param)) {
+	case SCIP_PARAMTYPE_BOOL:
+		return cast<bool>(value);
+	case SCIP_PARAMTYPE_INT:
+		return cast<int>(value);
+	case SCIP_PARAMTYPE_LONGINT:
+		return cast<SCIP_Longint>(value);
+	case SCIP_PARAMTYPE_REAL:
+		return cast<SCIP_Real>(value);
+	case SCIP_PARAMTYPE_CHAR:
+		return cast<char>(value);
+	case SCIP_PARAMTYPE_STRING:
+		return cast<std::string>(value);
+	default:
+		utility::unreachable();
+	}
+}
+
+auto is_valid(SCIP* scip, SCIP_PARAM* param, bool value) -> bool {
+	return SCIPisBoolParamValid(scip, param, static_cast<SCIP_Bool>(value)) != FALSE;
+}
+auto is_valid(SCIP* scip, SCIP_PARAM* param, int value) -> bool {
+	return SCIPisIntParamValid(scip, param, value) != FALSE;
+}
+auto is_valid(SCIP* scip, SCIP_PARAM* param, SCIP_Longint value) -> bool {
+	return SCIPisLongintParamValid(scip, param, value) != FALSE;
+}
+auto is_valid(SCIP* scip, SCIP_PARAM* param, SCIP_Real value) -> bool {
+	return SCIPisRealParamValid(scip, param, value) != FALSE;
+}
+auto is_valid(SCIP* scip, SCIP_PARAM* param, char value) -> bool {
+	return SCIPisCharParamValid(scip, param, value) != FALSE;
+}
+auto is_valid(SCIP* scip, SCIP_PARAM* param, std::string const& value) -> bool {
+	return SCIPisStringParamValid(scip, param, value.c_str()) != FALSE;
+}
+
+}  // namespace
+
+/**************************************
+ *  Implementation of CompiledParams  *
+ **************************************/
+
+CompiledParams::CompiledParams(Model const& model, std::map<std::string, Param> const& name_values) {
+	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
+	auto const params = get_params_span(scip);
+	n_params = params.size();
+	entries.reserve(name_values.size());
+	for (auto const& [name, value] : name_values) {
+		auto* const param = SCIPgetParam(scip, name.c_str());
+		if (param == nullptr) {
+			throw ScipError::from_retcode(SCIP_PARAMETERUNKNOWN);
+		}
+		auto converted = convert(param, value);
+		if (!std::visit([&](auto const& val) { return is_valid(scip, param, val); }, converted)) {
+			throw ScipError::from_retcode(SCIP_PARAMETERWRONGVAL);
+		}
+		// Parameters are stored in the order they were added by the plugins
+		auto const index = static_cast<std::size_t>(std::find(params.begin(), params.end(), param) - params.begin());
+		entries.push_back({name, index, std::move(converted)});
+	}
+}
+
+void CompiledParams::apply(Model& model) const {
+	auto* const scip = model.get_scip_ptr();
+	auto const params = get_params_span(scip);
+	auto const same_params = params.size() == n_params;
+	for (auto const& entry : entries) {
+		auto* param = same_params ? params[entry.index] : nullptr;
+		// Comparing the name guards against plugins included in a different order
+		if (param == nullptr || entry.name != SCIPparamGetName(param)) {
+			param = SCIPgetParam(scip, entry.name.c_str());
+		}
+		if (param == nullptr) {
+			throw ScipError::from_retcode(SCIP_PARAMETERUNKNOWN);
+		}
+		if (!has_type_of(param, entry.value)) {
+			throw ScipError::from_retcode(SCIP_PARAMETERWRONGTYPE);
+		}
+		change(scip, param, entry.value);
+	}
+}
+
+}  // namespace ecole::scip
@@ -1,6 +1,11 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <fmt/format.h>
 #include <stdexcept>
+#include <utility>
 #include <xtensor/xadapt.hpp>
 #include <xtensor/xnorm.hpp>
 #include <xtensor/xtensor.hpp>
@@ -168,181 +173,295 @@ auto get_vars_linear(SCIP const* scip, SCIP_CONS const* cons) noexcept -> nonstd
 	};
 }
 
+namespace {
+
+/** Reusable buffers holding the coefficients of a linear constraint in terms of active variables. */
+struct LinearRow {
+	std::vector<SCIP_VAR*> variables;
+	std::vector<SCIP_Real> coefficients;
+	/** The number of coefficients of the constraint, at the beginning of the buffers. */
+	std::size_t size = 0;
+	SCIP_Real constant_offset = 0.;
+};
+
 /**
- * Obtains the variables involved in a linear constraint and their coefficients in the constraint
+ * Read the variables and coefficients of a linear constraint in the buffers.
+ *
+ * The buffers are only grown when they are too small, so that reading many constraints does not allocate for each of
+ * them.
+ * Return false if the constraint cannot be expressed as a linear constraint.
  */
-auto get_constraint_linear_coefs(SCIP* const scip, SCIP_CONS* const constraint) -> std::optional<
-	std::tuple<std::vector<SCIP_VAR*>, std::vector<SCIP_Real>, std::optional<SCIP_Real>, std::optional<SCIP_Real>>> {
+auto read_linear_row(SCIP* const scip, SCIP_CONS* const constraint, LinearRow& row) -> bool {
 	SCIP_Bool success = false;
-	int n_constraint_variables;
-	int n_active_variables;
-	SCIP_Real constant_offset = 0;
-	int requiredsize = 0;
-
-	// Find how many active variables and constraint variables there are (for allocation)
+	int n_constraint_variables = 0;
 	scip::call(SCIPgetConsNVars, scip, constraint, &n_constraint_variables, &success);
 	if (!success) {
-		return std::nullopt;
+		return false;
 	}
-	n_active_variables = SCIPgetNVars(scip);
 
-	// Allocate buffers large enough to hold future variables and coefficients
-	auto const buffer_size = static_cast<std::size_t>(std::max(n_constraint_variables, n_active_variables));
-	auto variables = std::vector<SCIP_VAR*>(buffer_size);
-	auto coefficients = std::vector<SCIP_Real>(buffer_size);
+	// Large enough for the constraint variables and for their re-expression in terms of active variables
+	auto const buffer_size = static_cast<std::size_t>(std::max(n_constraint_variables, SCIPgetNVars(scip)));
+	if (row.variables.size() < buffer_size) {
+		row.variables.resize(buffer_size);
+		row.coefficients.resize(buffer_size);
+	}
 
-	// Get the variables and their coefficients in the constraint
-	scip::call(SCIPgetConsVars, scip, constraint, variables.data(), static_cast<int>(buffer_size), &success);
+	auto const n_buffer = static_cast<int>(row.variables.size());
+	scip::call(SCIPgetConsVars, scip, constraint, row.variables.data(), n_buffer, &success);
 	if (!success) {
-		return std::nullopt;
+		return false;
 	}
-	scip::call(SCIPgetConsVals, scip, constraint, coefficients.data(), static_cast<int>(buffer_size), &success);
+	scip::call(SCIPgetConsVals, scip, constraint, row.coefficients.data(), n_buffer, &success);
 	if (!success) {
-		return std::nullopt;
+		return false;
 	}
 
 	// If we are in SCIP_STAGE_TRANSFORMED or later, the variables in the constraint might be inactive
 	// Re-express the coefficients in terms of active variables
+	row.constant_offset = 0.;
 	if (SCIPgetStage(scip) >= SCIP_STAGE_TRANSFORMED) {
+		int requiredsize = 0;
 		scip::call(
 			SCIPgetProbvarLinearSum,
 			scip,
-			variables.data(),
-			coefficients.data(),
+			row.variables.data(),
+			row.coefficients.data(),
 			&n_constraint_variables,
-			static_cast<int>(buffer_size),
-			&constant_offset,
+			n_buffer,
+			&row.constant_offset,
 			&requiredsize,
 			true);
 	}
 
-	variables.resize(static_cast<std::size_t>(n_constraint_variables));
-	coefficients.resize(static_cast<std::size_t>(n_constraint_variables));
+	row.size = static_cast<std::size_t>(n_constraint_variables);
+	return true;
+}
 
-	// Obtain the left and right hand side if their are finite and shift them accordingly.
+/** Obtain the left and right hand side if their are finite and shift them by the constant of the constraint. */
+auto get_shifted_sides(SCIP* const scip, SCIP_CONS* const constraint, SCIP_Real constant_offset)
+	-> std::pair<std::optional<SCIP_Real>, std::optional<SCIP_Real>> {
 	auto lhs = scip::cons_get_finite_lhs(scip, constraint);
 	if (lhs.has_value()) {
 		lhs = lhs.value() - constant_offset;
 	}
-
 	auto rhs = scip::cons_get_finite_rhs(scip, constraint);
 	if (rhs.has_value()) {
 		rhs = rhs.value() - constant_offset;
 	}
+	return {lhs, rhs};
+}
 
-	return {{variables, coefficients, lhs, rhs}};
+auto non_linear_constraint_error(SCIP_CONS* const constraint) -> ScipError {
+	return ScipError(fmt::format(
+		"Constraint {} cannot be expressed as a single linear constraint (type \"{}\"), MilpBipartite observation "
+		"cannot be extracted.",
+		SCIPconsGetPos(constraint),
+		SCIPconshdlrGetName(SCIPconsGetHdlr(constraint))));
+}
+
+}  // namespace
+
+/**
+ * Obtains the variables involved in a linear constraint and their coefficients in the constraint
+ */
+auto get_constraint_linear_coefs(SCIP* const scip, SCIP_CONS* const constraint) -> std::optional<
+	std::tuple<std::vector<SCIP_VAR*>, std::vector<SCIP_Real>, std::optional<SCIP_Real>, std::optional<SCIP_Real>>> {
+	auto row = LinearRow{};
+	if (!read_linear_row(scip, constraint, row)) {
+		return std::nullopt;
+	}
+	row.variables.resize(row.size);
+	row.coefficients.resize(row.size);
+	auto [lhs, rhs] = get_shifted_sides(scip, constraint, row.constant_offset);
+	return {{std::move(row.variables), std::move(row.coefficients), lhs, rhs}};
 }
 
 auto get_constraint_coefs(SCIP* const scip, SCIP_CONS* const constraint)
 	-> std::tuple<std::vector<SCIP_VAR*>, std::vector<SCIP_Real>, std::optional<SCIP_Real>, std::optional<SCIP_Real>> {
 	auto constraint_data = get_constraint_linear_coefs(scip, constraint);
 	if (constraint_data.has_value()) {  // Constraint must be linear
-		return constraint_data.value();
+		return std::move(constraint_data).value();
 	}
-	throw ScipError(fmt::format(
-		"Constraint {} cannot be expressed as a single linear constraint (type \"{}\"), MilpBipartite observation "
-		"cannot be extracted.",
-		SCIPconsGetPos(constraint),
-		SCIPconshdlrGetName(SCIPconsGetHdlr(constraint))));
+	throw non_linear_constraint_error(constraint);
 }
 
-SCIP_Real cons_l2_norm(std::vector<SCIP_Real> const& constraint_coefs) {
-	auto xt_constraint_coefs = xt::adapt(constraint_coefs, {constraint_coefs.size()});
+namespace {
+
+SCIP_Real cons_l2_norm(nonstd::span<SCIP_Real const> coefficients) {
+	auto xt_constraint_coefs =
+		xt::adapt(coefficients.data(), coefficients.size(), xt::no_ownership(), std::array{coefficients.size()});
 
 	auto const norm = xt::norm_l2(xt_constraint_coefs)();
 	return norm > 0. ? norm : 1.;
 }
 
-auto get_all_constraints(SCIP* const scip, bool normalize, bool include_variable_bounds)
-	-> std::tuple<utility::coo_matrix<SCIP_Real>, xt::xtensor<SCIP_Real, 1>> {
+/**
+ * The coefficients of all constraints in terms of active variables, one after the other.
+ *
+ * Only filled in SCIP_STAGE_TRANSFORMED and later, where re-expressing the constraints is costly, so that it is done
+ * once when counting the non zeros rather than again when writing them.
+ */
+struct ActiveRows {
+	std::vector<SCIP_VAR*> variables;
+	std::vector<SCIP_Real> coefficients;
+	/** Constraint i has its coefficients from ptrs[i] to ptrs[i+1]. */
+	std::vector<std::size_t> ptrs = {0};
+};
+
+}  // namespace
+
+auto get_all_constraints(
+	SCIP* const scip,
+	bool normalize,
+	bool include_variable_bounds,
+	utility::ThreadPool* thread_pool) -> std::tuple<utility::coo_matrix<SCIP_Real>, xt::xtensor<SCIP_Real, 1>> {
 	auto* const variables = SCIPgetVars(scip);
 	auto* const constraints = SCIPgetConss(scip);
 	auto nb_variables = static_cast<std::size_t>(SCIPgetNVars(scip));
 	auto nb_constraints = static_cast<std::size_t>(SCIPgetNConss(scip));
-
-	std::size_t n_rows = 0;
-
-	std::vector<SCIP_Real> values;
-	std::vector<std::size_t> column_indices;
-	std::vector<std::size_t> row_indices;
-	std::vector<SCIP_Real> biases;
-
-	// For each constraint
-	for (std::size_t cons_idx = 0; cons_idx < nb_constraints; ++cons_idx) {
-		auto* const constraint = constraints[cons_idx];
-		auto [constraint_vars, constraint_coefs, lhs, rhs] = get_constraint_coefs(scip, constraint);
-		SCIP_Real const constraint_norm = normalize ? cons_l2_norm(constraint_coefs) : 1.;
-
-		// Inequality has a left hand side?
-		if (lhs.has_value()) {
-			for (std::size_t cons_var_idx = 0; cons_var_idx < std::size(constraint_vars); ++cons_var_idx) {
-				SCIP_Real value = constraint_coefs[cons_var_idx];
-				int var_idx = SCIPvarGetProbindex(constraint_vars[cons_var_idx]);
-
-				values.push_back(-value);
-				row_indices.push_back(n_rows);
-				column_indices.push_back(static_cast<std::size_t>(var_idx));
-			}
-			if (normalize) {
-				biases.push_back(-lhs.value() / constraint_norm);
+	auto const is_transformed = SCIPgetStage(scip) >= SCIP_STAGE_TRANSFORMED;
+
+	// First pass, count the rows and non zeros of every constraint to find where they are written.
+	// Constraint i is written from row row_ptrs[i] and non zero nnz_ptrs[i], and the variable bounds after the last one.
+	// The sides, and the active coefficients once transformed, are kept for the second pass.
+	auto row_ptrs = std::vector<std::size_t>(nb_constraints + 1, 0);
+	auto nnz_ptrs = std::vector<std::size_t>(nb_constraints + 1, 0);
+	auto sides = std::vector<std::pair<std::optional<SCIP_Real>, std::optional<SCIP_Real>>>(nb_constraints);
+	auto active_rows = ActiveRows{};
+	{
+		auto row = LinearRow{};
+		for (std::size_t cons_idx = 0; cons_idx < nb_constraints; ++cons_idx) {
+			auto* const constraint = constraints[cons_idx];
+			auto cons_nnz = std::size_t{0};
+			if (is_transformed) {
+				if (!read_linear_row(scip, constraint, row)) {
+					throw non_linear_constraint_error(constraint);
+				}
+				cons_nnz = row.size;
+				auto const row_end = static_cast<std::ptrdiff_t>(row.size);
+				active_rows.variables.insert(
+					active_rows.variables.end(), row.variables.begin(), row.variables.begin() + row_end);
+				active_rows.coefficients.insert(
+					active_rows.coefficients.end(), row.coefficients.begin(), row.coefficients.begin() + row_end);
+				active_rows.ptrs.push_back(active_rows.variables.size());
+			} else if (auto const n_vars = get_cons_n_vars(scip, constraint); n_vars.has_value()) {
+				// Without re-expression in terms of active variables there is no constant offset
+				cons_nnz = n_vars.value();
+				row.constant_offset = 0.;
 			} else {
-				biases.push_back(-lhs.value());
+				throw non_linear_constraint_error(constraint);
 			}
-			n_rows++;
+			sides[cons_idx] = get_shifted_sides(scip, constraint, row.constant_offset);
+			auto const n_sides =
+				static_cast<std::size_t>(sides[cons_idx].first.has_value()) +
+				static_cast<std::size_t>(sides[cons_idx].second.has_value());
+			row_ptrs[cons_idx + 1] = row_ptrs[cons_idx] + n_sides;
+			nnz_ptrs[cons_idx + 1] = nnz_ptrs[cons_idx] + n_sides * cons_nnz;
 		}
-		// Inequality has a right hand side?
-		if (rhs.has_value()) {
-			for (std::size_t cons_var_idx = 0; cons_var_idx < std::size(constraint_vars); ++cons_var_idx) {
-				SCIP_Real value = constraint_coefs[cons_var_idx];
-				int var_idx = SCIPvarGetProbindex(constraint_vars[cons_var_idx]);
-
-				values.push_back(value);
-				row_indices.push_back(n_rows);
-				column_indices.push_back(static_cast<std::size_t>(var_idx));
-			}
-			if (normalize) {
-				biases.push_back(rhs.value() / constraint_norm);
+	}
+	std::size_t n_bound_rows = 0;
+	if (include_variable_bounds) {
+		for (std::size_t var_idx = 0; var_idx < nb_variables; ++var_idx) {
+			auto const lb = SCIPvarGetLbGlobal(variables[var_idx]);
+			auto const ub = SCIPvarGetUbGlobal(variables[var_idx]);
+			n_bound_rows += static_cast<std::size_t>(!SCIPisInfinity(scip, std::abs(lb)));
+			n_bound_rows += static_cast<std::size_t>(!SCIPisInfinity(scip, std::abs(ub)));
+		}
+	}
+
+	// The matrix and biases are allocated once with their final size
+	auto const n_rows = row_ptrs.back() + n_bound_rows;
+	auto const nnz = nnz_ptrs.back() + n_bound_rows;
+	utility::coo_matrix<SCIP_Real> constraint_matrix{};
+	constraint_matrix.values = decltype(constraint_matrix.values)::from_shape({nnz});
+	constraint_matrix.indices = decltype(constraint_matrix.indices)::from_shape({2, nnz});
+	constraint_matrix.shape = {n_rows, nb_variables};
+	auto constraint_biases = xt::xtensor<SCIP_Real, 1>::from_shape({n_rows});
+
+	// Second pass, every constraint writes its own rows, reusing one buffer per block of constraints
+	auto set_constraints = [&](std::size_t begin, std::size_t end) {
+		auto row = LinearRow{};
+		for (std::size_t cons_idx = begin; cons_idx < end; ++cons_idx) {
+			auto cons_vars = nonstd::span<SCIP_VAR* const>{};
+			auto cons_coefs = nonstd::span<SCIP_Real const>{};
+			if (is_transformed) {
+				auto const first = active_rows.ptrs[cons_idx];
+				auto const size = active_rows.ptrs[cons_idx + 1] - first;
+				cons_vars = {active_rows.variables.data() + first, size};
+				cons_coefs = {active_rows.coefficients.data() + first, size};
 			} else {
-				biases.push_back(rhs.value());
+				auto* const constraint = constraints[cons_idx];
+				if (!read_linear_row(scip, constraint, row)) {
+					throw non_linear_constraint_error(constraint);
+				}
+				cons_vars = {row.variables.data(), row.size};
+				cons_coefs = {row.coefficients.data(), row.size};
+			}
+			auto const& [lhs, rhs] = sides[cons_idx];
+			SCIP_Real const constraint_norm = normalize ? cons_l2_norm(cons_coefs) : 1.;
+
+			auto row_idx = row_ptrs[cons_idx];
+			auto nnz_idx = nnz_ptrs[cons_idx];
+			auto const set_row = [&](SCIP_Real sign, SCIP_Real bias) {
+				for (std::size_t cons_var_idx = 0; cons_var_idx < cons_vars.size(); ++cons_var_idx) {
+					constraint_matrix.values(nnz_idx) = sign * cons_coefs[cons_var_idx];
+					constraint_matrix.indices(0, nnz_idx) = row_idx;
+					constraint_matrix.indices(1, nnz_idx) =
+						static_cast<std::size_t>(SCIPvarGetProbindex(cons_vars[cons_var_idx]));
+					nnz_idx++;
+				}
+				constraint_biases(row_idx) = sign * bias / constraint_norm;
+				row_idx++;
+			};
+			// Inequality has a left hand side?
+			if (lhs.has_value()) {
+				set_row(-1., lhs.value());
+			}
+			// Inequality has a right hand side?
+			if (rhs.has_value()) {
+				set_row(1., rhs.value());
 			}
-			n_rows++;
+			assert(row_idx == row_ptrs[cons_idx + 1]);
+			assert(nnz_idx == nnz_ptrs[cons_idx + 1]);
 		}
+	};
+
+	// Re-expressing constraints in terms of active variables uses SCIP buffer memory, which is not thread safe, but it
+	// was done in the first pass, so the second pass only reads the problem and can run in parallel.
+	if ((thread_pool == nullptr) || (thread_pool->n_threads() < 2)) {
+		set_constraints(0, nb_constraints);
+	} else {
+		auto const n_blocks = thread_pool->n_threads();
+		auto const block_size = (nb_constraints + n_blocks - 1) / n_blocks;
+		thread_pool->parallel_for(n_blocks, [&](std::size_t block) {
+			set_constraints(std::min(block * block_size, nb_constraints), std::min((block + 1) * block_size, nb_constraints));
+		});
 	}
 
 	if (include_variable_bounds) {
 		// Add variable bounds as additional constraints
+		auto row_idx = row_ptrs.back();
+		auto nnz_idx = nnz_ptrs.back();
+		auto const set_bound_row = [&](std::size_t var_idx, SCIP_Real sign, SCIP_Real bias) {
+			constraint_matrix.values(nnz_idx) = sign;
+			constraint_matrix.indices(0, nnz_idx) = row_idx;
+			constraint_matrix.indices(1, nnz_idx) = var_idx;
+			constraint_biases(row_idx) = sign * bias;
+			nnz_idx++;
+			row_idx++;
+		};
 		for (std::size_t var_idx = 0; var_idx < nb_variables; ++var_idx) {
 			auto lb = SCIPvarGetLbGlobal(variables[var_idx]);
 			auto ub = SCIPvarGetUbGlobal(variables[var_idx]);
 			if (!SCIPisInfinity(scip, std::abs(lb))) {
-				values.push_back(-1.);
-				row_indices.push_back(n_rows);
-				column_indices.push_back(static_cast<std::size_t>(var_idx));
-				biases.push_back(-lb);
-				n_rows++;
+				set_bound_row(var_idx, -1., lb);
 			}
 			if (!SCIPisInfinity(scip, std::abs(ub))) {
-				values.push_back(1.);
-				row_indices.push_back(n_rows);
-				column_indices.push_back(static_cast<std::size_t>(var_idx));
-				biases.push_back(ub);
-				n_rows++;
+				set_bound_row(var_idx, 1., ub);
 			}
 		}
 	}
 
-	// Turn values and indices into xt::xarray's
-	auto const nnz = values.size();
-
-	utility::coo_matrix<SCIP_Real> constraint_matrix{};
-	constraint_matrix.values = xt::adapt(std::move(values), {nnz});
-	constraint_matrix.indices = decltype(utility::coo_matrix<SCIP_Real>::indices)::from_shape({2, nnz});
-	xt::row(constraint_matrix.indices, 0) = xt::adapt(std::move(row_indices), {nnz});
-	xt::row(constraint_matrix.indices, 1) = xt::adapt(std::move(column_indices), {nnz});
-	constraint_matrix.shape = {n_rows, nb_variables};
-
-	xt::xtensor<SCIP_Real, 1> constraint_biases = xt::adapt(std::move(biases), {n_rows});
-
 	return std::tuple{std::move(constraint_matrix), std::move(constraint_biases)};
 }
 
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <memory>
+
+#include <lpi/lpi.h>
+#include <scip/scip.h>
+
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::scip {
+
+/** Free an LP interface, as a deleter of std::unique_ptr. */
+struct LpiDeleter {
+	void operator()(SCIP_LPI* lpi) const noexcept { SCIPlpiFree(&lpi); }
+};
+
+using LpiPtr = std::unique_ptr<SCIP_LPI, LpiDeleter>;
+
+/** Create an empty LP interface, independent of the LP of the SCIP model. */
+inline auto create_lpi(SCIP_MESSAGEHDLR* messagehdlr, char const* name, SCIP_OBJSEN objsen) -> LpiPtr {
+	SCIP_LPI* lpi_ptr = nullptr;
+	scip::call(SCIPlpiCreate, &lpi_ptr, messagehdlr, name, objsen);
+	return LpiPtr{lpi_ptr};
+}
+
+}  // namespace ecole::scip
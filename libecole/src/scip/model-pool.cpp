@@ -0,0 +1,215 @@
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <nonstd/span.hpp>
+#include <scip/scip.h>
+#include <scip/scipdefplugins.h>
+
+#include "ecole/scip/model-pool.hpp"
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::scip {
+
+namespace {
+
+/** Maximum number of instances kept for reuse, each holding a few megabytes of plugin data. */
+constexpr std::size_t default_capacity = 8;
+
+/**
+ * Number of parameters, followed by the number of plugins of each type.
+ *
+ * Only compared between instances created by the pool, which all start with the default plugins.
+ * Since SCIP cannot remove plugins, equal counts mean that no plugin was included since.
+ */
+using PluginCounts = std::array<int, 20>;  // NOLINT(readability-magic-numbers)
+
+auto plugin_counts(SCIP* scip) noexcept -> PluginCounts {
+	return {
+		SCIPgetNParams(scip),
+		SCIPgetNReaders(scip),
+		SCIPgetNPricers(scip),
+		SCIPgetNConshdlrs(scip),
+		SCIPgetNConflicthdlrs(scip),
+		SCIPgetNPresols(scip),
+		SCIPgetNRelaxs(scip),
+		SCIPgetNSepas(scip),
+		SCIPgetNCutsels(scip),
+		SCIPgetNProps(scip),
+		SCIPgetNHeurs(scip),
+		SCIPgetNComprs(scip),
+		SCIPgetNEventhdlrs(scip),
+		SCIPgetNNodesels(scip),
+		SCIPgetNBranchrules(scip),
+		SCIPgetNBenders(scip),
+		SCIPgetNDisps(scip),
+		SCIPgetNTables(scip),
+		SCIPgetNNlpis(scip),
+		SCIPgetNExprhdlrs(scip),
+	};
+}
+
+/** Instances ready to be reused, freed when the program exits. */
+struct Pool {
+	std::mutex mutex;
+	std::vector<SCIP*> instances;
+	std::size_t capacity = default_capacity;
+	/** Plugins of an instance created by the pool, known once the first one is created. */
+	std::optional<PluginCounts> default_counts;
+	/**
+	 * All instances created by the pool and not freed yet, whether in use or in the pool, with their message handler.
+	 *
+	 * Only these instances are recycled, so that instances created otherwise are never handed out as default ones.
+	 */
+	std::unordered_map<SCIP*, SCIP_MESSAGEHDLR*> created;
+
+	Pool() = default;
+	Pool(Pool const&) = delete;
+	Pool(Pool&&) = delete;
+	auto operator=(Pool const&) -> Pool& = delete;
+	auto operator=(Pool&&) -> Pool& = delete;
+	~Pool() { clear(); }
+
+	/** Free an instance and forget it, the lock must be held. */
+	void free(SCIP* scip) noexcept {
+		created.erase(scip);
+		SCIPfree(&scip);
+	}
+
+	/** Free the instances in excess of the given number, the lock must be held. */
+	void shrink_to(std::size_t size) noexcept {
+		while (instances.size() > size) {
+			auto* const scip = instances.back();
+			instances.pop_back();
+			free(scip);
+		}
+	}
+
+	void clear() noexcept { shrink_to(0); }
+};
+
+auto pool() -> Pool& {
+	static auto instance = Pool{};
+	return instance;
+}
+
+/**
+ * Free the problem and set the instance back to its state after creation, leaving it in SCIP_STAGE_INIT.
+ *
+ * SCIPfreeProb is used rather than SCIPfreeTransform, which would keep the original problem in the instance.
+ * SCIPfreeProb frees the transformed problem first.
+ * Besides parameters, the only state reset is the one of the message handler, which Model changes.
+ */
+auto recycle(SCIP* scip) noexcept -> bool {
+	if (SCIPfreeProb(scip) != SCIP_OKAY) {
+		return false;
+	}
+	SCIPsetMessagehdlrQuiet(scip, FALSE);
+	SCIPsetMessagehdlrLogfile(scip, nullptr);
+	// Only look up by name the few parameters that changed
+	auto const params = nonstd::span{SCIPgetParams(scip), static_cast<std::size_t>(SCIPgetNParams(scip))};
+	for (auto* const param : params) {
+		if ((SCIPparamIsFixed(param) != FALSE) && (SCIPunfixParam(scip, SCIPparamGetName(param)) != SCIP_OKAY)) {
+			return false;
+		}
+		if ((SCIPparamIsDefault(param) == FALSE) && (SCIPresetParam(scip, SCIPparamGetName(param)) != SCIP_OKAY)) {
+			return false;
+		}
+	}
+	return SCIPgetStage(scip) == SCIP_STAGE_INIT;
+}
+
+}  // namespace
+
+/*********************************
+ *  Implementation of ModelPool  *
+ *********************************/
+
+auto ModelPool::acquire() -> std::unique_ptr<SCIP, ScipDeleter> {
+	auto& model_pool = pool();
+	{
+		auto g = std::lock_guard{model_pool.mutex};
+		if (!model_pool.instances.empty()) {
+			auto* const scip = model_pool.instances.back();
+			model_pool.instances.pop_back();
+			return {scip, ScipDeleter{true}};
+		}
+	}
+
+	// Created outside of the critical section since it does not access the pool.
+	SCIP* scip_raw = nullptr;
+	scip::call(SCIPcreate, &scip_raw);
+	auto scip_ptr = std::unique_ptr<SCIP, ScipDeleter>{scip_raw, ScipDeleter{true}};
+	scip::call(SCIPincludeDefaultPlugins, scip_ptr.get());
+	auto const counts = plugin_counts(scip_ptr.get());
+	auto g = std::lock_guard{model_pool.mutex};
+	if (!model_pool.default_counts.has_value()) {
+		model_pool.default_counts = counts;
+	}
+	model_pool.created.emplace(scip_ptr.get(), SCIPgetMessagehdlr(scip_ptr.get()));
+	return scip_ptr;
+}
+
+void ModelPool::release(SCIP* scip) noexcept {
+	if (scip == nullptr) {
+		return;
+	}
+	auto& model_pool = pool();
+	// Checked before recycling to avoid resetting an instance that would be freed, and again after under the lock.
+	if (size() < capacity() && has_default_plugins(scip) && recycle(scip)) {
+		auto g = std::lock_guard{model_pool.mutex};
+		if (model_pool.instances.size() < model_pool.capacity) {
+			try {
+				model_pool.instances.push_back(scip);
+				return;
+			} catch (...) {
+				// Could not record the instance for reuse, free it instead.
+			}
+		}
+		model_pool.free(scip);
+		return;
+	}
+	auto g = std::lock_guard{model_pool.mutex};
+	model_pool.free(scip);
+}
+
+auto ModelPool::has_default_plugins(SCIP* scip) -> bool {
+	auto const counts = plugin_counts(scip);
+	auto* const messagehdlr = SCIPgetMessagehdlr(scip);
+	auto& model_pool = pool();
+	auto g = std::lock_guard{model_pool.mutex};
+	auto const iter = model_pool.created.find(scip);
+	// A replaced message handler cannot be set back, so such instances are not recycled either.
+	return (iter != model_pool.created.end()) && (iter->second == messagehdlr) && (model_pool.default_counts == counts);
+}
+
+auto ModelPool::size() noexcept -> std::size_t {
+	auto& model_pool = pool();
+	auto g = std::lock_guard{model_pool.mutex};
+	return model_pool.instances.size();
+}
+
+auto ModelPool::capacity() noexcept -> std::size_t {
+	auto& model_pool = pool();
+	auto g = std::lock_guard{model_pool.mutex};
+	return model_pool.capacity;
+}
+
+void ModelPool::set_capacity(std::size_t capacity) noexcept {
+	auto& model_pool = pool();
+	auto g = std::lock_guard{model_pool.mutex};
+	model_pool.capacity = capacity;
+	model_pool.shrink_to(capacity);
+}
+
+void ModelPool::clear() noexcept {
+	auto& model_pool = pool();
+	auto g = std::lock_guard{model_pool.mutex};
+	model_pool.clear();
+}
+
+}  // namespace ecole::scip
@@ -1,29 +1,36 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <iterator>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <fmt/format.h>
 #include <range/v3/view/move.hpp>
 #include <scip/scip.h>
-#include <scip/scipdefplugins.h>
 
 #include "ecole/scip/callback.hpp"
+#include "ecole/scip/compiled-params.hpp"
+#include "ecole/scip/cons.hpp"
 #include "ecole/scip/exception.hpp"
+#include "ecole/scip/model-pool.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/scimpl.hpp"
 #include "ecole/scip/utils.hpp"
 #include "ecole/utility/unreachable.hpp"
 
+#include "scip/param-handle.hpp"
+#include "utility/hash.hpp"
+
 namespace ecole::scip {
 
-Model::Model() : Model{std::make_unique<Scimpl>()} {
-	scip::call(SCIPincludeDefaultPlugins, get_scip_ptr());
-}
+Model::Model() : Model{std::make_unique<Scimpl>(ModelPool::acquire())} {}
 
 Model::Model(Model&&) noexcept = default;
 
@@ -50,6 +57,10 @@ Model Model::copy_orig() const {
 	return std::make_unique<Scimpl>(scimpl->copy_orig());
 }
 
+Model Model::fork() const {
+	return std::make_unique<Scimpl>(scimpl->fork());
+}
+
 bool Model::operator==(Model const& other) const noexcept {
 	return scimpl == other.scimpl;
 }
@@ -173,21 +184,15 @@ void Model::set_params(std::map<std::string, Param> name_values) {
 	}
 }
 
-namespace {
-
-nonstd::span<SCIP_PARAM*> get_params_span(Model const& model) noexcept {
-	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
-	return {SCIPgetParams(scip), static_cast<std::size_t>(SCIPgetNParams(scip))};
+void Model::set_params(CompiledParams const& params) {
+	params.apply(*this);
 }
 
-}  // namespace
-
 std::map<std::string, Param> Model::get_params() const {
 	std::map<std::string, Param> name_values{};
-	for (auto* const param : get_params_span(*this)) {
-		auto name = std::string{SCIPparamGetName(param)};
-		auto value = get_param<Param>(name);
-		name_values.insert({std::move(name), std::move(value)});
+	// Read values through their handle rather than looking up each name
+	for (auto* const param : get_params_span(const_cast<SCIP*>(get_scip_ptr()))) {
+		name_values.emplace(SCIPparamGetName(param), get_value(param));
 	}
 	return name_values;
 }
@@ -244,6 +249,91 @@ std::size_t Model::nnz() const noexcept {
 	return static_cast<std::size_t>(SCIPgetNNZs(const_cast<SCIP*>(get_scip_ptr())));
 }
 
+namespace {
+
+void hash_var(utility::Hasher& hasher, SCIP_VAR* var) {
+	hasher.add(SCIPvarGetType(var)).add(SCIPvarGetObj(var));
+	hasher.add(SCIPvarGetLbGlobal(var)).add(SCIPvarGetUbGlobal(var));
+	hasher.add(SCIPvarGetLbLocal(var)).add(SCIPvarGetUbLocal(var));
+}
+
+void hash_side(utility::Hasher& hasher, std::optional<SCIP_Real> side) {
+	hasher.add(side.has_value()).add(side.value_or(0.));
+}
+
+void hash_constraints(utility::Hasher& hasher, SCIP* scip, nonstd::span<SCIP_CONS*> constraints) {
+	hasher.add(constraints.size());
+	// Buffers are reused for all constraints
+	auto vars = std::vector<SCIP_VAR*>{};
+	auto vals = std::vector<SCIP_Real>{};
+	for (auto* const cons : constraints) {
+		hasher.add(std::string_view{SCIPconshdlrGetName(SCIPconsGetHdlr(cons))});
+		auto const n_vars = get_cons_n_vars(scip, cons);
+		if (!n_vars.has_value()) {
+			continue;
+		}
+		if (vars.size() < n_vars.value()) {
+			vars.resize(n_vars.value());
+			vals.resize(n_vars.value());
+		}
+		auto const vars_span = nonstd::span<SCIP_VAR*>{vars.data(), n_vars.value()};
+		auto const vals_span = nonstd::span<SCIP_Real>{vals.data(), n_vars.value()};
+		if (!get_cons_vars(scip, cons, vars_span) || !get_cons_vals(scip, cons, vals_span)) {
+			continue;
+		}
+		hasher.add(n_vars.value());
+		for (std::size_t i = 0; i < n_vars.value(); ++i) {
+			hasher.add(SCIPvarGetIndex(vars[i])).add(vals[i]);
+		}
+		hash_side(hasher, cons_get_lhs(scip, cons));
+		hash_side(hasher, cons_get_rhs(scip, cons));
+	}
+}
+
+void hash_lp(utility::Hasher& hasher, nonstd::span<SCIP_COL*> columns, nonstd::span<SCIP_ROW*> rows) {
+	hasher.add(columns.size());
+	for (auto* const col : columns) {
+		hasher.add(SCIPvarGetIndex(SCIPcolGetVar(col)));
+		hasher.add(SCIPcolGetLb(col)).add(SCIPcolGetUb(col)).add(SCIPcolGetObj(col));
+	}
+	hasher.add(rows.size());
+	for (auto* const row : rows) {
+		hasher.add(SCIProwGetLhs(row)).add(SCIProwGetRhs(row)).add(SCIProwGetConstant(row));
+		auto const n_nonzeros = static_cast<std::size_t>(SCIProwGetNNonz(row));
+		auto* const row_cols = SCIProwGetCols(row);
+		auto* const row_vals = SCIProwGetVals(row);
+		hasher.add(n_nonzeros);
+		for (std::size_t i = 0; i < n_nonzeros; ++i) {
+			hasher.add(SCIPcolGetIndex(row_cols[i])).add(row_vals[i]);
+		}
+	}
+}
+
+}  // namespace
+
+std::uint64_t Model::fingerprint() const {
+	auto* const scip_ptr = const_cast<SCIP*>(get_scip_ptr());
+	auto hasher = utility::Hasher{};
+
+	auto const vars = variables();
+	hasher.add(vars.size());
+	for (auto* const var : vars) {
+		hash_var(hasher, var);
+	}
+
+	hasher.add(SCIPgetObjsense(scip_ptr)).add(SCIPgetOrigObjoffset(scip_ptr));
+	if (SCIPgetStage(scip_ptr) >= SCIP_STAGE_TRANSFORMED) {
+		hasher.add(SCIPgetTransObjoffset(scip_ptr)).add(SCIPgetTransObjscale(scip_ptr));
+	}
+
+	hash_constraints(hasher, scip_ptr, constraints());
+
+	if (SCIPgetStage(scip_ptr) == SCIP_STAGE_SOLVING) {
+		hash_lp(hasher, lp_columns(), lp_rows());
+	}
+	return hasher.value();
+}
+
 void Model::transform_prob() {
 	scip::call(SCIPtransformProb, get_scip_ptr());
 }
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <variant>
+
+#include <nonstd/span.hpp>
+#include <scip/scip.h>
+
+#include "ecole/scip/type.hpp"
+#include "ecole/scip/utils.hpp"
+#include "ecole/utility/unreachable.hpp"
+
+#include "utility/hash.hpp"
+
+namespace ecole::scip {
+
+/** All parameters of a model, in the order they were added by the plugins. */
+inline auto get_params_span(SCIP* scip) noexcept -> nonstd::span<SCIP_PARAM*> {
+	return {SCIPgetParams(scip), static_cast<std::size_t>(SCIPgetNParams(scip))};
+}
+
+/** Identify the parameters of a model by their names and types, in order. */
+inline auto hash_layout(nonstd::span<SCIP_PARAM*> params) noexcept -> std::uint64_t {
+	auto hasher = utility::Hasher{params.size()};
+	for (auto* const param : params) {
+		hasher.add(SCIPparamGetName(param)).add(SCIPparamGetType(param));
+	}
+	return hasher.value();
+}
+
+/** Current value of the parameter, with its exact type. */
+inline auto get_value(SCIP_PARAM* param) -> Param {
+	switch (SCIPparamGetType(param)) {
+	case SCIP_PARAMTYPE_BOOL:
+		return SCIPparamGetBool(param) != FALSE;
+	case SCIP_PARAMTYPE_INT:
+		return SCIPparamGetInt(param);
+	case SCIP_PARAMTYPE_LONGINT:
+		return SCIPparamGetLongint(param);
+	case SCIP_PARAMTYPE_REAL:
+		return SCIPparamGetReal(param);
+	case SCIP_PARAMTYPE_CHAR:
+		return SCIPparamGetChar(param);
+	case SCIP_PARAMTYPE_STRING:
+		return std::string{SCIPparamGetString(param)};
+	default:
+		utility::unreachable();
+	}
+}
+
+/** Whether the value has the exact type of the parameter. */
+inline auto has_type_of(SCIP_PARAM* param, Param const& value) noexcept -> bool {
+	switch (SCIPparamGetType(param)) {
+	case SCIP_PARAMTYPE_BOOL:
+		return std::holds_alternative<bool>(value);
+	case SCIP_PARAMTYPE_INT:
+		return std::holds_alternative<int>(value);
+	case SCIP_PARAMTYPE_LONGINT:
+		return std::holds_alternative<SCIP_Longint>(value);
+	case SCIP_PARAMTYPE_REAL:
+		return std::holds_alternative<SCIP_Real>(value);
+	case SCIP_PARAMTYPE_CHAR:
+		return std::holds_alternative<char>(value);
+	case SCIP_PARAMTYPE_STRING:
+		return std::holds_alternative<std::string>(value);
+	default:
+		return false;
+	}
+}
+
+/** Whether the parameter currently has the value, which must have its exact type. */
+inline auto has_value(SCIP_PARAM* param, Param const& value) noexcept -> bool {
+	switch (SCIPparamGetType(param)) {
+	case SCIP_PARAMTYPE_BOOL:
+		return (SCIPparamGetBool(param) != FALSE) == std::get<bool>(value);
+	case SCIP_PARAMTYPE_INT:
+		return SCIPparamGetInt(param) == std::get<int>(value);
+	case SCIP_PARAMTYPE_LONGINT:
+		return SCIPparamGetLongint(param) == std::get<SCIP_Longint>(value);
+	case SCIP_PARAMTYPE_REAL:
+		return SCIPparamGetReal(param) == std::get<SCIP_Real>(value);
+	case SCIP_PARAMTYPE_CHAR:
+		return SCIPparamGetChar(param) == std::get<char>(value);
+	case SCIP_PARAMTYPE_STRING:
+		return std::strcmp(SCIPparamGetString(param), std::get<std::string>(value).c_str()) == 0;
+	default:
+		return false;
+	}
+}
+
+inline void change(SCIP* scip, SCIP_PARAM* param, bool value) {
+	scip::call(SCIPchgBoolParam, scip, param, static_cast<SCIP_Bool>(value));
+}
+inline void change(SCIP* scip, SCIP_PARAM* param, int value) {
+	scip::call(SCIPchgIntParam, scip, param, value);
+}
+inline void change(SCIP* scip, SCIP_PARAM* param, SCIP_Longint value) {
+	scip::call(SCIPchgLongintParam, scip, param, value);
+}
+inline void change(SCIP* scip, SCIP_PARAM* param, SCIP_Real value) {
+	scip::call(SCIPchgRealParam, scip, param, value);
+}
+inline void change(SCIP* scip, SCIP_PARAM* param, char value) {
+	scip::call(SCIPchgCharParam, scip, param, value);
+}
+inline void change(SCIP* scip, SCIP_PARAM* param, std::string const& value) {
+	scip::call(SCIPchgStringParam, scip, param, value.c_str());
+}
+
+/** Set the value, which must have the exact type of the parameter. */
+inline void change(SCIP* scip, SCIP_PARAM* param, Param const& value) {
+	std::visit([&](auto const& val) { change(scip, param, val); }, value);
+}
+
+}  // namespace ecole::scip
@@ -0,0 +1,57 @@
+#include <cstddef>
+#include <vector>
+
+#include <nonstd/span.hpp>
+#include <scip/scip.h>
+
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/param-snapshot.hpp"
+
+#include "ecole/scip/scimpl.hpp"
+
+#include "scip/param-handle.hpp"
+
+namespace ecole::scip {
+
+ParamSnapshot::ParamSnapshot(Model const& model) {
+	auto const params = get_params_span(const_cast<SCIP*>(model.get_scip_ptr()));
+	layout_hash = hash_layout(params);
+	values.reserve(params.size());
+	for (auto* const param : params) {
+		values.push_back(get_value(param));
+	}
+}
+
+std::size_t ParamSnapshot::apply(Model& model) const {
+	auto* const scip = model.get_scip_ptr();
+	auto const params = get_params_span(scip);
+	// Validate all parameters before changing any, so that a mismatching model is left untouched.
+	// The hash of the model is cached, since hashing the names of all parameters costs more than applying a snapshot.
+	if ((params.size() != values.size()) || (model.scimpl->param_layout_hash() != layout_hash)) {
+		throw ScipError{"Parameter snapshot taken on a model with different parameters."};
+	}
+	std::size_t n_changed = 0;
+	for (std::size_t i = 0; i < params.size(); ++i) {
+		if (!has_value(params[i], values[i])) {
+			change(scip, params[i], values[i]);
+			++n_changed;
+		}
+	}
+	return n_changed;
+}
+
+std::vector<std::size_t> ParamSnapshot::diff(ParamSnapshot const& other) const {
+	if ((other.values.size() != values.size()) || (other.layout_hash != layout_hash)) {
+		throw ScipError{"Parameter snapshots taken on models with different parameters."};
+	}
+	auto positions = std::vector<std::size_t>{};
+	for (std::size_t i = 0; i < values.size(); ++i) {
+		if (values[i] != other.values[i]) {
+			positions.push_back(i);
+		}
+	}
+	return positions;
+}
+
+}  // namespace ecole::scip
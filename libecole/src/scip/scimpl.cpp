@@ -3,6 +3,7 @@
 #include <mutex>
 #include <scip/type_result.h>
 #include <scip/type_retcode.h>
+#include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -15,10 +16,14 @@
 #include <scip/type_timing.h>
 
 #include "ecole/scip/callback.hpp"
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/model-pool.hpp"
 #include "ecole/scip/scimpl.hpp"
 #include "ecole/scip/utils.hpp"
 #include "ecole/utility/coroutine.hpp"
 
+#include "scip/param-handle.hpp"
+
 namespace ecole::scip {
 
 /*************************************
@@ -190,7 +195,8 @@ auto include_reverse_callback<callback::Type::Heuristic>(
  ****************************/
 
 void ScipDeleter::operator()(SCIP* ptr) {
-	if(own) scip::call(SCIPfree, &ptr);
+	// Instances that can be recycled go back to the pool, the others are freed.
+	if(own) ModelPool::release(ptr);
 }
 
 namespace {
@@ -203,6 +209,34 @@ std::unique_ptr<SCIP, ScipDeleter> create_scip() {
 	return scip_ptr;
 }
 
+struct HashmapDeleter {
+	void operator()(SCIP_HASHMAP* map) { SCIPhashmapFree(&map); }
+};
+
+auto create_hashmap(SCIP* scip, int size) -> std::unique_ptr<SCIP_HASHMAP, HashmapDeleter> {
+	SCIP_HASHMAP* map = nullptr;
+	scip::call(SCIPhashmapCreate, &map, SCIPblkmem(scip), std::max(size, 1));
+	return std::unique_ptr<SCIP_HASHMAP, HashmapDeleter>{map};
+}
+
+/**
+ * Copy the parameters and the original problem into an instance that already has the same plugins.
+ *
+ * Same as SCIPcopyOrig, without copying the plugins.
+ */
+void copy_orig_problem(SCIP* source, SCIP* target) {
+	scip::call(SCIPcopyParamSettings, source, target);
+	// The maps are shared so that copied constraints refer to the copied variables.
+	auto var_map = create_hashmap(target, SCIPgetNOrigVars(source));
+	auto cons_map = create_hashmap(target, SCIPgetNOrigConss(source));
+	// Same name as given by SCIPcopyOrig with an empty suffix
+	auto const name = std::string{SCIPgetProbName(source)} + "_";
+	scip::call(SCIPcopyOrigProb, source, target, var_map.get(), cons_map.get(), name.c_str());
+	scip::call(SCIPcopyOrigVars, source, target, var_map.get(), cons_map.get(), nullptr, nullptr, 0);
+	SCIP_Bool valid = FALSE;
+	scip::call(SCIPcopyOrigConss, source, target, var_map.get(), cons_map.get(), false, &valid);
+}
+
 }  // namespace
 
 Scimpl::Scimpl() : m_scip{create_scip()} {}
@@ -217,6 +251,22 @@ auto Scimpl::get_scip_ptr() noexcept -> SCIP* {
 	return m_scip.get();
 }
 
+/*
+ * Copies of different sources run concurrently, which relies on SCIPcopy and SCIPcopyOrig not touching process wide
+ * state. The following was checked in the SCIP 9 sources.
+ *  - Message handlers: the source handler is not passed to the target (passmessagehdlr is false), so the reference
+ *    count of the handler, which is not atomic, and its output file are never shared between threads.
+ *    The static error printer of SCIP (SCIPmessageSetErrorPrinting) is process wide, but copying only reads it when
+ *    reporting an error, and Ecole never changes it.
+ *  - Plugin copy callbacks: those of the default plugins include a new plugin in the target from the data of the
+ *    source plugin, and do not use global variables.
+ *    The reverse callbacks of Ecole have no copy callback and are never copied.
+ *  - Memory: the target allocates in its own block memory, and the threadsafe flag prevents it from referencing data
+ *    owned by the source.
+ *  - Randomness: random generators belong to every SCIP and are seeded from its parameters.
+ * SCIPcopy does however update some data of the source, such as its statistics and clocks, hence the per source mutex.
+ */
+
 auto Scimpl::copy() const -> Scimpl {
 	if (m_scip == nullptr) {
 		return {nullptr};
@@ -224,11 +274,11 @@ auto Scimpl::copy() const -> Scimpl {
 	if (SCIPgetStage(m_scip.get()) == SCIP_STAGE_INIT) {
 		return {create_scip()};
 	}
+	// Created outside of the critical section since it does not access the source.
 	auto dest = create_scip();
-	// Copy operation is not thread safe
-	static auto m = std::mutex{};
-	auto g = std::lock_guard{m};
-	scip::call(SCIPcopy, m_scip.get(), dest.get(), nullptr, nullptr, "", true, false, false, false, nullptr);
+	auto g = std::lock_guard{*m_copy_mutex};
+	// Thread safe copy so that the target does not share memory with the source.
+	scip::call(SCIPcopy, m_scip.get(), dest.get(), nullptr, nullptr, "", true, false, true, false, nullptr);
 	return {std::move(dest)};
 }
 
@@ -239,14 +289,39 @@ auto Scimpl::copy_orig() const -> Scimpl {
 	if (SCIPgetStage(m_scip.get()) == SCIP_STAGE_INIT) {
 		return {create_scip()};
 	}
+	// A pooled instance already has the default plugins, so only the problem is copied.
+	if (ModelPool::has_default_plugins(m_scip.get())) {
+		auto dest = ModelPool::acquire();
+		auto g = std::lock_guard{*m_copy_mutex};
+		copy_orig_problem(m_scip.get(), dest.get());
+		return {std::move(dest)};
+	}
+	auto dest = create_scip();
+	auto g = std::lock_guard{*m_copy_mutex};
+	scip::call(SCIPcopyOrig, m_scip.get(), dest.get(), nullptr, nullptr, "", false, true, false, nullptr);
+	return {std::move(dest)};
+}
+
+auto Scimpl::fork() const -> Scimpl {
+	if (m_scip == nullptr || SCIPgetStage(m_scip.get()) != SCIP_STAGE_SOLVING) {
+		throw ScipError::from_retcode(SCIP_INVALIDCALL);
+	}
 	auto dest = create_scip();
-	// Copy operation is not thread safe
-	static auto m = std::mutex{};
-	auto g = std::lock_guard{m};
-	scip::call(SCIPcopyOrig, m_scip.get(), dest.get(), nullptr, nullptr, "", false, false, false, nullptr);
+	auto g = std::lock_guard{*m_copy_mutex};
+	// Local (current node) copy, not sharing memory with the source so that both can be used from different threads.
+	scip::call(SCIPcopy, m_scip.get(), dest.get(), nullptr, nullptr, "", false, false, true, false, nullptr);
 	return {std::move(dest)};
 }
 
+auto Scimpl::param_layout_hash() -> std::uint64_t {
+	auto const params = get_params_span(m_scip.get());
+	if (params.size() != m_n_hashed_params) {
+		m_param_layout_hash = hash_layout(params);
+		m_n_hashed_params = params.size();
+	}
+	return m_param_layout_hash;
+}
+
 auto Scimpl::solve_iter(nonstd::span<callback::DynamicConstructor const> arg_packs)
 	-> std::optional<callback::DynamicCall> {
 	auto* const scip_ptr = get_scip_ptr();
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ecole/utility/coroutine-stack.hpp"
+
+namespace ecole::utility {
+
+namespace {
+
+/** Same as the default main thread stack size on Linux. Memory is only committed when used. */
+constexpr std::size_t initial_default_size = 8UL * 1024UL * 1024UL;
+/** Maximum number of stacks kept per thread for reuse. */
+constexpr std::size_t max_free_stacks = 16;
+/** Top of the stacks kept committed in the free list, where the frames of a new Coroutine are written first. */
+constexpr std::size_t committed_top_size = 64UL * 1024UL;
+
+std::atomic<std::size_t> default_stack_size{initial_default_size};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+auto page_size() -> std::size_t {
+	static auto const size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	return size;
+}
+
+auto round_to_page(std::size_t size) -> std::size_t {
+	auto const page = page_size();
+	return ((size + page - 1) / page) * page;
+}
+
+/** Map a stack with a guard page below it, since stacks grow downward. */
+auto map_stack(std::size_t size) -> void* {
+	auto const guard = page_size();
+	auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_STACK
+	flags |= MAP_STACK;
+#endif
+	void* const region = mmap(nullptr, size + guard, PROT_READ | PROT_WRITE, flags, -1, 0);
+	if (region == MAP_FAILED) {
+		throw std::system_error{{errno, std::generic_category()}};
+	}
+	if (mprotect(region, guard, PROT_NONE) != 0) {
+		auto const error = errno;
+		munmap(region, size + guard);
+		throw std::system_error{{error, std::generic_category()}};
+	}
+	return static_cast<char*>(region) + guard;
+}
+
+void unmap_stack(void* data, std::size_t size) noexcept {
+	auto const guard = page_size();
+	munmap(static_cast<char*>(data) - guard, size + guard);
+}
+
+/**
+ * Give the memory of a stack back to the system, except for its top.
+ *
+ * The mapping is kept, and the pages are zero filled again when next used.
+ * Return false if the memory could not be released.
+ */
+auto decommit_stack(void* data, std::size_t size) noexcept -> bool {
+	auto const top_size = std::min(round_to_page(committed_top_size), size);
+	if (top_size == size) {
+		return true;
+	}
+	return madvise(data, size - top_size, MADV_DONTNEED) == 0;
+}
+
+/** Stacks released on the current thread, unmapped when the thread exits. */
+struct FreeList {
+	std::vector<std::pair<void*, std::size_t>> stacks;
+
+	FreeList() = default;
+	FreeList(FreeList const&) = delete;
+	FreeList(FreeList&&) = delete;
+	auto operator=(FreeList const&) -> FreeList& = delete;
+	auto operator=(FreeList&&) -> FreeList& = delete;
+	~FreeList() { clear(); }
+
+	void clear() noexcept {
+		for (auto [data, size] : stacks) {
+			unmap_stack(data, size);
+		}
+		stacks.clear();
+	}
+};
+
+auto free_list() -> FreeList& {
+	thread_local auto list = FreeList{};
+	return list;
+}
+
+}  // namespace
+
+/**************************************
+ *  Implementation of CoroutineStack  *
+ **************************************/
+
+CoroutineStack::CoroutineStack(std::size_t size) : m_size(round_to_page(size)) {
+	auto& stacks = free_list().stacks;
+	for (auto iter = stacks.rbegin(); iter != stacks.rend(); ++iter) {
+		if (iter->second == m_size) {
+			m_data = iter->first;
+			stacks.erase(std::next(iter).base());
+			return;
+		}
+	}
+	m_data = map_stack(m_size);
+}
+
+CoroutineStack::CoroutineStack(CoroutineStack&& other) noexcept :
+	m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+
+CoroutineStack::~CoroutineStack() {
+	release();
+}
+
+auto CoroutineStack::operator=(CoroutineStack&& other) noexcept -> CoroutineStack& {
+	if (this != &other) {
+		release();
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+	}
+	return *this;
+}
+
+auto CoroutineStack::default_size() noexcept -> std::size_t {
+	return default_stack_size.load(std::memory_order_relaxed);
+}
+
+void CoroutineStack::set_default_size(std::size_t size) {
+	default_stack_size.store(round_to_page(size), std::memory_order_relaxed);
+}
+
+void CoroutineStack::release_free_list() noexcept {
+	free_list().clear();
+}
+
+void CoroutineStack::release() noexcept {
+	if (m_data == nullptr) {
+		return;
+	}
+	auto& stacks = free_list().stacks;
+	if ((stacks.size() < max_free_stacks) && decommit_stack(m_data, m_size)) {
+		try {
+			stacks.emplace_back(m_data, m_size);
+			m_data = nullptr;
+			return;
+		} catch (...) {
+			// Could not record the stack for reuse, unmap it instead.
+		}
+	}
+	unmap_stack(m_data, m_size);
+	m_data = nullptr;
+}
+
+}  // namespace ecole::utility
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include "ecole/random.hpp"
+
+#include "utility/csr-graph.hpp"
+
+namespace ecole::utility {
+
+/********************************
+ *  Implementation of CsrGraph  *
+ ********************************/
+
+CsrGraph::CsrGraph(std::vector<std::size_t> node_ptrs, std::vector<Node> neighbors) :
+	m_node_ptrs{std::move(node_ptrs)}, m_neighbors{std::move(neighbors)} {
+	assert(!m_node_ptrs.empty());
+	assert(m_node_ptrs.back() == m_neighbors.size());
+}
+
+auto CsrGraph::are_connected(Node n1, Node n2) const noexcept -> bool {
+	if (degree(n1) > degree(n2)) {
+		std::swap(n1, n2);
+	}
+	auto const neighbors_1 = neighbors(n1);
+	return std::binary_search(neighbors_1.begin(), neighbors_1.end(), n2);
+}
+
+auto CsrGraph::estimate_clustering_coefficient(Node n, std::size_t n_wedges) const -> double {
+	auto const n_neighbors = degree(n);
+	if ((n_neighbors < 2) || (n_wedges == 0)) {
+		return 0.;
+	}
+	auto const neighbors_n = neighbors(n);
+	auto const n_pairs = n_neighbors * (n_neighbors - 1) / 2;
+	auto n_connected = std::size_t{0};
+	if (n_pairs <= n_wedges) {
+		for (std::size_t i = 0; i < n_neighbors; ++i) {
+			for (auto j = i + 1; j < n_neighbors; ++j) {
+				n_connected += are_connected(neighbors_n[i], neighbors_n[j]) ? 1 : 0;
+			}
+		}
+		return static_cast<double>(n_connected) / static_cast<double>(n_pairs);
+	}
+
+	auto rng = RandomGenerator{static_cast<Seed>(n)};
+	auto choice = std::uniform_int_distribution<std::size_t>{0, n_neighbors - 1};
+	for (std::size_t wedge = 0; wedge < n_wedges; ++wedge) {
+		auto const i = choice(rng);
+		auto j = choice(rng);
+		while (j == i) {
+			j = choice(rng);
+		}
+		n_connected += are_connected(neighbors_n[i], neighbors_n[j]) ? 1 : 0;
+	}
+	return static_cast<double>(n_connected) / static_cast<double>(n_wedges);
+}
+
+/************************************
+ *  Implementation of column_graph  *
+ ************************************/
+
+namespace {
+
+/** The non zeros of a sparse matrix indexed along one axis, with the slice of index ``i`` in ``ptrs[i]:ptrs[i+1]``. */
+struct CompressedIndices {
+	std::vector<std::size_t> ptrs;
+	std::vector<std::size_t> indices;
+};
+
+/** Compress a coordinate matrix along an axis with a counting sort. */
+auto compress(coo_matrix<double> const& matrix, std::size_t axis) -> CompressedIndices {
+	auto const other_axis = 1 - axis;
+	auto const nnz = matrix.nnz();
+	auto ptrs = std::vector<std::size_t>(matrix.shape[axis] + 1, 0);
+	for (std::size_t i = 0; i < nnz; ++i) {
+		ptrs[matrix.indices(axis, i) + 1]++;
+	}
+	std::partial_sum(ptrs.begin(), ptrs.end(), ptrs.begin());
+	auto indices = std::vector<std::size_t>(nnz);
+	auto next = ptrs;
+	for (std::size_t i = 0; i < nnz; ++i) {
+		indices[next[matrix.indices(axis, i)]++] = matrix.indices(other_axis, i);
+	}
+	return {std::move(ptrs), std::move(indices)};
+}
+
+/** Write in the buffer the sorted columns sharing a row with the given one, excluding itself. */
+void gather_neighbors(
+	std::size_t col,
+	CompressedIndices const& rows,
+	CompressedIndices const& cols,
+	std::vector<std::size_t>& buffer) {
+	buffer.clear();
+	for (auto i = cols.ptrs[col]; i < cols.ptrs[col + 1]; ++i) {
+		auto const row = cols.indices[i];
+		for (auto j = rows.ptrs[row]; j < rows.ptrs[row + 1]; ++j) {
+			if (rows.indices[j] != col) {
+				buffer.push_back(rows.indices[j]);
+			}
+		}
+	}
+	std::sort(buffer.begin(), buffer.end());
+	buffer.erase(std::unique(buffer.begin(), buffer.end()), buffer.end());
+}
+
+/** Call a function on contiguous blocks covering [0, n), one per thread of the pool if given. */
+template <typename Func> void for_each_block(std::size_t n, ThreadPool* thread_pool, Func&& func) {
+	if ((thread_pool == nullptr) || (thread_pool->n_threads() < 2)) {
+		func(std::size_t{0}, n);
+		return;
+	}
+	auto const n_blocks = thread_pool->n_threads();
+	auto const block_size = (n + n_blocks - 1) / n_blocks;
+	thread_pool->parallel_for(
+		n_blocks, [&](std::size_t block) { func(std::min(block * block_size, n), std::min((block + 1) * block_size, n)); });
+}
+
+}  // namespace
+
+auto column_graph(coo_matrix<double> const& matrix, std::size_t max_n_edges, ThreadPool* thread_pool)
+	-> std::optional<CsrGraph> {
+	auto const n_cols = matrix.shape[1];
+	auto const rows = compress(matrix, 0);
+	auto const cols = compress(matrix, 1);
+
+	// Count the degrees, with one buffer per block
+	auto node_ptrs = std::vector<std::size_t>(n_cols + 1, 0);
+	for_each_block(n_cols, thread_pool, [&](std::size_t begin, std::size_t end) {
+		auto buffer = std::vector<std::size_t>{};
+		for (auto col = begin; col < end; ++col) {
+			gather_neighbors(col, rows, cols, buffer);
+			node_ptrs[col + 1] = buffer.size();
+		}
+	});
+	std::partial_sum(node_ptrs.begin(), node_ptrs.end(), node_ptrs.begin());
+	if (node_ptrs.back() / 2 > max_n_edges) {
+		return {};
+	}
+
+	// Every column writes its own slice of neighbors
+	auto neighbors = std::vector<CsrGraph::Node>(node_ptrs.back());
+	for_each_block(n_cols, thread_pool, [&](std::size_t begin, std::size_t end) {
+		auto buffer = std::vector<std::size_t>{};
+		for (auto col = begin; col < end; ++col) {
+			gather_neighbors(col, rows, cols, buffer);
+			std::copy(buffer.begin(), buffer.end(), neighbors.begin() + static_cast<std::ptrdiff_t>(node_ptrs[col]));
+		}
+	});
+	return CsrGraph{std::move(node_ptrs), std::move(neighbors)};
+}
+
+}  // namespace ecole::utility
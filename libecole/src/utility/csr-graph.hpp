@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "ecole/export.hpp"
+#include "ecole/utility/sparse-matrix.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::utility {
+
+/**
+ * An undirected graph without self loops, stored in compressed sparse row format.
+ *
+ * The neighbors of every node are sorted and stored contiguously, so that the graph is built with a single allocation
+ * and neighborhoods are intersected by merging.
+ */
+class ECOLE_EXPORT CsrGraph {
+public:
+	using Node = std::size_t;
+
+	/** Build from the neighbors of every node, in the slice ``neighbors[node_ptrs[n]:node_ptrs[n+1]]``. */
+	ECOLE_EXPORT CsrGraph(std::vector<std::size_t> node_ptrs, std::vector<Node> neighbors);
+
+	[[nodiscard]] auto n_nodes() const noexcept -> std::size_t { return m_node_ptrs.size() - 1; }
+	[[nodiscard]] auto n_edges() const noexcept -> std::size_t { return m_neighbors.size() / 2; }
+	[[nodiscard]] auto degree(Node n) const noexcept -> std::size_t { return m_node_ptrs[n + 1] - m_node_ptrs[n]; }
+	/** The sorted neighbors of a node. */
+	[[nodiscard]] auto neighbors(Node n) const noexcept -> nonstd::span<Node const> {
+		return {m_neighbors.data() + m_node_ptrs[n], degree(n)};
+	}
+	[[nodiscard]] ECOLE_EXPORT auto are_connected(Node n1, Node n2) const noexcept -> bool;
+
+	/**
+	 * Estimate the clustering coefficient of a node by wedge sampling.
+	 *
+	 * The clustering coefficient is the fraction of pairs of neighbors of a node that are connected, and is zero for
+	 * nodes with less than two neighbors.
+	 * Random pairs of neighbors are tested for connection, which costs ``O(n_wedges log(degree))`` rather than the
+	 * ``O(degree^2)`` of the exact coefficient.
+	 * Nodes with no more pairs of neighbors than ``n_wedges`` have all their pairs tested, giving the exact value.
+	 * The pairs are drawn from a random generator seeded with the node, so the estimate is deterministic.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto estimate_clustering_coefficient(Node n, std::size_t n_wedges) const -> double;
+
+private:
+	std::vector<std::size_t> m_node_ptrs;
+	std::vector<Node> m_neighbors;
+};
+
+/**
+ * Build the graph of the columns of a sparse matrix, connected when they have a non zero in the same row.
+ *
+ * This is the sparsity pattern of ``A^T A`` without its diagonal.
+ * The neighbors of a column are found by sorting and deduplicating the columns of all its rows.
+ * A first pass counts the degrees, so that the graph is allocated once with its exact size, and a second pass fills
+ * it.
+ * Both passes are split in contiguous blocks of columns among the threads of the pool, if given.
+ *
+ * @param matrix The sparse matrix, whose column indices must be less than its number of columns.
+ * @param max_n_edges The maximum number of edges in the graph, to cap the memory used.
+ * @param thread_pool The threads used to compute the neighborhoods, or null to compute them in the calling thread.
+ * @return The graph, or nothing if it has more edges than the maximum.
+ */
+ECOLE_EXPORT auto column_graph(coo_matrix<double> const& matrix, std::size_t max_n_edges, ThreadPool* thread_pool)
+	-> std::optional<CsrGraph>;
+
+}  // namespace ecole::utility
@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+
+#include "ecole/utility/execution-context.hpp"
+
+#if defined(ECOLE_USE_FCONTEXT)
+
+#if !defined(__ELF__) || !(defined(__x86_64__) || defined(__aarch64__))
+#error "The fcontext backend is only available on ELF x86-64 and AArch64 platforms, use ucontext instead."
+#endif
+
+extern "C" {
+/** Push the callee-saved registers, store the stack pointer in ``*from_sp``, and pop them from ``to_sp``. */
+__attribute__((visibility("hidden"))) void ecole_context_switch(void** from_sp, void* to_sp);
+/** The first code run in a new context, calling the entry stored in its callee-saved registers. */
+__attribute__((visibility("hidden"))) void ecole_context_trampoline();
+}
+
+#if defined(__x86_64__)
+
+// System V ABI: rbx, rbp, r12-r15 are callee-saved, along with the control words of SSE and x87.
+asm(
+	".pushsection .text\n"
+	".globl ecole_context_switch\n"
+	".hidden ecole_context_switch\n"
+	".type ecole_context_switch, @function\n"
+	".p2align 4\n"
+	"ecole_context_switch:\n"
+	"\tpushq %rbp\n"
+	"\tpushq %rbx\n"
+	"\tpushq %r12\n"
+	"\tpushq %r13\n"
+	"\tpushq %r14\n"
+	"\tpushq %r15\n"
+	"\tsubq $16, %rsp\n"
+	"\tstmxcsr 8(%rsp)\n"
+	"\tfnstcw 12(%rsp)\n"
+	"\tmovq %rsp, (%rdi)\n"
+	"\tmovq %rsi, %rsp\n"
+	"\tldmxcsr 8(%rsp)\n"
+	"\tfldcw 12(%rsp)\n"
+	"\taddq $16, %rsp\n"
+	"\tpopq %r15\n"
+	"\tpopq %r14\n"
+	"\tpopq %r13\n"
+	"\tpopq %r12\n"
+	"\tpopq %rbx\n"
+	"\tpopq %rbp\n"
+	"\tret\n"
+	".size ecole_context_switch, .-ecole_context_switch\n"
+	".globl ecole_context_trampoline\n"
+	".hidden ecole_context_trampoline\n"
+	".type ecole_context_trampoline, @function\n"
+	".p2align 4\n"
+	"ecole_context_trampoline:\n"
+	"\tmovq %r12, %rdi\n"
+	"\tcallq *%r13\n"
+	"\tud2\n"
+	".size ecole_context_trampoline, .-ecole_context_trampoline\n"
+	".popsection\n");
+
+#elif defined(__aarch64__)
+
+// AAPCS64: x19-x29, the link register x30, and the lower halves of v8-v15 are callee-saved.
+asm(
+	".pushsection .text\n"
+	".globl ecole_context_switch\n"
+	".hidden ecole_context_switch\n"
+	".type ecole_context_switch, %function\n"
+	".p2align 4\n"
+	"ecole_context_switch:\n"
+	"\tsub sp, sp, #160\n"
+	"\tstp x19, x20, [sp, #0]\n"
+	"\tstp x21, x22, [sp, #16]\n"
+	"\tstp x23, x24, [sp, #32]\n"
+	"\tstp x25, x26, [sp, #48]\n"
+	"\tstp x27, x28, [sp, #64]\n"
+	"\tstp x29, x30, [sp, #80]\n"
+	"\tstp d8, d9, [sp, #96]\n"
+	"\tstp d10, d11, [sp, #112]\n"
+	"\tstp d12, d13, [sp, #128]\n"
+	"\tstp d14, d15, [sp, #144]\n"
+	"\tmov x9, sp\n"
+	"\tstr x9, [x0]\n"
+	"\tmov sp, x1\n"
+	"\tldp x19, x20, [sp, #0]\n"
+	"\tldp x21, x22, [sp, #16]\n"
+	"\tldp x23, x24, [sp, #32]\n"
+	"\tldp x25, x26, [sp, #48]\n"
+	"\tldp x27, x28, [sp, #64]\n"
+	"\tldp x29, x30, [sp, #80]\n"
+	"\tldp d8, d9, [sp, #96]\n"
+	"\tldp d10, d11, [sp, #112]\n"
+	"\tldp d12, d13, [sp, #128]\n"
+	"\tldp d14, d15, [sp, #144]\n"
+	"\tadd sp, sp, #160\n"
+	"\tret\n"
+	".size ecole_context_switch, .-ecole_context_switch\n"
+	".globl ecole_context_trampoline\n"
+	".hidden ecole_context_trampoline\n"
+	".type ecole_context_trampoline, %function\n"
+	".p2align 4\n"
+	"ecole_context_trampoline:\n"
+	"\tmov x0, x19\n"
+	"\tblr x20\n"
+	"\tbrk #0\n"
+	".size ecole_context_trampoline, .-ecole_context_trampoline\n"
+	".popsection\n");
+
+#endif
+
+#else
+
+#include <ucontext.h>
+
+#endif
+
+namespace ecole::utility {
+
+#if defined(ECOLE_USE_FCONTEXT)
+
+/****************************************
+ *  Implementation of fcontext backend  *
+ ****************************************/
+
+namespace {
+
+using Word = std::uint64_t;
+
+#if defined(__x86_64__)
+
+/** Control words, r15, r14, r13 (entry), r12 (argument), rbx, rbp, and the return address. */
+constexpr std::size_t frame_size = 9;
+
+void init_frame(Word* frame, ExecutionContext::Entry entry, void* arg) {
+	auto mxcsr = std::uint32_t{0};
+	auto fpucw = std::uint16_t{0};
+	// The new context starts with the floating point environment of the thread creating it.
+	asm volatile("stmxcsr %0" : "=m"(mxcsr));
+	asm volatile("fnstcw %0" : "=m"(fpucw));
+	frame[1] = Word{mxcsr} | (Word{fpucw} << 32U);
+	frame[4] = reinterpret_cast<Word>(entry);
+	frame[5] = reinterpret_cast<Word>(arg);
+	// Popped by the ret instruction, leaving the stack aligned as required before the call of the entry
+	frame[8] = reinterpret_cast<Word>(&ecole_context_trampoline);
+}
+
+#elif defined(__aarch64__)
+
+/** x19 (argument), x20 (entry), x21-x28, x29, x30 (return address), d8-d15. */
+constexpr std::size_t frame_size = 20;
+
+void init_frame(Word* frame, ExecutionContext::Entry entry, void* arg) {
+	frame[0] = reinterpret_cast<Word>(arg);
+	frame[1] = reinterpret_cast<Word>(entry);
+	frame[11] = reinterpret_cast<Word>(&ecole_context_trampoline);
+}
+
+#endif
+
+}  // namespace
+
+struct ExecutionContext::State {
+	void* stack_pointer = nullptr;
+};
+
+ExecutionContext::ExecutionContext() : state{std::make_unique<State>()} {}
+
+ExecutionContext::ExecutionContext(CoroutineStack const& stack, Entry entry, void* arg) :
+	state{std::make_unique<State>()} {
+	// Stacks grow downward, from the top aligned on 16 bytes
+	auto const top = (reinterpret_cast<std::uintptr_t>(stack.data()) + stack.size()) & ~std::uintptr_t{15};
+	auto* const frame = reinterpret_cast<Word*>(top) - frame_size;
+	std::fill(frame, frame + frame_size, Word{0});
+	init_frame(frame, entry, arg);
+	state->stack_pointer = frame;
+}
+
+void ExecutionContext::switch_to(ExecutionContext& target) {
+	ecole_context_switch(&state->stack_pointer, target.state->stack_pointer);
+}
+
+auto ExecutionContext::backend() noexcept -> char const* {
+	return "fcontext";
+}
+
+#else
+
+/****************************************
+ *  Implementation of ucontext backend  *
+ ****************************************/
+
+namespace {
+
+struct Start {
+	ExecutionContext::Entry entry = nullptr;
+	void* arg = nullptr;
+};
+
+/** Arguments of makecontext are int, hence the address of the start is split in two. */
+void ucontext_entry(unsigned int high, unsigned int low) noexcept {
+	auto const address = (std::uint64_t{high} << 32U) | std::uint64_t{low};
+	auto const* const start = reinterpret_cast<Start const*>(static_cast<std::uintptr_t>(address));
+	start->entry(start->arg);
+}
+
+}  // namespace
+
+struct ExecutionContext::State {
+	ucontext_t context = {};
+	Start start = {};
+};
+
+ExecutionContext::ExecutionContext() : state{std::make_unique<State>()} {}
+
+ExecutionContext::ExecutionContext(CoroutineStack const& stack, Entry entry, void* arg) :
+	state{std::make_unique<State>()} {
+	state->start = {entry, arg};
+	if (getcontext(&state->context) != 0) {
+		throw std::system_error{{errno, std::generic_category()}};
+	}
+	state->context.uc_stack.ss_sp = stack.data();
+	state->context.uc_stack.ss_size = stack.size();
+	state->context.uc_link = nullptr;
+	auto const address = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(&state->start));
+	makecontext(
+		&state->context,
+		reinterpret_cast<void (*)()>(ucontext_entry),
+		2,
+		static_cast<unsigned int>(address >> 32U),
+		static_cast<unsigned int>(address & 0xFFFFFFFFU));  // NOLINT(readability-magic-numbers)
+}
+
+void ExecutionContext::switch_to(ExecutionContext& target) {
+	if (swapcontext(&state->context, &target.state->context) != 0) {
+		throw std::system_error{{errno, std::generic_category()}};
+	}
+}
+
+auto ExecutionContext::backend() noexcept -> char const* {
+	return "ucontext";
+}
+
+#endif
+
+ExecutionContext::~ExecutionContext() = default;
+
+}  // namespace ecole::utility
@@ -0,0 +1,165 @@
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "ecole/utility/file-cache.hpp"
+
+namespace ecole::utility {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Word = std::uint64_t;
+
+/** "ECOLEFC1" read as a little endian word, the last digit being the version of the format. */
+constexpr auto magic = Word{0x314346454c4f4345};
+
+/** Maximum number of dimensions of an array, to reject invalid files before allocating. */
+constexpr auto max_ndim = Word{64};
+
+auto key_name(FileCache::Key key) -> std::string {
+	auto name = std::array<char, 2 * sizeof(FileCache::Key) + 1>{};
+	std::snprintf(name.data(), name.size(), "%016llx", static_cast<unsigned long long>(key));
+	return name.data();
+}
+
+/** A name that does not clash with the temporary files of other threads and processes. */
+auto unique_tmp_name(FileCache::Key key) -> std::string {
+	auto random_device = std::random_device{};
+	auto const thread_hash = static_cast<Word>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+	auto const salt = (Word{random_device()} << 32U) ^ Word{random_device()} ^ thread_hash;
+	return key_name(key) + ".tmp." + key_name(salt);
+}
+
+void write_word(std::ofstream& file, Word word) {
+	file.write(reinterpret_cast<char const*>(&word), sizeof(word));
+}
+
+auto read_word(std::ifstream& file) -> std::optional<Word> {
+	auto word = Word{0};
+	if (file.read(reinterpret_cast<char*>(&word), sizeof(word))) {
+		return word;
+	}
+	return {};
+}
+
+auto read_array(std::ifstream& file, std::uintmax_t file_size) -> std::optional<CachedArray> {
+	auto const ndim = read_word(file);
+	if (!ndim.has_value() || ndim.value() > max_ndim) {
+		return {};
+	}
+	auto array = CachedArray{};
+	auto n_values = Word{1};
+	for (Word i = 0; i < ndim.value(); ++i) {
+		auto const dim = read_word(file);
+		if (!dim.has_value()) {
+			return {};
+		}
+		// The values must fit in the file, which also prevents overflows.
+		if ((dim.value() != 0) && (n_values > file_size / sizeof(double) / dim.value())) {
+			return {};
+		}
+		n_values *= dim.value();
+		array.shape.push_back(dim.value());
+	}
+	if (n_values > file_size / sizeof(double)) {
+		return {};
+	}
+	array.values.resize(n_values);
+	auto const n_bytes = static_cast<std::streamsize>(n_values * sizeof(double));
+	if (!file.read(reinterpret_cast<char*>(array.values.data()), n_bytes)) {
+		return {};
+	}
+	return array;
+}
+
+}  // namespace
+
+FileCache::FileCache(fs::path directory) : m_directory{std::move(directory)} {
+	fs::create_directories(m_directory);
+}
+
+auto FileCache::path(Key key) const -> fs::path {
+	return m_directory / (key_name(key) + ".bin");
+}
+
+auto FileCache::load(Key key) const -> std::optional<std::vector<CachedArray>> {
+	auto const file_path = path(key);
+	auto error = std::error_code{};
+	auto const file_size = fs::file_size(file_path, error);
+	if (error) {
+		return {};
+	}
+	auto file = std::ifstream{file_path, std::ios::binary};
+	if (read_word(file) != magic || read_word(file) != key) {
+		return {};
+	}
+	auto const n_arrays = read_word(file);
+	if (!n_arrays.has_value() || n_arrays.value() > file_size / sizeof(Word)) {
+		return {};
+	}
+	auto arrays = std::vector<CachedArray>{};
+	arrays.reserve(n_arrays.value());
+	for (Word i = 0; i < n_arrays.value(); ++i) {
+		auto array = read_array(file, file_size);
+		if (!array.has_value()) {
+			return {};
+		}
+		arrays.push_back(std::move(array).value());
+	}
+	// Trailing data means that the file is not an entry of this cache.
+	if (file.peek() != std::ifstream::traits_type::eof()) {
+		return {};
+	}
+	return arrays;
+}
+
+auto FileCache::store(Key key, nonstd::span<CachedArray const> arrays) const -> bool {
+	for (auto const& array : arrays) {
+		auto const size = std::accumulate(array.shape.begin(), array.shape.end(), std::size_t{1}, std::multiplies<>{});
+		if (size != array.values.size()) {
+			throw std::invalid_argument{"Array shape does not match its number of values."};
+		}
+	}
+
+	auto const tmp_path = m_directory / unique_tmp_name(key);
+	{
+		auto file = std::ofstream{tmp_path, std::ios::binary | std::ios::trunc};
+		write_word(file, magic);
+		write_word(file, key);
+		write_word(file, arrays.size());
+		for (auto const& array : arrays) {
+			write_word(file, array.shape.size());
+			for (auto const dim : array.shape) {
+				write_word(file, dim);
+			}
+			auto const n_bytes = static_cast<std::streamsize>(array.values.size() * sizeof(double));
+			file.write(reinterpret_cast<char const*>(array.values.data()), n_bytes);
+		}
+		file.close();
+		if (!file) {
+			auto error = std::error_code{};
+			fs::remove(tmp_path, error);
+			return false;
+		}
+	}
+	// Renaming is atomic, readers see either the previous entry or the new one.
+	auto error = std::error_code{};
+	fs::rename(tmp_path, path(key), error);
+	if (error) {
+		fs::remove(tmp_path, error);
+		return false;
+	}
+	return true;
+}
+
+}  // namespace ecole::utility
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace ecole::utility {
+
+/**
+ * Incrementally hash a sequence of values into 64 bits.
+ *
+ * Every word is mixed into the state with the finalizer of SplitMix64, so that the hash depends on the order of the
+ * values.
+ * Doubles are hashed by their bit pattern, hence ``0.`` and ``-0.`` have different hashes.
+ * This is meant to identify identical contents, not to resist adversarial collisions.
+ */
+class Hasher {
+public:
+	Hasher(std::uint64_t seed = 0) noexcept : m_state{seed} {}
+
+	[[nodiscard]] auto value() const noexcept -> std::uint64_t { return m_state; }
+
+	template <typename T> auto add(T value) noexcept -> Hasher& {
+		static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Only integers, enums, doubles, and strings");
+		return add_word(static_cast<std::uint64_t>(value));
+	}
+
+	auto add(double value) noexcept -> Hasher& {
+		auto word = std::uint64_t{0};
+		static_assert(sizeof(word) == sizeof(value));
+		std::memcpy(&word, &value, sizeof(word));
+		return add_word(word);
+	}
+
+	auto add(std::string_view str) noexcept -> Hasher& {
+		add_word(str.size());
+		for (auto const c : str) {
+			add_word(static_cast<unsigned char>(c));
+		}
+		return *this;
+	}
+
+	auto add(char const* str) noexcept -> Hasher& { return add(std::string_view{str}); }
+
+private:
+	std::uint64_t m_state;
+
+	auto add_word(std::uint64_t word) noexcept -> Hasher& {
+		auto x = m_state ^ word;
+		x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9U;  // NOLINT(readability-magic-numbers)
+		x = (x ^ (x >> 27U)) * 0x94d049bb133111ebU;  // NOLINT(readability-magic-numbers)
+		m_state = (x ^ (x >> 31U)) + 0x9e3779b97f4a7c15U;  // NOLINT(readability-magic-numbers)
+		return *this;
+	}
+};
+
+}  // namespace ecole::utility
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ECOLE_STATS_X86
+#include <immintrin.h>
+#endif
+
+#include "utility/math.hpp"
+
+namespace ecole::utility {
+
+namespace {
+
+/** Accumulators of a single pass over values shifted by a constant. */
+struct Moments {
+	double sum = 0.;
+	double sum_squares = 0.;
+	double min = std::numeric_limits<double>::infinity();
+	double max = -std::numeric_limits<double>::infinity();
+};
+
+/** Accumulate values in the moments, one at a time. */
+void accumulate_scalar(Moments& moments, double const* values, std::size_t n, double shift) noexcept {
+	for (std::size_t i = 0; i < n; ++i) {
+		auto const shifted = values[i] - shift;
+		moments.sum += shifted;
+		moments.sum_squares += shifted * shifted;
+		// Argument order ignores NaN, as the SIMD min and max
+		moments.min = std::min(moments.min, values[i]);
+		moments.max = std::max(moments.max, values[i]);
+	}
+}
+
+auto moments_scalar(double const* values, std::size_t n, double shift) noexcept -> Moments {
+	auto moments = Moments{};
+	accumulate_scalar(moments, values, n, shift);
+	return moments;
+}
+
+/** Reduce the lanes of SIMD accumulators, stored in arrays. */
+template <std::size_t Width>
+auto reduce_lanes(
+	std::array<double, Width> const& sum,
+	std::array<double, Width> const& sum_squares,
+	std::array<double, Width> const& min,
+	std::array<double, Width> const& max) noexcept -> Moments {
+	auto moments = Moments{};
+	for (std::size_t lane = 0; lane < Width; ++lane) {
+		moments.sum += sum[lane];
+		moments.sum_squares += sum_squares[lane];
+		moments.min = std::min(moments.min, min[lane]);
+		moments.max = std::max(moments.max, max[lane]);
+	}
+	return moments;
+}
+
+#ifdef ECOLE_STATS_X86
+
+__attribute__((target("avx2"))) auto moments_avx2(double const* values, std::size_t n, double shift) noexcept
+	-> Moments {
+	static auto constexpr width = std::size_t{4};
+	auto const shift_vec = _mm256_set1_pd(shift);
+	auto sum = _mm256_setzero_pd();
+	auto sum_squares = _mm256_setzero_pd();
+	auto min = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+	auto max = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+
+	std::size_t i = 0;
+	for (; i + width <= n; i += width) {
+		auto const vals = _mm256_loadu_pd(values + i);
+		auto const shifted = _mm256_sub_pd(vals, shift_vec);
+		sum = _mm256_add_pd(sum, shifted);
+		sum_squares = _mm256_add_pd(sum_squares, _mm256_mul_pd(shifted, shifted));
+		// The second operand is returned if any is NaN
+		min = _mm256_min_pd(vals, min);
+		max = _mm256_max_pd(vals, max);
+	}
+
+	auto sum_lanes = std::array<double, width>{};
+	auto sum_squares_lanes = std::array<double, width>{};
+	auto min_lanes = std::array<double, width>{};
+	auto max_lanes = std::array<double, width>{};
+	_mm256_storeu_pd(sum_lanes.data(), sum);
+	_mm256_storeu_pd(sum_squares_lanes.data(), sum_squares);
+	_mm256_storeu_pd(min_lanes.data(), min);
+	_mm256_storeu_pd(max_lanes.data(), max);
+	auto moments = reduce_lanes(sum_lanes, sum_squares_lanes, min_lanes, max_lanes);
+	accumulate_scalar(moments, values + i, n - i, shift);
+	return moments;
+}
+
+__attribute__((target("avx512f"))) auto moments_avx512(double const* values, std::size_t n, double shift) noexcept
+	-> Moments {
+	static auto constexpr width = std::size_t{8};
+	static auto constexpr all_lanes = static_cast<__mmask8>(0xFF);
+	auto const shift_vec = _mm512_set1_pd(shift);
+	auto sum = _mm512_setzero_pd();
+	auto sum_squares = _mm512_setzero_pd();
+	auto min = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+	auto max = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+
+	std::size_t i = 0;
+	for (; i + width <= n; i += width) {
+		auto const vals = _mm512_loadu_pd(values + i);
+		auto const shifted = _mm512_sub_pd(vals, shift_vec);
+		sum = _mm512_add_pd(sum, shifted);
+		sum_squares = _mm512_add_pd(sum_squares, _mm512_mul_pd(shifted, shifted));
+		// The second operand is returned if any is NaN.
+		// Masked variants avoid a GCC uninitialized false positive in the unmasked intrinsics.
+		min = _mm512_mask_min_pd(min, all_lanes, vals, min);
+		max = _mm512_mask_max_pd(max, all_lanes, vals, max);
+	}
+
+	auto sum_lanes = std::array<double, width>{};
+	auto sum_squares_lanes = std::array<double, width>{};
+	auto min_lanes = std::array<double, width>{};
+	auto max_lanes = std::array<double, width>{};
+	_mm512_storeu_pd(sum_lanes.data(), sum);
+	_mm512_storeu_pd(sum_squares_lanes.data(), sum_squares);
+	_mm512_storeu_pd(min_lanes.data(), min);
+	_mm512_storeu_pd(max_lanes.data(), max);
+	auto moments = reduce_lanes(sum_lanes, sum_squares_lanes, min_lanes, max_lanes);
+	accumulate_scalar(moments, values + i, n - i, shift);
+	return moments;
+}
+
+#endif
+
+using MomentsKernel = Moments (*)(double const*, std::size_t, double) noexcept;
+
+auto get_kernel(StatsKernel kernel) noexcept -> MomentsKernel {
+	switch (kernel) {
+#ifdef ECOLE_STATS_X86
+	case StatsKernel::avx512:
+		return moments_avx512;
+	case StatsKernel::avx2:
+		return moments_avx2;
+#endif
+	default:
+		return moments_scalar;
+	}
+}
+
+/** The best kernel supported by the CPU, detected once. */
+auto best_kernel() noexcept -> StatsKernel {
+	static auto const kernel = [] {
+		for (auto const candidate : {StatsKernel::avx512, StatsKernel::avx2}) {
+			if (is_supported(candidate)) {
+				return candidate;
+			}
+		}
+		return StatsKernel::scalar;
+	}();
+	return kernel;
+}
+
+}  // namespace
+
+auto is_supported(StatsKernel kernel) noexcept -> bool {
+	switch (kernel) {
+#ifdef ECOLE_STATS_X86
+	case StatsKernel::avx512:
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx512f") != 0;
+	case StatsKernel::avx2:
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	case StatsKernel::automatic:
+	case StatsKernel::scalar:
+		return true;
+	default:
+		return false;
+	}
+}
+
+auto compute_stats(nonstd::span<double const> values, StatsKernel kernel) noexcept -> StatsFeatures<double> {
+	if (values.empty()) {
+		return {};
+	}
+	if (!is_supported(kernel) || (kernel == StatsKernel::automatic)) {
+		kernel = best_kernel();
+	}
+
+	auto const shift = values[0];
+	auto const moments = get_kernel(kernel)(values.data(), values.size(), shift);
+	auto const count = static_cast<double>(values.size());
+	auto const mean_shifted = moments.sum / count;
+	auto const variance = std::max((moments.sum_squares / count) - (mean_shifted * mean_shifted), 0.);
+	return {
+		count,
+		moments.sum + shift * count,
+		mean_shifted + shift,
+		std::sqrt(variance),
+		moments.min,
+		moments.max,
+	};
+}
+
+}  // namespace ecole::utility
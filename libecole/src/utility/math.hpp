@@ -2,9 +2,15 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
+#include <nonstd/span.hpp>
+
+#include "ecole/export.hpp"
+
 namespace ecole::utility {
 
 /**
@@ -29,17 +35,23 @@ namespace internal {
 template <typename R>
 using range_value_type_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<R>().begin())>>;
 
+/** Whether a range stores doubles contiguously in memory, such as a std::vector<double>. */
+template <typename R, typename = void> struct is_contiguous_double : std::false_type {};
+template <typename R>
+struct is_contiguous_double<R, std::void_t<decltype(std::data(std::declval<R const&>()))>> :
+	std::is_same<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<R const&>()))>>, double> {};
+template <typename R> inline constexpr bool is_contiguous_double_v = is_contiguous_double<R>::value;
+
 }  // namespace internal
 
 /**
- * Compute the sum of and count of elements.
+ * Compute the count and the sum of elements.
  *
- * @param range The container to iteratre over.
- * @param transform A callable to apply on every element of the container.
- * @param filter A callable to filter in elements (after transformation).
+ * @param range The container to iterate over.
+ * @return The count and the sum, in that order, with the sum in the type of the elements.
  */
 template <typename Range, typename U = internal::range_value_type_t<Range>>
-auto count_sum(Range range) noexcept -> std::pair<U, std::size_t> {
+auto count_sum(Range range) noexcept -> std::pair<std::size_t, U> {
 	auto sum = U{0};
 	auto count = std::size_t{0};
 
@@ -62,10 +74,16 @@ template <typename T> struct StatsFeatures {
 	T max = 0.;
 };
 
+/**
+ * Compute the statistics of a range, one element at a time.
+ *
+ * Contiguous ranges of doubles use the vectorized overload below instead.
+ */
 template <
 	typename Range,
 	typename U = internal::range_value_type_t<Range>,
-	typename T = std::conditional_t<std::is_floating_point_v<U>, U, double>>
+	typename T = std::conditional_t<std::is_floating_point_v<U>, U, double>,
+	typename = std::enable_if_t<!internal::is_contiguous_double_v<Range>>>
 auto compute_stats(Range range) noexcept -> StatsFeatures<T> {
 	auto const [count, sum] = count_sum(range);
 
@@ -78,7 +96,7 @@ auto compute_stats(Range range) noexcept -> StatsFeatures<T> {
 	auto const mean = safe_div(static_cast<T>(sum), static_cast<T>(count));
 	auto stddev = T{0.};
 	auto min = std::numeric_limits<U>::max();
-	auto max = std::numeric_limits<U>::min();
+	auto max = std::numeric_limits<U>::lowest();
 
 	for (auto const element : range) {
 		min = std::min(min, element);
@@ -90,4 +108,25 @@ auto compute_stats(Range range) noexcept -> StatsFeatures<T> {
 	return {static_cast<T>(count), static_cast<T>(sum), mean, stddev, static_cast<T>(min), static_cast<T>(max)};
 }
 
+/** The implementations of the statistics of contiguous values. */
+enum struct StatsKernel { automatic, scalar, avx2, avx512 };
+
+/** Whether the kernel can run on the current CPU. */
+ECOLE_EXPORT auto is_supported(StatsKernel kernel) noexcept -> bool;
+
+/**
+ * Compute the statistics of contiguous values in a single pass.
+ *
+ * Count, sum, sum of squares, min and max are accumulated together, using AVX-512 or AVX2 instructions when the CPU
+ * supports them (detected at runtime), and a scalar loop otherwise.
+ * Squares are accumulated on values shifted by the first one, which keeps the variance accurate when the mean is large
+ * compared to the standard deviation.
+ *
+ * @param values The values, NaN are ignored in the min and max.
+ * @param kernel The implementation to use, the automatic choice falls back to the scalar kernel if the one requested
+ *        is not supported.
+ */
+ECOLE_EXPORT auto compute_stats(nonstd::span<double const> values, StatsKernel kernel = StatsKernel::automatic) noexcept
+	-> StatsFeatures<double>;
+
 }  // namespace ecole::utility
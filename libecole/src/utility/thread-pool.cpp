@@ -0,0 +1,62 @@
+#include <utility>
+
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::utility {
+
+ThreadPool::ThreadPool(std::size_t n_threads) {
+	workers.reserve(n_threads);
+	for (std::size_t i = 0; i < n_threads; ++i) {
+		auto& worker = *workers.emplace_back(std::make_unique<Worker>());
+		worker.thread = std::thread{[&worker] { work(worker); }};
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	for (auto& worker : workers) {
+		{
+			auto lock = std::lock_guard{worker->mutex};
+			worker->stop = true;
+		}
+		worker->cv.notify_one();
+	}
+	for (auto& worker : workers) {
+		worker->thread.join();
+	}
+}
+
+auto ThreadPool::n_threads() const noexcept -> std::size_t {
+	return workers.size();
+}
+
+void ThreadPool::push(std::size_t worker, Task task) {
+	if (workers.empty()) {
+		task();
+		return;
+	}
+	auto& the_worker = *workers[worker % workers.size()];
+	{
+		auto lock = std::lock_guard{the_worker.mutex};
+		the_worker.tasks.push_back(std::move(task));
+	}
+	the_worker.cv.notify_one();
+}
+
+void ThreadPool::work(Worker& worker) {
+	while (true) {
+		auto task = Task{};
+		{
+			auto lock = std::unique_lock{worker.mutex};
+			worker.cv.wait(lock, [&worker] { return worker.stop || !worker.tasks.empty(); });
+			// Pending tasks are still processed after stop is requested.
+			if (worker.tasks.empty()) {
+				return;
+			}
+			task = std::move(worker.tasks.front());
+			worker.tasks.pop_front();
+		}
+		task();
+	}
+}
+
+}  // namespace ecole::utility
@@ -4,6 +4,7 @@
 #include <catch2/catch.hpp>
 
 #include "ecole/dynamics/configuring.hpp"
+#include "ecole/scip/compiled-params.hpp"
 
 #include "conftest.hpp"
 #include "dynamics/unit-tests.hpp"
@@ -49,5 +50,15 @@ TEST_CASE("ConfiguringDynamics functional tests", "[dynamics]") {
 		for (auto const& name_val : params) {
 			REQUIRE(name_val.second == model.get_param<decltype(name_val.second)>(name_val.first));
 		}
+
+		SECTION("Compiled in advance") {
+			auto other = get_model();
+			dyn.reset_dynamics(other);
+			dyn.step_dynamics(other, scip::CompiledParams{model, params});
+			REQUIRE(other.is_solved());
+			for (auto const& name_val : params) {
+				REQUIRE(name_val.second == other.get_param<decltype(name_val.second)>(name_val.first));
+			}
+		}
 	}
 }
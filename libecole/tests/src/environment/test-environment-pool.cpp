@@ -0,0 +1,87 @@
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/environment/pool.hpp"
+#include "ecole/information/nothing.hpp"
+#include "ecole/none.hpp"
+#include "ecole/observation/nothing.hpp"
+#include "ecole/random.hpp"
+#include "ecole/reward/constant.hpp"
+
+#include "conftest.hpp"
+
+/****************************************
+ *  Mocking some classes for unit test  *
+ ****************************************/
+
+namespace ecole {
+namespace dynamics {
+
+/**
+ * Dummy dynamics terminating after a number of steps equal to its last action.
+ */
+struct CountdownDynamics {
+	using Action = int;
+
+	int remaining = 0;
+
+	auto set_dynamics_random_state(scip::Model& /*model*/, RandomGenerator& /*rng*/) -> void {}
+
+	auto reset_dynamics(scip::Model& /*model*/) -> std::tuple<bool, NoneType> {
+		remaining = 2;
+		return {false, None};
+	}
+
+	auto step_dynamics(scip::Model& /*model*/, int const& action) -> std::tuple<bool, NoneType> {
+		remaining -= action;
+		return {remaining <= 0, None};
+	}
+};
+
+}  // namespace dynamics
+
+namespace environment {
+
+using CountdownPool =
+	EnvironmentPool<dynamics::CountdownDynamics, observation::Nothing, reward::Constant, information::Nothing>;
+
+}  // namespace environment
+}  // namespace ecole
+
+/**************************
+ *  Test EnvironmentPool  *
+ **************************/
+
+using namespace ecole;
+
+TEST_CASE("EnvironmentPool transitions all environments", "[env]") {
+	auto const n_threads = GENERATE(std::size_t{0}, std::size_t{2});
+	auto pool = environment::CountdownPool{3, n_threads};
+	pool.seed(0);
+	auto const filenames = std::vector<std::string>(pool.size(), problem_file);
+
+	SECTION("Reset all environments") {
+		auto const batch = pool.reset(filenames);
+		REQUIRE(batch.dones == std::vector<bool>{false, false, false});
+		REQUIRE(batch.rewards.size() == pool.size());
+	}
+
+	SECTION("Step until all environments are done") {
+		pool.reset(filenames);
+		auto batch = pool.step(std::vector{1, 2, 1});
+		REQUIRE(batch.dones == std::vector<bool>{false, true, false});
+		batch = pool.step(std::vector{1, 1, 1});
+		REQUIRE(batch.dones == std::vector<bool>{true, true, true});
+		// Terminated environments are left untouched
+		REQUIRE(pool.environment(1).dynamics().remaining == 0);
+	}
+
+	SECTION("Reject actions of wrong size") {
+		pool.reset(filenames);
+		REQUIRE_THROWS_AS(pool.step(std::vector{1}), std::invalid_argument);
+	}
+}
@@ -11,6 +11,7 @@
 #include "ecole/random.hpp"
 #include "ecole/reward/constant.hpp"
 #include "ecole/traits.hpp"
+#include "ecole/utility/completion-queue.hpp"
 
 #include "conftest.hpp"
 
@@ -111,3 +112,34 @@ TEST_CASE("Environments have MDP API", "[env]") {
 		REQUIRE_THROWS_AS(env.step(some_action), MarkovError);
 	}
 }
+
+TEST_CASE("Environments have asynchronous MDP API", "[env]") {
+	auto env = environment::TestEnv{};
+	constexpr double some_action = 3.0;
+	using Calls = dynamics::TestDynamics::Calls;
+
+	SECTION("Wait on futures") {
+		auto [obs, action_set, reward, done, info] = env.reset_async(problem_file).get();
+		std::tie(obs, action_set, reward, done, info) = env.step_async(some_action).get();
+		REQUIRE(env.dynamics().calls == std::vector{Calls::seed, Calls::reset, Calls::step});
+		REQUIRE(env.dynamics().last_action == some_action);
+	}
+
+	SECTION("Futures hold exceptions") {
+		auto result = env.step_async(some_action);
+		REQUIRE_THROWS_AS(result.get(), MarkovError);
+	}
+
+	SECTION("Wait on completion queue") {
+		auto queue = utility::CompletionQueue<environment::TestEnv::Completion<int>>{};
+		env.reset_async(queue, 1, problem_file);
+		auto [tag, result] = queue.pop();
+		REQUIRE(tag == 1);
+		REQUIRE_FALSE(std::get<3>(result.get()));
+		env.step_async(queue, 2, some_action);
+		std::tie(tag, result) = queue.pop();
+		REQUIRE(tag == 2);
+		REQUIRE(env.dynamics().calls == std::vector{Calls::seed, Calls::reset, Calls::step});
+		REQUIRE_FALSE(queue.try_pop().has_value());
+	}
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/exception.hpp"
+#include "ecole/instance/files.hpp"
+#include "ecole/instance/prefetching.hpp"
+#include "ecole/instance/set-cover.hpp"
+
+#include "conftest.hpp"
+#include "instance/unit-tests.hpp"
+#include "test-utility/tmp-folder.hpp"
+
+using namespace ecole;
+
+namespace {
+
+// Keep problem size reasonable for tests
+std::size_t constexpr n_rows = 100;
+std::size_t constexpr n_cols = 200;
+auto constexpr set_cover_params = instance::SetCoverGenerator::Parameters{n_rows, n_cols};
+
+auto make_set_cover() -> std::unique_ptr<instance::InstanceGenerator> {
+	return std::make_unique<instance::SetCoverGenerator>(set_cover_params);
+}
+
+/** A generator without any instance. */
+struct EmptyGenerator : instance::InstanceGenerator {
+	scip::Model next() override { throw IteratorExhausted{}; }
+	void seed(Seed /*seed*/) override {}
+	[[nodiscard]] bool done() const override { return true; }
+};
+
+}  // namespace
+
+TEST_CASE("PrefetchingGenerator unit test", "[unit][instance]") {
+	auto const n_workers = GENERATE(std::size_t{0}, std::size_t{1}, std::size_t{3});
+	auto generator = instance::PrefetchingGenerator{make_set_cover(), n_workers, 4};
+	REQUIRE(generator.n_workers() == n_workers);
+	REQUIRE_FALSE(generator.done());
+
+	SECTION("Successive instances are different") {
+		auto const model1 = generator.next();
+		auto const model2 = generator.next();
+		REQUIRE_FALSE(instance::same_problem_permutation(model1, model2));
+	}
+
+	SECTION("Same seed give reproducible results") {
+		generator.seed(0);
+		auto const model1 = generator.next();
+		generator.seed(0);
+		auto const model2 = generator.next();
+		REQUIRE(instance::same_problem_permutation(model1, model2));
+	}
+}
+
+TEST_CASE("PrefetchingGenerator gives the instances of the wrapped generator", "[instance]") {
+	auto const n_workers = GENERATE(std::size_t{0}, std::size_t{3});
+	// NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto serial = instance::SetCoverGenerator{set_cover_params, RandomGenerator{}};
+	auto parallel = instance::PrefetchingGenerator{
+		// NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+		std::make_unique<instance::SetCoverGenerator>(set_cover_params, RandomGenerator{}),
+		n_workers,
+		2};
+	static auto constexpr n_instances = 5;
+	for (auto i = 0; i < n_instances; ++i) {
+		REQUIRE(instance::same_problem_permutation(serial.next(), parallel.next()));
+	}
+}
+
+TEST_CASE("PrefetchingGenerator keeps the sampling mode of files", "[instance]") {
+	using SamplingMode = instance::FileGenerator::Parameters::SamplingMode;
+	auto const tmp_folder = TmpFolderRAII{};
+	auto model = get_model();
+	static auto constexpr n_files = 4;
+	for (auto i = 0; i < n_files; ++i) {
+		model.set_name("m" + std::to_string(i));
+		model.write_problem(tmp_folder.make_subpath(".mps"));
+	}
+	auto const params = instance::FileGenerator::Parameters{tmp_folder.dir().string(), true, SamplingMode::remove};
+	// NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto serial = instance::FileGenerator{params, RandomGenerator{}};
+	// NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto files = std::make_unique<instance::FileGenerator>(params, RandomGenerator{});
+	auto parallel = instance::PrefetchingGenerator{std::move(files), 3, 2};
+
+	auto names = std::vector<std::string>{};
+	for (auto i = 0; i < n_files; ++i) {
+		auto const name = parallel.next().name();
+		REQUIRE(name == serial.next().name());
+		REQUIRE(std::find(names.begin(), names.end(), name) == names.end());
+		names.push_back(name);
+	}
+	REQUIRE(parallel.done());
+	REQUIRE_THROWS_AS(parallel.next(), IteratorExhausted);
+}
+
+TEST_CASE("PrefetchingGenerator forwards exhaustion", "[instance]") {
+	auto const n_workers = GENERATE(std::size_t{0}, std::size_t{2});
+	auto generator = instance::PrefetchingGenerator{std::make_unique<EmptyGenerator>(), n_workers, 2};
+	REQUIRE(generator.done());
+	REQUIRE_THROWS_AS(generator.next(), IteratorExhausted);
+}
@@ -0,0 +1,161 @@
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+#include <xtensor/xadapt.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xtensor.hpp>
+#include <xtensor/xview.hpp>
+
+#include "ecole/observation/collate.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/observation/pseudocosts.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+namespace {
+
+/** Compare tensors, considering that NaN are equal. */
+template <typename Tensor1, typename Tensor2> auto all_equal(Tensor1 const& a, Tensor2 const& b) -> bool {
+	return (a.shape() == b.shape()) && xt::all(xt::equal(a, b) || (xt::isnan(a) && xt::isnan(b)));
+}
+
+/** Memory owned by the caller of collate. */
+template <typename T> struct Buffer {
+	std::vector<T> data;
+	std::vector<std::size_t> offsets;
+
+	Buffer(std::size_t n_rows, std::size_t n_cols, std::size_t n_obs) : data(n_rows * n_cols), offsets(n_obs + 1) {}
+
+	auto matrix(std::size_t n_cols) -> observation::BatchMatrix<T> { return {data, n_cols, offsets}; }
+};
+
+}  // namespace
+
+TEST_CASE("BatchMatrix unit tests", "[unit][obs]") {
+	auto buffer = Buffer<double>{4, 2, 2};  // NOLINT(readability-magic-numbers)
+	auto batch = buffer.matrix(2);
+	REQUIRE(batch.capacity() == 4);
+
+	SECTION("Append observations one after the other") {
+		batch.append(1).fill(1.);
+		batch.append(2).fill(2.);
+		REQUIRE(batch.n_observations() == 2);
+		REQUIRE(batch.n_rows() == 3);
+		REQUIRE(buffer.offsets == std::vector<std::size_t>{0, 1, 3});
+		REQUIRE(buffer.data == std::vector<double>{1., 1., 2., 2., 2., 2., 0., 0.});
+	}
+
+	SECTION("Pad rows after the last observation") {
+		batch.append(1).fill(1.);
+		batch.pad(-1.);
+		REQUIRE(buffer.data == std::vector<double>{1., 1., -1., -1., -1., -1., -1., -1.});
+	}
+
+	SECTION("Reuse memory after clearing") {
+		batch.append(3);
+		batch.clear();
+		REQUIRE(batch.n_observations() == 0);
+		REQUIRE(batch.append(4).shape()[0] == 4);
+	}
+
+	SECTION("Throw when the capacity is exceeded") {
+		batch.append(3);
+		REQUIRE_THROWS_AS(batch.append(2), std::length_error);
+		batch.append(1);
+		REQUIRE_THROWS_AS(batch.append(0), std::length_error);
+	}
+
+	SECTION("Throw on inconsistent number of columns") {
+		REQUIRE_THROWS_AS(buffer.matrix(3), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Collated NodeBipartite observations match extracted ones", "[obs]") {
+	using Features = observation::NodeBipartiteFeatures;
+	auto model = get_model();
+	auto const cache = GENERATE(true, false);
+	auto obs_funcs = std::array{observation::NodeBipartite{cache}, observation::NodeBipartite{cache}};
+	auto extract_func = observation::NodeBipartite{cache};
+	for (auto& func : obs_funcs) {
+		func.before_reset(model);
+	}
+	extract_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = extract_func.extract(model, false).value();
+
+	auto const n_vars = obs.variable_features.shape()[0];
+	auto const n_rows = obs.row_features.shape()[0];
+	auto const nnz = obs.edge_features.nnz();
+	auto var_buffer = Buffer<double>{2 * n_vars, Features::n_variable_features, 2};
+	auto row_buffer = Buffer<double>{2 * n_rows, Features::n_row_features, 2};
+	auto values_buffer = Buffer<double>{2 * nnz, 1, 2};
+	auto indices_buffer = Buffer<std::size_t>{2 * nnz, 2, 2};
+	auto batch = observation::NodeBipartiteBatch<double>{
+		var_buffer.matrix(Features::n_variable_features),
+		row_buffer.matrix(Features::n_row_features),
+		values_buffer.matrix(1),
+		indices_buffer.matrix(2),
+	};
+
+	observation::collate(
+		std::array{&obs_funcs[0], &obs_funcs[1]}, std::array{&model, &model}, std::array{false, false}, batch);
+	REQUIRE(batch.variable_features.offsets()[2] == 2 * n_vars);
+	REQUIRE(batch.row_features.offsets()[2] == 2 * n_rows);
+	REQUIRE(batch.edge_values.offsets()[2] == 2 * nnz);
+
+	auto const var_features = xt::adapt(var_buffer.data, std::array{2 * n_vars, Features::n_variable_features});
+	auto const row_features = xt::adapt(row_buffer.data, std::array{2 * n_rows, Features::n_row_features});
+	auto const edge_values = xt::adapt(values_buffer.data, std::array{2 * nnz});
+	auto const edge_indices = xt::adapt(indices_buffer.data, std::array{2 * nnz, std::size_t{2}});
+	auto const second = xt::range(n_vars, 2 * n_vars);
+	REQUIRE(all_equal(xt::view(var_features, second, xt::all()), obs.variable_features));
+	REQUIRE(all_equal(xt::view(row_features, xt::range(n_rows, 2 * n_rows), xt::all()), obs.row_features));
+	REQUIRE(xt::view(edge_values, xt::range(nnz, 2 * nnz)) == obs.edge_features.values);
+	// Indices of the second observation are shifted by the size of the first
+	auto const second_indices = xt::view(edge_indices, xt::range(nnz, 2 * nnz), xt::all());
+	REQUIRE(xt::col(second_indices, 0) == xt::row(obs.edge_features.indices, 0) + n_rows);
+	REQUIRE(xt::col(second_indices, 1) == xt::row(obs.edge_features.indices, 1) + n_vars);
+}
+
+TEST_CASE("Collated Khalil2016 and Pseudocosts observations match extracted ones", "[obs]") {
+	auto model = get_model();
+	auto khalil = observation::Khalil2016{};
+	auto pseudocosts = observation::Pseudocosts{};
+	khalil.before_reset(model);
+	pseudocosts.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const n_vars = model.variables().size();
+	auto const n_features = observation::Khalil2016Features::n_features;
+
+	SECTION("Khalil2016") {
+		auto buffer = Buffer<double>{n_vars, n_features, 1};
+		auto batch = buffer.matrix(n_features);
+		observation::collate(std::array{&khalil}, std::array{&model}, std::array{false}, batch);
+		auto const obs = khalil.extract(model, false).value();
+		REQUIRE(all_equal(xt::adapt(buffer.data, std::array{n_vars, n_features}), obs.features));
+	}
+
+	SECTION("Pseudocosts") {
+		auto buffer = Buffer<double>{n_vars, 1, 1};
+		auto batch = buffer.matrix(1);
+		observation::collate(std::array{&pseudocosts}, std::array{&model}, std::array{false}, batch);
+		auto const obs = pseudocosts.extract(model, false).value();
+		REQUIRE(all_equal(xt::adapt(buffer.data, std::array{n_vars}), obs));
+	}
+
+	SECTION("Empty observation outside of solving stage") {
+		auto buffer = Buffer<double>{n_vars, n_features, 1};
+		auto batch = buffer.matrix(n_features);
+		auto other_model = get_model();
+		REQUIRE_FALSE(khalil.extract_into(other_model, false, batch));
+		REQUIRE(batch.n_observations() == 1);
+		REQUIRE(batch.n_rows() == 0);
+	}
+}
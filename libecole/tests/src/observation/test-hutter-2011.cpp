@@ -1,14 +1,19 @@
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
 #include <type_traits>
 
 #include <catch2/catch.hpp>
+#include <xtensor/xmath.hpp>
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/hutter-2011.hpp"
 
 #include "conftest.hpp"
 #include "observation/unit-tests.hpp"
+#include "test-utility/tmp-folder.hpp"
 
 using namespace ecole;
 
@@ -36,7 +41,8 @@ TEST_CASE("Hutter2011 unit tests", "[unit][obs]") {
 TEST_CASE("Hutter2011 return correct observation", "[obs]") {
 	using Features = observation::Hutter2011Obs::Features;
 
-	auto obs_func = observation::Hutter2011{};
+	auto const copy_model = GENERATE(true, false);
+	auto obs_func = observation::Hutter2011{copy_model};
 	auto model = get_model();
 	obs_func.before_reset(model);
 	auto const optional_obs = obs_func.extract(model, false);
@@ -99,6 +105,8 @@ TEST_CASE("Hutter2011 return correct observation", "[obs]") {
 			auto const q25_degree = get_feature(Features::node_degree_25q);
 			auto const q75_degree = get_feature(Features::node_degree_75q);
 			REQUIRE(is_sorted(min_degree, q25_degree, q75_degree, max_degree));
+			REQUIRE(is_sorted(0., get_feature(Features::clustering_coef_mean), 1.));
+			REQUIRE(0. <= get_feature(Features::clustering_coef_std));
 			REQUIRE(is_sorted(0., get_feature(Features::edge_density), 1.));
 		}
 
@@ -127,3 +135,55 @@ TEST_CASE("Hutter2011 return correct observation", "[obs]") {
 		}
 	}
 }
+
+TEST_CASE("Hutter2011 LP relaxation does not depend on copying the model", "[obs]") {
+	using Features = observation::Hutter2011Obs::Features;
+	auto copy_func = observation::Hutter2011{true};
+	auto lpi_func = observation::Hutter2011{false};
+	auto model = get_model();
+	copy_func.before_reset(model);
+	lpi_func.before_reset(model);
+
+	auto const copy_obs = copy_func.extract(model, false).value();
+	auto const lpi_obs = lpi_func.extract(model, false).value();
+	auto const get_feature = [](auto const& obs, auto feat) { return obs.features[static_cast<std::size_t>(feat)]; };
+	REQUIRE(
+		get_feature(lpi_obs, Features::lp_objective_value) ==
+		Approx(get_feature(copy_obs, Features::lp_objective_value)).epsilon(1e-6));  // NOLINT(readability-magic-numbers)
+	REQUIRE(model.stage() == SCIP_STAGE_PROBLEM);
+}
+
+TEST_CASE("Hutter2011 variable graph features are NaN above the maximum number of edges", "[obs]") {
+	using Features = observation::Hutter2011Obs::Features;
+	auto const n_threads = GENERATE(std::size_t{0}, std::size_t{2});
+	auto obs_func = observation::Hutter2011{false, n_threads, 0};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	auto const obs = obs_func.extract(model, false).value();
+
+	for (auto feat = static_cast<std::size_t>(Features::node_degree_mean);
+	     feat <= static_cast<std::size_t>(Features::edge_density);
+	     ++feat) {
+		REQUIRE(std::isnan(obs.features[feat]));
+	}
+	REQUIRE_FALSE(std::isnan(obs.features[static_cast<std::size_t>(Features::nb_variables)]));
+}
+
+TEST_CASE("Hutter2011 features are shared between episodes through the file cache", "[obs]") {
+	auto const tmp_folder = TmpFolderRAII{};
+	auto obs_func = observation::Hutter2011{};
+	auto const max_edges = observation::Hutter2011::default_max_var_graph_edges;
+	auto cached_obs_func = observation::Hutter2011{false, 0, max_edges, tmp_folder.dir()};
+	for (auto episode = 0; episode < 2; ++episode) {
+		auto model = get_model();
+		obs_func.before_reset(model);
+		cached_obs_func.before_reset(model);
+		auto const obs = obs_func.extract(model, false).value();
+		auto const cached_obs = cached_obs_func.extract(model, false).value();
+		auto const is_equal = xt::equal(obs.features, cached_obs.features);
+		auto const both_nan = xt::isnan(obs.features) && xt::isnan(cached_obs.features);
+		REQUIRE(xt::all(is_equal || both_nan));
+	}
+	auto const files = std::filesystem::directory_iterator{tmp_folder.dir()};
+	REQUIRE(std::distance(begin(files), end(files)) == 1);
+}
@@ -1,3 +1,6 @@
+#include <filesystem>
+#include <iterator>
+
 #include <catch2/catch.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/transform.hpp>
@@ -12,6 +15,7 @@
 
 #include "conftest.hpp"
 #include "observation/unit-tests.hpp"
+#include "test-utility/tmp-folder.hpp"
 
 namespace views = ranges::views;
 
@@ -163,3 +167,90 @@ TEST_CASE("Khalil2016 return correct observation", "[obs]") {
 		}
 	}
 }
+
+TEST_CASE("Khalil2016 static features do not depend on the number of threads", "[obs]") {
+	auto const n_threads = GENERATE(std::size_t{1}, std::size_t{3});
+	auto serial_func = observation::Khalil2016{0};
+	auto parallel_func = observation::Khalil2016{0, n_threads};
+	auto model = get_model();
+	serial_func.before_reset(model);
+	parallel_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const serial_obs = serial_func.extract(model, false).value();
+	auto const parallel_obs = parallel_func.extract(model, false).value();
+	auto const is_equal = xt::equal(serial_obs.features, parallel_obs.features);
+	auto const both_nan = xt::isnan(serial_obs.features) && xt::isnan(parallel_obs.features);
+	REQUIRE(xt::all(is_equal || both_nan));
+}
+
+TEST_CASE("Khalil2016 with a feature mask matches the selected columns of the full observation", "[obs]") {
+	using Features = observation::Khalil2016Features::Features;
+	// Ratios need the root degree statistics that are not selected
+	auto mask = observation::Khalil2016Features::FeaturesMask{};
+	mask.deselect(Features::rows_deg_mean).deselect(Features::rows_deg_min).deselect(Features::rows_deg_max);
+	mask.deselect(Features::pseudocost_up).deselect(Features::n_cutoff_down_ratio);
+	for (auto f = static_cast<std::size_t>(Features::active_coef_weight1_count);
+	     f <= static_cast<std::size_t>(Features::active_coef_weight4_max);
+	     ++f) {
+		mask.deselect(static_cast<Features>(f));
+	}
+	auto full_func = observation::Khalil2016{};
+	auto masked_func = observation::Khalil2016{0, 0, mask};
+	auto model = get_model();
+	full_func.before_reset(model);
+	masked_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const full_obs = full_func.extract(model, false).value();
+	auto const masked_obs = masked_func.extract(model, false).value();
+	REQUIRE(masked_obs.features.shape(0) == full_obs.features.shape(0));
+	REQUIRE(masked_obs.features.shape(1) == mask.n_selected());
+	for (auto const feature : mask.features()) {
+		auto const expected = xt::view(full_obs.features, xt::all(), static_cast<std::size_t>(feature));
+		auto const col = xt::view(masked_obs.features, xt::all(), mask.column(feature));
+		REQUIRE(xt::all(xt::equal(col, expected) || (xt::isnan(col) && xt::isnan(expected))));
+	}
+}
+
+TEST_CASE("Khalil2016 features do not depend on profiling", "[obs]") {
+	auto func = observation::Khalil2016{};
+	auto profiled_func = observation::Khalil2016{};
+	profiled_func.profiler().enable();
+	auto model = get_model();
+	func.before_reset(model);
+	profiled_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const obs = func.extract(model, false).value();
+	auto const profiled_obs = profiled_func.extract(model, false).value();
+	auto const is_equal = xt::equal(obs.features, profiled_obs.features);
+	auto const both_nan = xt::isnan(obs.features) && xt::isnan(profiled_obs.features);
+	REQUIRE(xt::all(is_equal || both_nan));
+
+	REQUIRE(func.profiler().groups().empty());
+	for (auto const* group : {"static features", "row summaries", "active constraint coefficients"}) {
+		REQUIRE(profiled_func.profiler().group(group) != nullptr);
+		REQUIRE(profiled_func.profiler().group(group)->n_calls == 1);
+	}
+}
+
+TEST_CASE("Khalil2016 static features are shared between episodes through the file cache", "[obs]") {
+	auto const tmp_folder = TmpFolderRAII{};
+	auto func = observation::Khalil2016{};
+	auto cached_func = observation::Khalil2016{0, 0, {}, tmp_folder.dir()};
+	for (auto episode = 0; episode < 2; ++episode) {
+		auto model = get_model();
+		func.before_reset(model);
+		cached_func.before_reset(model);
+		advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+		auto const obs = func.extract(model, false).value();
+		auto const cached_obs = cached_func.extract(model, false).value();
+		auto const is_equal = xt::equal(obs.features, cached_obs.features);
+		auto const both_nan = xt::isnan(obs.features) && xt::isnan(cached_obs.features);
+		REQUIRE(xt::all(is_equal || both_nan));
+	}
+	auto const files = std::filesystem::directory_iterator{tmp_folder.dir()};
+	REQUIRE(std::distance(begin(files), end(files)) == 1);
+}
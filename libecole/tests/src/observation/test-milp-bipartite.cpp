@@ -1,4 +1,6 @@
 #include <cstddef>
+#include <filesystem>
+#include <iterator>
 
 #include <catch2/catch.hpp>
 #include <xtensor/xmath.hpp>
@@ -8,6 +10,7 @@
 
 #include "conftest.hpp"
 #include "observation/unit-tests.hpp"
+#include "test-utility/tmp-folder.hpp"
 
 using namespace ecole;
 
@@ -54,3 +57,41 @@ TEST_CASE("MilpBipartite return correct observation", "[obs]") {
 		}
 	}
 }
+
+TEST_CASE("MilpBipartite observation does not depend on the number of threads", "[obs]") {
+	auto const normalize = GENERATE(true, false);
+	auto model = get_model();
+	auto obs_func = observation::MilpBipartite{normalize};
+	auto threaded_obs_func = observation::MilpBipartite{normalize, 4};
+	obs_func.before_reset(model);
+	threaded_obs_func.before_reset(model);
+	auto const obs = obs_func.extract(model, false).value();
+	auto const threaded_obs = threaded_obs_func.extract(model, false).value();
+
+	REQUIRE(threaded_obs.constraint_features == obs.constraint_features);
+	REQUIRE(threaded_obs.edge_features.values == obs.edge_features.values);
+	REQUIRE(threaded_obs.edge_features.indices == obs.edge_features.indices);
+	REQUIRE(threaded_obs.edge_features.shape == obs.edge_features.shape);
+}
+
+TEST_CASE("MilpBipartite observations are shared between episodes through the file cache", "[obs]") {
+	auto const tmp_folder = TmpFolderRAII{};
+	auto const normalize = GENERATE(true, false);
+	auto obs_func = observation::MilpBipartiteF32{normalize};
+	auto cached_obs_func = observation::MilpBipartiteF32{normalize, 0, {}, tmp_folder.dir()};
+	for (auto episode = 0; episode < 2; ++episode) {
+		auto model = get_model();
+		obs_func.before_reset(model);
+		cached_obs_func.before_reset(model);
+		auto const obs = obs_func.extract(model, false).value();
+		auto const cached_obs = cached_obs_func.extract(model, false).value();
+
+		REQUIRE(cached_obs.variable_features == obs.variable_features);
+		REQUIRE(cached_obs.constraint_features == obs.constraint_features);
+		REQUIRE(cached_obs.edge_features.values == obs.edge_features.values);
+		REQUIRE(cached_obs.edge_features.indices == obs.edge_features.indices);
+		REQUIRE(cached_obs.edge_features.shape == obs.edge_features.shape);
+	}
+	auto const files = std::filesystem::directory_iterator{tmp_folder.dir()};
+	REQUIRE(std::distance(begin(files), end(files)) == 1);
+}
@@ -1,9 +1,11 @@
 #include <cstddef>
+#include <tuple>
 
 #include <catch2/catch.hpp>
 #include <xtensor/xmath.hpp>
 #include <xtensor/xview.hpp>
 
+#include "ecole/dynamics/branching.hpp"
 #include "ecole/observation/node-bipartite.hpp"
 
 #include "conftest.hpp"
@@ -13,6 +15,7 @@ using namespace ecole;
 
 TEST_CASE("NodeBipartite unit tests", "[unit][obs]") {
 	observation::unit_tests(observation::NodeBipartite{});
+	observation::unit_tests(observation::NodeBipartiteF32{});
 }
 
 TEST_CASE("NodeBipartite return correct observation", "[obs]") {
@@ -53,3 +56,124 @@ TEST_CASE("NodeBipartite return correct observation", "[obs]") {
 		REQUIRE_FALSE(xt::all(xt::isnan(obs.row_features)));
 	}
 }
+
+TEST_CASE("Incremental NodeBipartite matches full extraction", "[obs][slow]") {
+	auto constexpr n_steps = 10;
+	auto const csr_edges = GENERATE(false, true);
+	auto full_func = observation::NodeBipartite{};
+	auto incremental_func = observation::NodeBipartite{false, true, csr_edges};
+	auto model = get_model();
+	full_func.before_reset(model);
+	incremental_func.before_reset(model);
+
+	auto const all_close = [](auto const& a, auto const& b) {
+		return (a.shape() == b.shape()) && xt::all(xt::isclose(a, b, 1e-10, 1e-10, true));
+	};
+
+	auto dyn = dynamics::BranchingDynamics{};
+	auto [done, action_set] = dyn.reset_dynamics(model);
+	for (auto i = 0; (i < n_steps) && !done; ++i) {
+		auto const full = full_func.extract(model, done).value();
+		auto const incremental = incremental_func.extract(model, done).value();
+		REQUIRE(all_close(full.variable_features, incremental.variable_features));
+		REQUIRE(all_close(full.row_features, incremental.row_features));
+		auto const edges = csr_edges ? incremental.edge_features_csr.to_coo() : incremental.edge_features;
+		REQUIRE(all_close(full.edge_features.values, edges.values));
+		REQUIRE(full.edge_features.indices == edges.indices);
+		std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0]);
+	}
+}
+
+TEST_CASE("NodeBipartite extract edges in CSR format", "[obs][slow]") {
+	auto const incremental = GENERATE(true, false);
+	auto coo_func = observation::NodeBipartite{};
+	auto csr_func = observation::NodeBipartite{false, incremental, true};
+	auto model = get_model();
+	model.disable_cuts();
+	coo_func.before_reset(model);
+	csr_func.before_reset(model);
+
+	auto dyn = dynamics::BranchingDynamics{};
+	auto [done, action_set] = dyn.reset_dynamics(model);
+	auto const first_edges = csr_func.extract(model, done)->edge_features_csr;
+	auto const coo_edges = coo_func.extract(model, done)->edge_features;
+	REQUIRE(first_edges == utility::csr_matrix<double>::from_coo(coo_edges));
+
+	SECTION("Index arrays are not reallocated when the LP is unchanged") {
+		auto const edges = csr_func.extract(model, done)->edge_features_csr;
+		REQUIRE(edges == first_edges);
+		REQUIRE(edges.row_ptrs.get() == first_edges.row_ptrs.get());
+		REQUIRE(edges.col_indices.get() == first_edges.col_indices.get());
+	}
+
+	std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0]);
+	if (!done) {
+		auto const obs = csr_func.extract(model, done).value();
+		REQUIRE(obs.edge_features.nnz() == 0);
+		auto const& edges = obs.edge_features_csr;
+		auto const same_pattern = (edges.shape == first_edges.shape) && (*edges.row_ptrs == *first_edges.row_ptrs) &&
+		                          (*edges.col_indices == *first_edges.col_indices);
+		REQUIRE(edges.shares_indices_with(first_edges) == same_pattern);
+	}
+}
+
+TEST_CASE("Single precision NodeBipartite matches double precision", "[obs]") {
+	auto double_func = observation::NodeBipartite{};
+	auto float_func = observation::NodeBipartiteF32{};
+	auto model = get_model();
+	double_func.before_reset(model);
+	float_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const expected = double_func.extract(model, false).value();
+	auto const obs = float_func.extract(model, false).value();
+
+	auto const all_close = [](auto const& a, auto const& b) {
+		return (a.shape() == b.shape()) && xt::all(xt::isclose(xt::cast<float>(a), b, 1e-5, 1e-5, true));
+	};
+	REQUIRE(all_close(expected.variable_features, obs.variable_features));
+	REQUIRE(all_close(expected.row_features, obs.row_features));
+	REQUIRE(all_close(expected.edge_features.values, obs.edge_features.values));
+	REQUIRE(expected.edge_features.indices == obs.edge_features.indices);
+}
+
+TEST_CASE("NodeBipartite with feature masks matches the selected columns of the full observation", "[obs][slow]") {
+	using VariableFeatures = observation::NodeBipartiteFeatures::VariableFeatures;
+	using RowFeatures = observation::NodeBipartiteFeatures::RowFeatures;
+	auto constexpr n_steps = 5;
+	auto const cache = GENERATE(true, false);
+	auto const incremental = GENERATE(true, false);
+	auto variable_mask = observation::NodeBipartiteFeatures::VariableFeaturesMask{};
+	variable_mask.deselect(VariableFeatures::scaled_age).deselect(VariableFeatures::average_incumbent_value);
+	auto const row_mask =
+		observation::NodeBipartiteFeatures::RowFeaturesMask{RowFeatures::bias, RowFeatures::objective_cosine_similarity};
+	auto full_func = observation::NodeBipartite{cache, incremental};
+	auto masked_func = observation::NodeBipartite{cache, incremental, false, variable_mask, row_mask};
+	auto model = get_model();
+	full_func.before_reset(model);
+	masked_func.before_reset(model);
+
+	auto const same_columns = [](auto const& full, auto const& masked, auto const& mask) {
+		if ((masked.shape(0) != full.shape(0)) || (masked.shape(1) != mask.n_selected())) {
+			return false;
+		}
+		for (auto const feature : mask.features()) {
+			auto const expected = xt::view(full, xt::all(), static_cast<std::size_t>(feature));
+			auto const col = xt::view(masked, xt::all(), mask.column(feature));
+			if (!xt::all(xt::equal(col, expected) || (xt::isnan(col) && xt::isnan(expected)))) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	auto dyn = dynamics::BranchingDynamics{};
+	auto [done, action_set] = dyn.reset_dynamics(model);
+	for (auto i = 0; (i < n_steps) && !done; ++i) {
+		auto const full = full_func.extract(model, done).value();
+		auto const masked = masked_func.extract(model, done).value();
+		REQUIRE(same_columns(full.variable_features, masked.variable_features, variable_mask));
+		REQUIRE(same_columns(full.row_features, masked.row_features, row_mask));
+		REQUIRE(full.edge_features.values == masked.edge_features.values);
+		std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0]);
+	}
+}
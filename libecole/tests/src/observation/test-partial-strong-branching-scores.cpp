@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <cstddef>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+#include <xtensor/xindex_view.hpp>
+#include <xtensor/xmath.hpp>
+
+#include "ecole/observation/partial-strong-branching-scores.hpp"
+#include "ecole/observation/strong-branching-scores.hpp"
+
+#include "conftest.hpp"
+#include "observation/unit-tests.hpp"
+
+using namespace ecole;
+
+TEST_CASE("PartialStrongBranchingScores unit tests", "[unit][obs]") {
+	bool pseudo_candidates = GENERATE(true, false);
+	observation::unit_tests(observation::PartialStrongBranchingScores{pseudo_candidates, 2});
+}
+
+TEST_CASE("PartialStrongBranchingScores scores the best pseudocost candidates", "[obs]") {
+	auto const max_candidates = GENERATE(std::size_t{0}, std::size_t{2});
+	auto obs_func = observation::PartialStrongBranchingScores{false, max_candidates};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = obs_func.extract(model, false);
+
+	REQUIRE(obs.has_value());
+	auto const& scores = obs->scores;
+	auto const& is_exact = obs->is_exact;
+	REQUIRE(scores.size() == model.variables().size());
+	REQUIRE(is_exact.size() == model.variables().size());
+	auto const n_exact = static_cast<std::size_t>(std::count(is_exact.begin(), is_exact.end(), true));
+	REQUIRE(n_exact == std::min(max_candidates, model.lp_branch_cands().size()));
+	for (auto* const var : model.lp_branch_cands()) {
+		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		REQUIRE(scores[var_index] >= 0);
+	}
+	REQUIRE(xt::all(!is_exact || !xt::isnan(scores)));
+}
+
+TEST_CASE("PartialStrongBranchingScores without budget match StrongBranchingScores", "[obs]") {
+	auto partial_func = observation::PartialStrongBranchingScores{};
+	auto full_func = observation::StrongBranchingScores{};
+	auto partial_model = get_model();
+	auto full_model = partial_model.copy_orig();
+	partial_func.before_reset(partial_model);
+	full_func.before_reset(full_model);
+	advance_to_stage(partial_model, SCIP_STAGE_SOLVING);
+	advance_to_stage(full_model, SCIP_STAGE_SOLVING);
+
+	auto const partial_obs = partial_func.extract(partial_model, false);
+	auto const full_obs = full_func.extract(full_model, false);
+	REQUIRE(partial_obs.has_value());
+	REQUIRE(full_obs.has_value());
+	REQUIRE(xt::all(partial_obs->is_exact == !xt::isnan(full_obs.value())));
+	auto const& exact = partial_obs->is_exact;
+	REQUIRE(xt::allclose(xt::filter(partial_obs->scores, exact), xt::filter(full_obs.value(), exact)));
+}
@@ -0,0 +1,40 @@
+#include <catch2/catch.hpp>
+
+#include "ecole/observation/profiler.hpp"
+
+using namespace ecole;
+
+TEST_CASE("FeatureProfiler accumulates the time of each group", "[unit][obs]") {
+	auto profiler = observation::FeatureProfiler{true};
+	for (auto i = 0; i < 3; ++i) {
+		auto const timer = profiler.time("edges");
+	}
+	{ auto const timer = profiler.time("variable features"); }
+	profiler.record("edges", 1., 2.);
+
+	auto const& groups = profiler.groups();
+	REQUIRE(groups.size() == 2);
+	REQUIRE(groups[0].name == "edges");
+	REQUIRE(groups[1].name == "variable features");
+	auto const* const edges = profiler.group("edges");
+	REQUIRE(edges == &groups[0]);
+	REQUIRE(edges->n_calls == 4);
+	REQUIRE(edges->wall_time >= 1.);
+	REQUIRE(edges->cpu_time >= 2.);
+	REQUIRE(profiler.group("unknown") == nullptr);
+
+	profiler.reset();
+	REQUIRE(profiler.groups().empty());
+	REQUIRE(profiler.enabled());
+}
+
+TEST_CASE("Disabled FeatureProfiler does not record groups", "[unit][obs]") {
+	auto profiler = observation::FeatureProfiler{};
+	REQUIRE_FALSE(profiler.enabled());
+	{ auto const timer = profiler.time("edges"); }
+	REQUIRE(profiler.groups().empty());
+
+	profiler.enable();
+	{ auto const timer = profiler.time("edges"); }
+	REQUIRE(profiler.group("edges")->n_calls == 1);
+}
@@ -29,3 +29,25 @@ TEST_CASE("StrongBranchingScores return correct branchig scores", "[obs]") {
 	REQUIRE(not_nan_scores.size() > 0);
 	REQUIRE(xt::all(not_nan_scores >= 0));
 }
+
+TEST_CASE("StrongBranchingScores computed in threads match the branching rule", "[obs]") {
+	bool pseudo_candidates = GENERATE(true, false);
+	auto serial_func = observation::StrongBranchingScores{pseudo_candidates};
+	auto threads_func = observation::StrongBranchingScores{pseudo_candidates, 2};
+	auto serial_model = get_model();
+	auto threads_model = serial_model.copy_orig();
+	serial_func.before_reset(serial_model);
+	threads_func.before_reset(threads_model);
+	advance_to_stage(serial_model, SCIP_STAGE_SOLVING);
+	advance_to_stage(threads_model, SCIP_STAGE_SOLVING);
+
+	auto const serial_obs = serial_func.extract(serial_model, false);
+	auto const threads_obs = threads_func.extract(threads_model, false);
+	REQUIRE(serial_obs.has_value());
+	REQUIRE(threads_obs.has_value());
+	auto const& serial_scores = serial_obs.value();
+	auto const& threads_scores = threads_obs.value();
+	REQUIRE(xt::all(xt::isnan(serial_scores) == xt::isnan(threads_scores)));
+	auto const scored = !xt::isnan(serial_scores);
+	REQUIRE(xt::allclose(xt::filter(serial_scores, scored), xt::filter(threads_scores, scored), 1e-5));
+}
@@ -0,0 +1,63 @@
+#include <map>
+#include <string>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+
+#include "ecole/scip/compiled-params.hpp"
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Compiled parameters are set on models", "[scip]") {
+	auto const name_values = std::map<std::string, scip::Param>{
+		{"branching/scorefunc", 's'},
+		{"branching/scorefac", 0.1},
+		{"branching/divingpscost", false},
+		{"conflict/lpiterations", 0},
+		{"limits/totalnodes", 3},
+		{"heuristics/undercover/fixingalts", std::string("ln")},
+	};
+	auto model = get_model();
+	auto const params = scip::CompiledParams{model, name_values};
+	REQUIRE(params.size() == name_values.size());
+
+	auto check_params = [](scip::Model const& m) {
+		REQUIRE(m.get_param<char>("branching/scorefunc") == 's');
+		REQUIRE(m.get_param<double>("branching/scorefac") == Approx(0.1));
+		REQUIRE_FALSE(m.get_param<bool>("branching/divingpscost"));
+		REQUIRE(m.get_param<int>("conflict/lpiterations") == 0);
+		REQUIRE(m.get_param<SCIP_Longint>("limits/totalnodes") == 3);
+		REQUIRE(m.get_param<std::string>("heuristics/undercover/fixingalts") == "ln");
+	};
+
+	SECTION("On the model used to compile") {
+		model.set_params(params);
+		check_params(model);
+	}
+
+	SECTION("On other models with the same plugins") {
+		auto other = get_model();
+		other.set_params(params);
+		check_params(other);
+	}
+
+	SECTION("On models with other parameters") {
+		auto other = get_model();
+		auto* const scip = other.get_scip_ptr();
+		scip::call(SCIPaddIntParam, scip, "ecole/test", "Test parameter.", nullptr, false, 0, 0, 1, nullptr, nullptr);
+		other.set_params(params);
+		check_params(other);
+	}
+}
+
+TEST_CASE("Compiled parameters are validated", "[scip]") {
+	auto model = get_model();
+	REQUIRE_THROWS_AS((scip::CompiledParams{model, {{"not/a/param", 1}}}), scip::ScipError);
+	REQUIRE_THROWS_AS((scip::CompiledParams{model, {{"limits/solutions", -5}}}), scip::ScipError);
+	REQUIRE_THROWS_AS((scip::CompiledParams{model, {{"branching/scorefunc", std::string("long")}}}), scip::ScipError);
+}
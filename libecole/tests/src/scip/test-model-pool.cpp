@@ -0,0 +1,122 @@
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+
+#include "ecole/scip/model-pool.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Released models are reused", "[scip]") {
+	scip::ModelPool::clear();
+	SCIP* scip = nullptr;
+	{
+		auto model = get_model();
+		scip = model.get_scip_ptr();
+	}
+	REQUIRE(scip::ModelPool::size() == 1);
+	auto model = scip::Model{};
+	REQUIRE(model.get_scip_ptr() == scip);
+	REQUIRE(scip::ModelPool::size() == 0);
+
+	SECTION("Without their problem nor parameters") {
+		REQUIRE(model.stage() == SCIP_STAGE_INIT);
+		REQUIRE(model.get_param<int>("limits/solutions") == -1);
+		REQUIRE(scip::ModelPool::has_default_plugins(model.get_scip_ptr()));
+	}
+
+	SECTION("And can solve a new problem") {
+		model.read_problem(problem_file);
+		model.solve();
+		REQUIRE(model.is_solved());
+	}
+}
+
+TEST_CASE("Models with parameters changed are reset", "[scip]") {
+	scip::ModelPool::clear();
+	{
+		auto model = get_model();
+		model.set_param("limits/solutions", 3);
+		scip::call(SCIPfixParam, model.get_scip_ptr(), "limits/nodes");
+	}
+	auto model = scip::Model{};
+	REQUIRE(model.get_param<int>("limits/solutions") == -1);
+	REQUIRE(SCIPisParamFixed(model.get_scip_ptr(), "limits/nodes") == FALSE);
+}
+
+TEST_CASE("Models in the middle of solving are recycled", "[scip]") {
+	scip::ModelPool::clear();
+	{
+		auto model = get_model();
+		model.set_param("limits/totalnodes", 1);
+		model.solve();
+	}
+	REQUIRE(scip::ModelPool::size() == 1);
+	auto model = get_model();
+	model.solve();
+	REQUIRE(model.is_solved());
+}
+
+TEST_CASE("Models are recycled with a verbose message handler", "[scip]") {
+	scip::ModelPool::clear();
+	{
+		auto model = get_model();
+		model.set_messagehdlr_quiet(true);
+	}
+	REQUIRE(scip::ModelPool::size() == 1);
+	auto const scip = scip::ModelPool::acquire();
+	REQUIRE(SCIPmessagehdlrIsQuiet(SCIPgetMessagehdlr(scip.get())) == FALSE);
+}
+
+TEST_CASE("Models not created by the pool are not recycled", "[scip]") {
+	scip::ModelPool::clear();
+	{
+		// Copies while solving are made in new instances with the same number of plugins
+		auto model = get_model();
+		model.set_param("limits/totalnodes", 1);
+		model.solve();
+		auto copy = model.copy();
+		REQUIRE_FALSE(scip::ModelPool::has_default_plugins(copy.get_scip_ptr()));
+	}
+	REQUIRE(scip::ModelPool::size() == 1);
+}
+
+TEST_CASE("Models with extra plugins are not recycled", "[scip]") {
+	scip::ModelPool::clear();
+	{
+		// Iterative solving includes a callback
+		auto model = get_model(SCIP_STAGE_SOLVING);
+		REQUIRE_FALSE(scip::ModelPool::has_default_plugins(model.get_scip_ptr()));
+	}
+	REQUIRE(scip::ModelPool::size() == 0);
+}
+
+TEST_CASE("Pool keeps at most its capacity", "[scip]") {
+	auto const capacity = scip::ModelPool::capacity();
+	scip::ModelPool::set_capacity(1);
+	{
+		auto model1 = get_model();
+		auto model2 = get_model();
+	}
+	REQUIRE(scip::ModelPool::size() == 1);
+	scip::ModelPool::set_capacity(0);
+	REQUIRE(scip::ModelPool::size() == 0);
+	scip::ModelPool::set_capacity(capacity);
+}
+
+TEST_CASE("Copies of models with default plugins are taken from the pool", "[scip]") {
+	scip::ModelPool::clear();
+	auto model = get_model();
+	{ auto other = scip::Model{}; }
+	REQUIRE(scip::ModelPool::size() == 1);
+	auto copy = model.copy_orig();
+	REQUIRE(scip::ModelPool::size() == 0);
+	REQUIRE(copy.variables().size() == model.variables().size());
+	REQUIRE(copy.constraints().size() == model.constraints().size());
+	copy.solve();
+	model.solve();
+	REQUIRE(copy.is_solved());
+	REQUIRE(SCIPgetPrimalbound(copy.get_scip_ptr()) == Approx(SCIPgetPrimalbound(model.get_scip_ptr())));
+}
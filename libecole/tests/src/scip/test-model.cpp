@@ -3,6 +3,7 @@
 #include <limits>
 #include <random>
 #include <string>
+#include <vector>
 
 #include <catch2/catch.hpp>
 #include <scip/scip.h>
@@ -36,6 +37,26 @@ TEST_CASE("Raise if file does not exist", "[scip]") {
 	REQUIRE_THROWS_AS(scip::Model::from_file("/does_not_exist.mps"), scip::ScipError);
 }
 
+TEST_CASE("Model fingerprint depends on the content of the problem", "[scip]") {
+	auto model = get_model();
+	auto other = get_model();
+	other.set_name("other");
+	REQUIRE(model.fingerprint() == other.fingerprint());
+
+	auto* const var = other.variables()[0];
+	scip::call(SCIPchgVarObj, other.get_scip_ptr(), var, SCIPvarGetObj(var) + 1.);
+	REQUIRE(model.fingerprint() != other.fingerprint());
+
+	SECTION("While solving") {
+		auto solving_model = get_model();
+		auto solving_other = get_model();
+		advance_to_stage(solving_model, SCIP_STAGE_SOLVING);
+		advance_to_stage(solving_other, SCIP_STAGE_SOLVING);
+		REQUIRE(solving_model.fingerprint() == solving_other.fingerprint());
+		REQUIRE(solving_model.fingerprint() != model.fingerprint());
+	}
+}
+
 TEST_CASE("Model transform", "[scip][slow]") {
 	auto model = get_model();
 	model.transform_prob();
@@ -63,6 +84,54 @@ TEST_CASE("Model solving", "[scip][slow]") {
 	}
 }
 
+TEST_CASE("Concurrent model copies", "[scip][slow]") {
+	auto constexpr n_threads = 8;
+	auto constexpr n_copies = 10;
+	auto const share_source = GENERATE(true, false);
+	// Different problems in different stages, so that concurrent copies go through different plugins and data
+	auto make_source = [](std::size_t i) {
+		switch (i % 4) {
+		case 0:
+			return get_model(SCIP_STAGE_PROBLEM);
+		case 1:
+			return get_model(SCIP_STAGE_TRANSFORMED);
+		case 2:
+			return get_model(SCIP_STAGE_SOLVING);
+		default:
+			return scip::Model::from_file(TEST_DATA_DIR "/enlight8.mps");
+		}
+	};
+	auto sources = std::vector<scip::Model>{};
+	// The number of variables of copies and original copies of every source
+	auto expected_n_vars = std::vector<std::array<std::size_t, 2>>{};
+	for (std::size_t i = 0; i < (share_source ? 1 : n_threads); ++i) {
+		sources.push_back(make_source(i));
+		expected_n_vars.push_back({sources.back().copy().variables().size(), sources.back().copy_orig().variables().size()});
+	}
+
+	auto copy_and_solve = [&sources, &expected_n_vars](std::size_t thread_idx) {
+		auto const& source = sources[thread_idx % sources.size()];
+		auto const [n_vars, n_orig_vars] = expected_n_vars[thread_idx % sources.size()];
+		for (auto i = 0; i < n_copies; ++i) {
+			auto const is_orig = (i % 2 == 0);
+			auto copy = is_orig ? source.copy_orig() : source.copy();
+			if (copy.variables().size() != (is_orig ? n_orig_vars : n_vars)) {
+				return false;
+			}
+		}
+		auto copy = source.copy_orig();
+		copy.solve();
+		return copy.is_solved();
+	};
+	auto futures = std::vector<std::future<bool>>{};
+	for (std::size_t i = 0; i < n_threads; ++i) {
+		futures.push_back(std::async(std::launch::async, copy_and_solve, i));
+	}
+	for (auto& fut : futures) {
+		REQUIRE(fut.get());
+	}
+}
+
 TEST_CASE("Explicit parameter management", "[scip]") {
 	using Catch::Contains;
 	using scip::ParamType;
@@ -199,6 +268,26 @@ TEST_CASE("Iterative branching", "[scip][slow]") {
 	}
 }
 
+TEST_CASE("Fork model while solving", "[scip][slow]") {
+	auto model = get_model();
+
+	SECTION("Cannot fork outside of solving") { REQUIRE_THROWS_AS(model.fork(), scip::ScipError); }
+
+	SECTION("Fork at branching nodes") {
+		auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
+		REQUIRE(fcall.has_value());
+		auto child = model.fork();
+		REQUIRE(child != model);
+		REQUIRE(child.stage() == SCIP_STAGE_PROBLEM);
+		child.solve();
+		REQUIRE(child.is_solved());
+		while (fcall.has_value()) {
+			fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+		}
+		REQUIRE(model.is_solved());
+	}
+}
+
 TEST_CASE("Iterative solving", "[scip][slow]") {
 	auto model = get_model();
 	auto const constructors = std::array<scip::callback::DynamicConstructor, 2>{
@@ -0,0 +1,80 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/param-snapshot.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Parameter snapshots restore models", "[scip]") {
+	auto model = get_model();
+	auto const snapshot = scip::ParamSnapshot{model};
+	REQUIRE(snapshot.size() == model.get_params().size());
+
+	model.set_param("branching/scorefunc", 'p');
+	model.set_param("limits/totalnodes", 3);
+	model.set_param("heuristics/undercover/fixingalts", std::string("ln"));
+
+	SECTION("Only the changed parameters are set") {
+		REQUIRE(snapshot.apply(model) == 3);
+		REQUIRE(model.get_params() == get_model().get_params());
+		REQUIRE(snapshot.apply(model) == 0);
+	}
+
+	SECTION("Differences between snapshots are the changed parameters") {
+		auto const diff = snapshot.diff(scip::ParamSnapshot{model});
+		REQUIRE(diff.size() == 3);
+		auto const* const params = SCIPgetParams(model.get_scip_ptr());
+		for (auto const i : diff) {
+			auto const name = std::string{SCIPparamGetName(params[i])};
+			REQUIRE(model.get_param<scip::Param>(name) != snapshot[i]);
+		}
+	}
+}
+
+TEST_CASE("Parameter snapshots apply to models with the same parameters only", "[scip]") {
+	auto model = get_model();
+	auto const snapshot = scip::ParamSnapshot{model};
+	auto other = get_model();
+	auto* const scip = other.get_scip_ptr();
+	scip::call(SCIPaddIntParam, scip, "ecole/test", "Test parameter.", nullptr, false, 0, 0, 1, nullptr, nullptr);
+	REQUIRE_THROWS_AS(snapshot.apply(other), scip::ScipError);
+	REQUIRE_THROWS_AS(snapshot.diff(scip::ParamSnapshot{other}), scip::ScipError);
+}
+
+TEST_CASE("Parameter snapshots detect parameters added after being applied", "[scip]") {
+	auto model = get_model();
+	auto const snapshot = scip::ParamSnapshot{model};
+	REQUIRE(snapshot.apply(model) == 0);
+	auto* const scip = model.get_scip_ptr();
+	scip::call(SCIPaddIntParam, scip, "ecole/test", "Test parameter.", nullptr, false, 0, 0, 1, nullptr, nullptr);
+	REQUIRE_THROWS_AS(snapshot.apply(model), scip::ScipError);
+	REQUIRE(scip::ParamSnapshot{model}.apply(model) == 0);
+}
+
+TEST_CASE("Rejected parameter snapshots leave the model untouched", "[scip]") {
+	auto add_param = [](scip::Model& model, char const* name) {
+		scip::call(
+			SCIPaddIntParam, model.get_scip_ptr(), name, "Test parameter.", nullptr, false, 0, 0, 1, nullptr, nullptr);
+	};
+	// Same number and types of parameters, but different names
+	auto model = get_model();
+	add_param(model, "ecole/test");
+	model.set_param("limits/totalnodes", 3);
+	auto const snapshot = scip::ParamSnapshot{model};
+	auto other = get_model();
+	add_param(other, "ecole/other");
+	auto const expected = other.get_params();
+
+	REQUIRE_THROWS_AS(snapshot.apply(other), scip::ScipError);
+	REQUIRE(other.get_params() == expected);
+	REQUIRE_THROWS_AS(snapshot.diff(scip::ParamSnapshot{other}), scip::ScipError);
+}
@@ -0,0 +1,50 @@
+#include <cstddef>
+#include <cstring>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/coroutine-stack.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Coroutine stacks are usable memory", "[utility]") {
+	auto constexpr size = 100000;
+	auto stack = utility::CoroutineStack{size};
+	REQUIRE(stack.size() >= size);
+	std::memset(stack.data(), 1, stack.size());
+}
+
+TEST_CASE("Coroutine stacks are reused on the same thread", "[utility]") {
+	utility::CoroutineStack::release_free_list();
+	void* data = nullptr;
+	{
+		auto stack = utility::CoroutineStack{};
+		data = stack.data();
+	}
+	auto stack = utility::CoroutineStack{};
+	REQUIRE(stack.data() == data);
+
+	SECTION("Unless they have a different size") {
+		auto other = utility::CoroutineStack{2 * stack.size()};
+		REQUIRE(other.data() != stack.data());
+	}
+}
+
+TEST_CASE("Reused coroutine stacks only keep their top committed", "[utility]") {
+	utility::CoroutineStack::release_free_list();
+	auto constexpr size = std::size_t{1024} * 1024;
+	char* bottom = nullptr;
+	char* top = nullptr;
+	{
+		auto stack = utility::CoroutineStack{size};
+		bottom = static_cast<char*>(stack.data());
+		top = bottom + stack.size() - 1;
+		*bottom = 1;
+		*top = 1;
+	}
+	auto const stack = utility::CoroutineStack{size};
+	REQUIRE(stack.data() == bottom);
+	// Released pages are zero filled when used again
+	REQUIRE(*bottom == 0);
+	REQUIRE(*top == 1);
+}
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <xtensor/xadapt.hpp>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xview.hpp>
+
+#include "ecole/utility/sparse-matrix.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+#include "utility/csr-graph.hpp"
+#include "utility/graph.hpp"
+
+using namespace ecole;
+
+namespace {
+
+/** A random sparse matrix with a few non zeros per row, and optionally a last row with all columns. */
+auto random_matrix(std::size_t n_rows, std::size_t n_cols, bool dense_row) -> utility::coo_matrix<double> {
+	auto rng = std::mt19937{};  // NOLINT(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto row_size = std::uniform_int_distribution<std::size_t>{0, 5};  // NOLINT(readability-magic-numbers)
+	auto col = std::uniform_int_distribution<std::size_t>{0, n_cols - 1};
+	auto rows = std::vector<std::size_t>{};
+	auto cols = std::vector<std::size_t>{};
+	for (std::size_t row = 0; row < n_rows; ++row) {
+		auto row_cols = std::vector<std::size_t>{};
+		for (auto n = row_size(rng); n > 0; --n) {
+			row_cols.push_back(col(rng));
+		}
+		std::sort(row_cols.begin(), row_cols.end());
+		row_cols.erase(std::unique(row_cols.begin(), row_cols.end()), row_cols.end());
+		rows.insert(rows.end(), row_cols.size(), row);
+		cols.insert(cols.end(), row_cols.begin(), row_cols.end());
+	}
+	if (dense_row) {
+		for (std::size_t c = 0; c < n_cols; ++c) {
+			rows.push_back(n_rows);
+			cols.push_back(c);
+		}
+	}
+
+	auto const nnz = rows.size();
+	auto matrix = utility::coo_matrix<double>{};
+	matrix.values = xt::ones<double>({nnz});
+	matrix.indices = decltype(matrix.indices)::from_shape({2, nnz});
+	xt::row(matrix.indices, 0) = xt::adapt(rows, {nnz});
+	xt::row(matrix.indices, 1) = xt::adapt(cols, {nnz});
+	matrix.shape = {dense_row ? n_rows + 1 : n_rows, n_cols};
+	return matrix;
+}
+
+/** The exact clustering coefficient, counting the triangles of a node with the reference graph. */
+auto clustering_coefficient(utility::Graph const& graph, std::size_t node) -> double {
+	auto const degree = graph.degree(node);
+	if (degree < 2) {
+		return 0.;
+	}
+	auto const& neighbors = graph.neighbors(node);
+	auto n_triangles = std::size_t{0};
+	for (auto const n1 : neighbors) {
+		for (auto const n2 : neighbors) {
+			n_triangles += ((n1 < n2) && graph.are_connected(n1, n2)) ? 1 : 0;
+		}
+	}
+	return static_cast<double>(2 * n_triangles) / static_cast<double>(degree * (degree - 1));
+}
+
+/** The reference graph of a column graph. */
+auto to_graph(utility::CsrGraph const& csr_graph) -> utility::Graph {
+	auto graph = utility::Graph{csr_graph.n_nodes()};
+	for (std::size_t n1 = 0; n1 < csr_graph.n_nodes(); ++n1) {
+		for (auto const n2 : csr_graph.neighbors(n1)) {
+			if (n1 < n2) {
+				graph.add_edge({n1, n2});
+			}
+		}
+	}
+	return graph;
+}
+
+}  // namespace
+
+TEST_CASE("Column graph of a matrix connects columns in the same row", "[utility][unit]") {
+	auto const n_threads = GENERATE(std::size_t{0}, std::size_t{3});
+	auto const dense_row = GENERATE(true, false);
+	std::size_t constexpr n_rows = 40;
+	std::size_t constexpr n_cols = 60;
+	auto const matrix = random_matrix(n_rows, n_cols, dense_row);
+	auto thread_pool = utility::ThreadPool{n_threads};
+
+	// Reference graph built edge by edge
+	auto expected = utility::Graph{n_cols};
+	for (std::size_t i = 0; i < matrix.nnz(); ++i) {
+		for (std::size_t j = 0; j < matrix.nnz(); ++j) {
+			auto const col_i = matrix.indices(1, i);
+			auto const col_j = matrix.indices(1, j);
+			if ((matrix.indices(0, i) == matrix.indices(0, j)) && (col_i < col_j) && !expected.are_connected(col_i, col_j)) {
+				expected.add_edge({col_i, col_j});
+			}
+		}
+	}
+
+	auto const graph = utility::column_graph(matrix, expected.n_edges(), &thread_pool);
+	REQUIRE(graph.has_value());
+	REQUIRE(graph->n_nodes() == n_cols);
+	REQUIRE(graph->n_edges() == expected.n_edges());
+	for (std::size_t n1 = 0; n1 < n_cols; ++n1) {
+		REQUIRE(graph->degree(n1) == expected.degree(n1));
+		auto const neighbors = graph->neighbors(n1);
+		REQUIRE(std::is_sorted(neighbors.begin(), neighbors.end()));
+		for (std::size_t n2 = 0; n2 < n_cols; ++n2) {
+			REQUIRE(graph->are_connected(n1, n2) == expected.neighbors(n1).contains(n2));
+		}
+	}
+
+	REQUIRE_FALSE(utility::column_graph(matrix, expected.n_edges() - 1, &thread_pool).has_value());
+}
+
+TEST_CASE("Clustering coefficient is the fraction of connected pairs of neighbors", "[utility][unit]") {
+	// A triangle 0-1-2, with 3 connected to 0, and 4 isolated.
+	auto matrix = utility::coo_matrix<double>{};
+	auto const rows = std::vector<std::size_t>{0, 0, 0, 1, 1};
+	auto const cols = std::vector<std::size_t>{0, 1, 2, 0, 3};
+	matrix.values = xt::ones<double>({rows.size()});
+	matrix.indices = decltype(matrix.indices)::from_shape({2, rows.size()});
+	xt::row(matrix.indices, 0) = xt::adapt(rows, {rows.size()});
+	xt::row(matrix.indices, 1) = xt::adapt(cols, {cols.size()});
+	matrix.shape = {2, 5};  // NOLINT(readability-magic-numbers)
+
+	auto const graph = utility::column_graph(matrix, 10, nullptr).value();  // NOLINT(readability-magic-numbers)
+	REQUIRE(graph.n_edges() == 4);
+	std::size_t constexpr n_wedges = 16;
+	REQUIRE(graph.estimate_clustering_coefficient(0, n_wedges) == Approx(1. / 3.));
+	REQUIRE(graph.estimate_clustering_coefficient(1, n_wedges) == Approx(1.));
+	REQUIRE(graph.estimate_clustering_coefficient(3, n_wedges) == 0.);
+	REQUIRE(graph.estimate_clustering_coefficient(4, n_wedges) == 0.);
+}
+
+TEST_CASE("Estimated clustering coefficient is exact on small neighborhoods", "[utility][unit]") {
+	auto const matrix = random_matrix(40, 60, false);  // NOLINT(readability-magic-numbers)
+	auto const graph = utility::column_graph(matrix, matrix.nnz() * matrix.nnz(), nullptr).value();
+	auto const reference = to_graph(graph);
+	for (std::size_t node = 0; node < graph.n_nodes(); ++node) {
+		auto const n_pairs = graph.degree(node) * graph.degree(node);
+		REQUIRE(graph.estimate_clustering_coefficient(node, n_pairs) == Approx(clustering_coefficient(reference, node)));
+	}
+}
+
+TEST_CASE("Clustering coefficient is estimated with a bounded cost on dense rows", "[utility]") {
+	// The dense row makes a clique in which every node has a degree of n_cols - 1.
+	std::size_t constexpr n_cols = 2000;
+	std::size_t constexpr n_wedges = 256;
+	auto const matrix = random_matrix(10, n_cols, true);  // NOLINT(readability-magic-numbers)
+	auto const graph = utility::column_graph(matrix, n_cols * n_cols, nullptr).value();
+	for (std::size_t node = 0; node < graph.n_nodes(); ++node) {
+		REQUIRE(graph.estimate_clustering_coefficient(node, n_wedges) == 1.);
+	}
+}
@@ -0,0 +1,53 @@
+#include <cmath>
+#include <optional>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/coroutine-stack.hpp"
+#include "ecole/utility/execution-context.hpp"
+
+using namespace ecole;
+
+namespace {
+
+/** A context that counts how many times it is resumed, and computes with floating points in between. */
+struct Counter {
+	utility::CoroutineStack stack;
+	utility::ExecutionContext main_context;
+	std::optional<utility::ExecutionContext> counter_context;
+	int n_resumed = 0;
+	double value = 0.;
+
+	static void run(void* self) noexcept {
+		auto* const counter = static_cast<Counter*>(self);
+		auto local = 0.;
+		while (true) {
+			++counter->n_resumed;
+			local = std::sqrt(local * local + 1.);
+			counter->value = local;
+			counter->counter_context->switch_to(counter->main_context);
+		}
+	}
+};
+
+}  // namespace
+
+TEST_CASE("Execution contexts switch back and forth", "[utility]") {
+	auto counter = Counter{};
+	counter.counter_context.emplace(counter.stack, &Counter::run, &counter);
+	auto constexpr n_switches = 1000;
+	auto local = 0.5;
+	for (int i = 0; i < n_switches; ++i) {
+		counter.main_context.switch_to(*counter.counter_context);
+		local += 1.;
+	}
+	REQUIRE(counter.n_resumed == n_switches);
+	REQUIRE(local == Approx(n_switches + 0.5));
+	REQUIRE(counter.value == Approx(std::sqrt(n_switches)));
+}
+
+TEST_CASE("Execution context backend is known", "[utility]") {
+	auto const backend = std::string{utility::ExecutionContext::backend()};
+	REQUIRE((backend == "fcontext" || backend == "ucontext"));
+}
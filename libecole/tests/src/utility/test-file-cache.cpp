@@ -0,0 +1,72 @@
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/file-cache.hpp"
+
+#include "test-utility/tmp-folder.hpp"
+
+using namespace ecole;
+
+TEST_CASE("FileCache stores and loads arrays", "[utility]") {
+	auto const tmp_folder = TmpFolderRAII{};
+	auto const cache = utility::FileCache{tmp_folder.dir() / "cache"};
+	auto const arrays = std::vector<utility::CachedArray>{
+		{{2, 3}, {1., 2., 3., 4., 5., -0.}},
+		{{0}, {}},
+		{{}, {42.}},
+	};
+
+	REQUIRE_FALSE(cache.load(7).has_value());
+	REQUIRE(cache.store(7, arrays));
+	auto const loaded = cache.load(7);
+	REQUIRE(loaded.has_value());
+	REQUIRE(loaded->size() == arrays.size());
+	for (std::size_t i = 0; i < arrays.size(); ++i) {
+		REQUIRE(loaded.value()[i].shape == arrays[i].shape);
+		REQUIRE(loaded.value()[i].values == arrays[i].values);
+	}
+	REQUIRE_FALSE(cache.load(8).has_value());
+
+	SECTION("Entries are replaced") {
+		REQUIRE(cache.store(7, {arrays.data(), 1}));
+		REQUIRE(cache.load(7)->size() == 1);
+	}
+
+	SECTION("Invalid files are ignored") {
+		std::ofstream{cache.path(7), std::ios::binary | std::ios::trunc} << "not a cache entry";
+		REQUIRE_FALSE(cache.load(7).has_value());
+	}
+
+	SECTION("Arrays must match their shape") {
+		auto const invalid = std::vector<utility::CachedArray>{{{2, 2}, {1., 2., 3.}}};
+		REQUIRE_THROWS_AS(cache.store(9, invalid), std::invalid_argument);
+		REQUIRE_FALSE(cache.load(9).has_value());
+	}
+}
+
+TEST_CASE("FileCache readers only see complete entries", "[utility]") {
+	auto const tmp_folder = TmpFolderRAII{};
+	auto const cache = utility::FileCache{tmp_folder.dir()};
+	auto const arrays = std::vector<utility::CachedArray>{{{1000}, std::vector<double>(1000, 3.)}};
+
+	auto writers = std::vector<std::thread>{};
+	for (auto i = 0; i < 4; ++i) {
+		writers.emplace_back([&] {
+			for (auto j = 0; j < 20; ++j) {
+				cache.store(1, arrays);
+			}
+		});
+	}
+	for (auto j = 0; j < 100; ++j) {
+		if (auto const loaded = cache.load(1); loaded.has_value()) {
+			REQUIRE(loaded->front().values == arrays.front().values);
+		}
+	}
+	for (auto& writer : writers) {
+		writer.join();
+	}
+	REQUIRE(cache.load(1).has_value());
+}
@@ -0,0 +1,86 @@
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <list>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "utility/math.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Statistics computed one element at a time keep fractional sums", "[utility][unit]") {
+	// count_sum used to return the sum in the integer count, giving a sum and mean of 0
+	auto const [count, sum] = utility::count_sum(std::list<double>{0.5, 0.25});  // NOLINT(readability-magic-numbers)
+	REQUIRE(count == 2);
+	REQUIRE(sum == 0.75);  // NOLINT(readability-magic-numbers)
+	auto const stats = utility::compute_stats(std::list<double>{0.5, 0.25});  // NOLINT(readability-magic-numbers)
+	REQUIRE(stats.sum == 0.75);  // NOLINT(readability-magic-numbers)
+	REQUIRE(stats.mean == 0.375);  // NOLINT(readability-magic-numbers)
+}
+
+TEST_CASE("Statistics computed one element at a time have negative maximums", "[utility][unit]") {
+	// The maximum used to start from the smallest positive double, which was returned for negative values
+	auto const stats = utility::compute_stats(std::list<double>{-3., -1.});
+	REQUIRE(stats.min == -3.);
+	REQUIRE(stats.max == -1.);
+}
+
+TEST_CASE("Vectorized statistics match statistics computed one element at a time", "[utility][unit]") {
+	auto const kernel = GENERATE(
+		utility::StatsKernel::automatic,
+		utility::StatsKernel::scalar,
+		utility::StatsKernel::avx2,
+		utility::StatsKernel::avx512);
+	auto const n_values = GENERATE(std::size_t{0}, 1, 3, 7, 8, 17, 1000);  // NOLINT(readability-magic-numbers)
+
+	// Large mean compared to the standard deviation
+	auto rng = std::mt19937{};  // NOLINT(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto distribution = std::normal_distribution<double>{1e6, 3.};  // NOLINT(readability-magic-numbers)
+	auto values = std::vector<double>(n_values);
+	for (auto& val : values) {
+		val = distribution(rng);
+	}
+
+	// A list is not contiguous and goes through the generic implementation
+	auto const expected = utility::compute_stats(std::list<double>{values.begin(), values.end()});
+	auto const stats = utility::compute_stats(values, kernel);
+	REQUIRE(stats.count == expected.count);
+	REQUIRE(stats.sum == Approx(expected.sum));
+	REQUIRE(stats.mean == Approx(expected.mean));
+	REQUIRE(stats.stddev == Approx(expected.stddev).epsilon(1e-6));  // NOLINT(readability-magic-numbers)
+	REQUIRE(stats.min == expected.min);
+	REQUIRE(stats.max == expected.max);
+}
+
+TEST_CASE("Vectorized statistics ignore NaN in min and max", "[utility][unit]") {
+	auto const kernel = GENERATE(
+		utility::StatsKernel::automatic,
+		utility::StatsKernel::scalar,
+		utility::StatsKernel::avx2,
+		utility::StatsKernel::avx512);
+	auto values = std::vector<double>(17, 1.);  // NOLINT(readability-magic-numbers)
+	values[3] = -2.;
+	values[9] = std::numeric_limits<double>::quiet_NaN();
+	values[16] = 5.;  // NOLINT(readability-magic-numbers)
+
+	auto const stats = utility::compute_stats(values, kernel);
+	REQUIRE(stats.min == -2.);
+	REQUIRE(stats.max == 5.);
+	REQUIRE(std::isnan(stats.mean));
+}
+
+TEST_CASE("Unsupported statistics kernels fall back to a supported one", "[utility][unit]") {
+	REQUIRE(utility::is_supported(utility::StatsKernel::automatic));
+	REQUIRE(utility::is_supported(utility::StatsKernel::scalar));
+	auto const values = std::vector<double>{-1., 0., 1.};
+	for (auto const kernel : {utility::StatsKernel::avx2, utility::StatsKernel::avx512}) {
+		auto const stats = utility::compute_stats(values, kernel);
+		REQUIRE(stats.count == 3.);
+		REQUIRE(stats.mean == 0.);
+		REQUIRE(stats.min == -1.);
+		REQUIRE(stats.max == 1.);
+	}
+}
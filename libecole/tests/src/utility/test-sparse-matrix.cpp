@@ -25,3 +25,34 @@ TEST_CASE("Sparse matrix unit unit tests", "[unit][utility]") {
 		REQUIRE(matrix_copy == matrix);
 	}
 }
+
+TEST_CASE("CSR matrix unit tests", "[unit][utility]") {
+	auto const coo = utility::coo_matrix<double>{
+		{2., 4., 7.},            // NOLINT(readability-magic-numbers)
+		{{0, 2, 2}, {1, 1, 2}},  // NOLINT(readability-magic-numbers)
+		{3, 3},                  // NOLINT(readability-magic-numbers)
+	};
+	using index_array = utility::csr_matrix<double>::index_array;
+	auto const matrix = utility::csr_matrix<double>::from_coo(coo);
+
+	SECTION("Convert from coordinate format") {
+		REQUIRE(matrix.nnz() == coo.nnz());
+		REQUIRE(*matrix.row_ptrs == index_array{0, 1, 1, 3});
+		REQUIRE(*matrix.col_indices == index_array{1, 1, 2});
+	}
+
+	SECTION("Convert to coordinate format") { REQUIRE(matrix.to_coo() == coo); }
+
+	SECTION("Copies share indices") {
+		auto matrix_copy = matrix;
+		REQUIRE(matrix_copy.shares_indices_with(matrix));
+		matrix_copy.values *= 2.;
+		REQUIRE_FALSE(matrix_copy == matrix);
+		REQUIRE(matrix_copy.shares_indices_with(matrix));
+	}
+
+	SECTION("Equality comparison does not depend on sharing") {
+		REQUIRE(utility::csr_matrix<double>::from_coo(coo) == matrix);
+		REQUIRE_FALSE(utility::csr_matrix<double>::from_coo(coo).shares_indices_with(matrix));
+	}
+}
@@ -0,0 +1,63 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/thread-pool.hpp"
+
+using namespace ecole;
+
+TEST_CASE("ThreadPool runs submitted tasks", "[utility]") {
+	auto const n_threads = GENERATE(std::size_t{0}, std::size_t{1}, std::size_t{3});
+	auto pool = utility::ThreadPool{n_threads};
+	REQUIRE(pool.n_threads() == n_threads);
+
+	SECTION("Submit return value") {
+		auto result = pool.submit(1, []() { return 42; });
+		REQUIRE(result.get() == 42);
+	}
+
+	SECTION("Submit propagates exceptions") {
+		auto result = pool.submit(0, []() -> int { throw std::runtime_error{"error"}; });
+		REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+	}
+
+	SECTION("Parallel for processes all indices") {
+		auto constexpr n = 100;
+		auto counts = std::vector<std::atomic<int>>(n);
+		pool.parallel_for(n, [&counts](std::size_t i) { counts[i]++; });
+		for (auto const& c : counts) {
+			REQUIRE(c == 1);
+		}
+	}
+
+	SECTION("Parallel for rethrows exception of lowest index") {
+		auto constexpr n = 10;
+		auto n_called = std::atomic<std::size_t>{0};
+		auto const func = [&n_called](std::size_t i) {
+			n_called++;
+			if (i == 3) {
+				throw std::invalid_argument{"three"};
+			}
+			if (i == 7) {
+				throw std::runtime_error{"seven"};
+			}
+		};
+		REQUIRE_THROWS_AS(pool.parallel_for(n, func), std::invalid_argument);
+		REQUIRE(n_called == n);
+	}
+}
+
+TEST_CASE("ThreadPool dispatches same index on same thread", "[utility]") {
+	auto constexpr n = 10;
+	auto pool = utility::ThreadPool{3};
+	auto first_ids = std::vector<std::thread::id>(n);
+	auto second_ids = std::vector<std::thread::id>(n);
+	pool.parallel_for(n, [&first_ids](std::size_t i) { first_ids[i] = std::this_thread::get_id(); });
+	pool.parallel_for(n, [&second_ids](std::size_t i) { second_ids[i] = std::this_thread::get_id(); });
+	REQUIRE(first_ids == second_ids);
+	REQUIRE(first_ids[0] != std::this_thread::get_id());
+}
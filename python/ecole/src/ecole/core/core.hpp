@@ -38,4 +38,8 @@ namespace dynamics {
 void bind_submodule(pybind11::module_ const& m);
 }
 
+namespace environment {
+void bind_submodule(pybind11::module_ const& m);
+}
+
 }  // namespace ecole
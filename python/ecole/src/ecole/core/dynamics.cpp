@@ -7,6 +7,7 @@
 #include "ecole/dynamics/branching.hpp"
 #include "ecole/dynamics/configuring.hpp"
 #include "ecole/dynamics/primal-search.hpp"
+#include "ecole/scip/compiled-params.hpp"
 #include "ecole/scip/model.hpp"
 
 #include "core.hpp"
@@ -166,23 +167,37 @@ void bind_submodule(pybind11::module_ const& m) {
 					action_set:
 						Unused.
 			)")
-			.def_step_dynamics(R"(
-				Set parameters and solve the instance.
-
-				Parameters
-				----------
-					model:
-						The state of the Markov Decision Process. Passed by the environment.
-					action:
-						A mapping of parameter names and values.
+			// Overloads are tried in order, compiled parameters first since they cannot be converted from a mapping
+			.def(
+				"step_dynamics",
+				py::overload_cast<scip::Model&, scip::CompiledParams const&>(
+					&ConfiguringDynamics::step_dynamics, py::const_),
+				py::arg("model"),
+				py::arg("action"),
+				py::call_guard<py::gil_scoped_release>())
+			.def(
+				"step_dynamics",
+				py::overload_cast<scip::Model&, ParamDict const&>(&ConfiguringDynamics::step_dynamics, py::const_),
+				py::arg("model"),
+				py::arg("action"),
+				py::call_guard<py::gil_scoped_release>(),
+				R"(
+					Set parameters and solve the instance.
 
-				Returns
-				-------
-					done:
-						Whether the instance is solved. Always true.
-					action_set:
-						Unused.
-			)")
+					Parameters
+					----------
+						model:
+							The state of the Markov Decision Process. Passed by the environment.
+						action:
+							A mapping of parameter names and values, or an :py:class:`~ecole.scip.CompiledParams`.
+
+					Returns
+					-------
+						done:
+							Whether the instance is solved. Always true.
+						action_set:
+							Unused.
+				)")
 			.def_set_dynamics_random_state(R"(
 				Set seeds on the :py:class:`~ecole.scip.Model`.
 
@@ -0,0 +1,190 @@
+#include <cstddef>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <xtensor-python/pytensor.hpp>
+
+#include "ecole/environment/branching.hpp"
+#include "ecole/environment/configuring.hpp"
+#include "ecole/environment/pool.hpp"
+#include "ecole/environment/primal-search.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "core.hpp"
+
+namespace ecole::environment {
+
+namespace py = pybind11;
+template <typename T> using Numpy = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+/** Convert the results of a transition to a tuple of lists, one element per environment. */
+template <typename Batch> auto batch_to_tuple(Batch&& batch) {
+	return std::make_tuple(
+		std::move(batch.observations),
+		std::move(batch.action_sets),
+		std::move(batch.rewards),
+		std::move(batch.dones),
+		std::move(batch.informations));
+}
+
+/** The data functions copied into every environment of a pool. */
+template <typename Pool> struct pool_functions;
+template <typename Dynamics, typename ObservationFunction, typename RewardFunction, typename InformationFunction>
+struct pool_functions<EnvironmentPool<Dynamics, ObservationFunction, RewardFunction, InformationFunction>> {
+	using observation_function = ObservationFunction;
+	using reward_function = RewardFunction;
+	using information_function = InformationFunction;
+};
+
+/**
+ * Bind an EnvironmentPool, except for its step method whose action conversion depends on the dynamics.
+ */
+template <typename Pool> auto def_pool(py::module_ const& m, char const* name, char const* docstring) {
+	using ObservationFunction = typename pool_functions<Pool>::observation_function;
+	using RewardFunction = typename pool_functions<Pool>::reward_function;
+	using InformationFunction = typename pool_functions<Pool>::information_function;
+	auto pool = py::class_<Pool>{m, name, docstring};
+	pool.def(
+		py::init<
+			std::size_t,
+			std::size_t,
+			ObservationFunction const&,
+			RewardFunction const&,
+			InformationFunction const&,
+			std::map<std::string, scip::Param> const&>(),
+		py::arg("n_environments"),
+		py::arg("n_threads") = std::thread::hardware_concurrency(),
+		py::arg("observation_function") = ObservationFunction{},
+		py::arg("reward_function") = RewardFunction{},
+		py::arg("information_function") = InformationFunction{},
+		py::arg("scip_params") = std::map<std::string, scip::Param>{},
+		R"(
+		Create the environments and the worker threads.
+
+		Parameters
+		----------
+		n_environments:
+			The number of environments in the pool.
+		n_threads:
+			The number of worker threads. Zero runs all environments in the calling thread.
+		observation_function, reward_function, information_function, scip_params:
+			Copied into every environment.
+	)");
+	pool.def("seed", &Pool::seed, py::arg("seed"), "Seed all environments with different seeds derived from this one.");
+	pool.def(
+		"reset",
+		[](Pool& self, std::vector<std::string> const& filenames) {
+			return batch_to_tuple(self.reset(nonstd::span<std::string const>{filenames}));
+		},
+		py::arg("instances"),
+		py::call_guard<py::gil_scoped_release>(),
+		R"(
+		Reset all environments in parallel, reading one problem file per environment.
+
+		Returns
+		-------
+		A tuple of lists ``(observations, action_sets, rewards, dones, informations)``, with one element per
+		environment.
+	)");
+	pool.def(
+		"reset",
+		[](Pool& self, std::vector<scip::Model const*> const& instances) {
+			auto const release = py::gil_scoped_release{};
+			// The problem definitions are copied, as done by Environment.reset
+			auto models = std::vector<scip::Model>{};
+			models.reserve(instances.size());
+			for (auto const* const instance : instances) {
+				models.push_back(instance->copy_orig());
+			}
+			return batch_to_tuple(self.reset(nonstd::span<scip::Model>{models}));
+		},
+		py::arg("instances"),
+		"Reset all environments in parallel, copying the problem of one model per environment.");
+	pool.def("__len__", &Pool::size);
+	pool.def_property_readonly("n_threads", &Pool::n_threads);
+	return pool;
+}
+
+void bind_submodule(py::module_ const& m) {
+	m.doc() = "Pools of environments transitioned in parallel.";
+
+	using BranchingPool = EnvironmentPool<
+		dynamics::BranchingDynamics,
+		observation::NodeBipartite,
+		reward::IsDone,
+		information::Nothing>;
+	def_pool<BranchingPool>(m, "BranchingPool", R"(
+		A fixed size collection of Branching environments transitioned in parallel.
+
+		The environments use the NodeBipartite observation, the IsDone reward, and no information.
+		The Python global interpreter lock is released while transitioning.
+	)")
+		.def(
+			"step",
+			[](BranchingPool& self, std::vector<BranchingPool::Action> const& actions) {
+				return batch_to_tuple(self.step(nonstd::span<BranchingPool::Action const>{actions}));
+			},
+			py::arg("actions"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Branch on one variable in every non terminal environment, in parallel.");
+
+	using ConfiguringPool = EnvironmentPool<
+		dynamics::ConfiguringDynamics,
+		observation::Nothing,
+		reward::IsDone,
+		information::Nothing>;
+	def_pool<ConfiguringPool>(m, "ConfiguringPool", R"(
+		A fixed size collection of Configuring environments transitioned in parallel.
+
+		The environments use no observation, the IsDone reward, and no information.
+		The Python global interpreter lock is released while transitioning.
+	)")
+		.def(
+			"step",
+			[](ConfiguringPool& self, std::vector<ConfiguringPool::Action> const& actions) {
+				return batch_to_tuple(self.step(nonstd::span<ConfiguringPool::Action const>{actions}));
+			},
+			py::arg("actions"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Set parameters and solve every non terminal environment, in parallel.");
+
+	using PrimalSearchPool = EnvironmentPool<
+		dynamics::PrimalSearchDynamics,
+		observation::NodeBipartite,
+		reward::IsDone,
+		information::Nothing>;
+	using idx_t = std::size_t;
+	using val_t = SCIP_Real;
+	def_pool<PrimalSearchPool>(m, "PrimalSearchPool", R"(
+		A fixed size collection of PrimalSearch environments transitioned in parallel.
+
+		The environments use the NodeBipartite observation, the IsDone reward, and no information.
+		The Python global interpreter lock is released while transitioning.
+	)")
+		.def(
+			"step",
+			[](PrimalSearchPool& self, std::vector<std::pair<Numpy<idx_t>, Numpy<val_t>>> const& actions) {
+				// The arrays are kept alive by the argument while the spans are used
+				auto spans = std::vector<PrimalSearchPool::Action>{};
+				spans.reserve(actions.size());
+				for (auto const& [indices, values] : actions) {
+					spans.emplace_back(
+						nonstd::span{indices.data(), static_cast<std::size_t>(indices.size())},
+						nonstd::span{values.data(), static_cast<std::size_t>(values.size())});
+				}
+				auto const release = py::gil_scoped_release{};
+				return batch_to_tuple(self.step(nonstd::span<PrimalSearchPool::Action const>{spans}));
+			},
+			py::arg("actions"),
+			"Search a primal solution from a partial assignment, given as a pair of arrays ``(indices, values)``, in "
+			"every non terminal environment, in parallel.");
+}
+
+}  // namespace ecole::environment
@@ -1,5 +1,8 @@
+#include <cstddef>
 #include <memory>
+#include <stdexcept>
 #include <tuple>
+#include <type_traits>
 
 #include <pybind11/pybind11.h>
 
@@ -7,6 +10,7 @@
 #include "ecole/instance/combinatorial-auction.hpp"
 #include "ecole/instance/files.hpp"
 #include "ecole/instance/independent-set.hpp"
+#include "ecole/instance/prefetching.hpp"
 #include "ecole/instance/set-cover.hpp"
 #include "ecole/utility/function-traits.hpp"
 
@@ -53,6 +57,11 @@ template <typename PyClass> void def_iterator(PyClass& py_class);
  */
 template <typename PyEnum> void def_init_str(PyEnum& py_enum);
 
+/**
+ * Copy the given Python instance generator, which must be one of the Generators types.
+ */
+template <typename... Generators> auto copy_generator(py::handle generator) -> std::unique_ptr<InstanceGenerator>;
+
 void bind_submodule(py::module const& m) {
 	m.doc() = "Random instance generators for Ecole.";
 
@@ -338,6 +347,60 @@ void bind_submodule(py::module const& m) {
 	def_attributes(capacitated_facility_location_gen, capacitated_facility_location_params);
 	def_iterator(capacitated_facility_location_gen);
 	capacitated_facility_location_gen.def("seed", &CapacitatedFacilityLocationGenerator::seed, py::arg(" seed"));
+
+	auto prefetching_gen = py::class_<PrefetchingGenerator>{m, "PrefetchingGenerator"};
+	prefetching_gen.def(
+		py::init([](py::handle generator, std::size_t n_workers, std::size_t queue_size) {
+			auto copy = copy_generator<
+				FileGenerator,
+				SetCoverGenerator,
+				IndependentSetGenerator,
+				CombinatorialAuctionGenerator,
+				CapacitatedFacilityLocationGenerator>(generator);
+			return std::make_unique<PrefetchingGenerator>(std::move(copy), n_workers, queue_size);
+		}),
+		py::arg("generator"),
+		py::arg("n_workers") = 1,
+		py::arg("queue_size") = 2,
+		R"(
+		Create a generator producing instances ahead of time in worker threads.
+
+		Instances are generated while the previous ones are being solved, and are the same as the ones of the given
+		generator.
+		A FileGenerator chooses the files in the calling thread, and all workers read them in parallel.
+		Random generators are used in order by a single worker, since their instances depend on all the random numbers
+		drawn before.
+
+		Parameters
+		----------
+		generator:
+			One of the instance generators of this module.
+			It is copied, so using it afterwards does not change the instances of this generator.
+		n_workers:
+			The number of worker threads.
+			Zero generates the instances in the calling thread on demand.
+		queue_size:
+			The maximum number of instances generated ahead of time.
+	)");
+	prefetching_gen.def_property_readonly("n_workers", &PrefetchingGenerator::n_workers);
+	def_iterator(prefetching_gen);
+	prefetching_gen.def("seed", &PrefetchingGenerator::seed, py::arg("seed"), py::call_guard<py::gil_scoped_release>());
+}
+
+template <typename... Generators> auto copy_generator(py::handle generator) -> std::unique_ptr<InstanceGenerator> {
+	auto copy = std::unique_ptr<InstanceGenerator>{};
+	auto copy_if_instance = [&](auto* type_tag) {
+		using Generator = std::remove_pointer_t<decltype(type_tag)>;
+		if (copy == nullptr && py::isinstance<Generator>(generator)) {
+			copy = std::make_unique<Generator>(generator.cast<Generator const&>());
+		}
+	};
+	// Try all generator types (comma operator fold expression).
+	(copy_if_instance(static_cast<Generators*>(nullptr)), ...);
+	if (copy == nullptr) {
+		throw std::invalid_argument{"Expected an instance generator from ecole.instance."};
+	}
+	return copy;
 }
 
 /******************************************
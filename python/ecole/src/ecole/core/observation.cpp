@@ -1,17 +1,26 @@
 #include <algorithm>
+#include <filesystem>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include <utility>
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
 #include <xtensor-python/pytensor.hpp>
 
+#include "ecole/observation/collate.hpp"
 #include "ecole/observation/hutter-2011.hpp"
 #include "ecole/observation/khalil-2016.hpp"
 #include "ecole/observation/milp-bipartite.hpp"
 #include "ecole/observation/node-bipartite.hpp"
 #include "ecole/observation/nothing.hpp"
+#include "ecole/observation/partial-strong-branching-scores.hpp"
+#include "ecole/observation/profiler.hpp"
 #include "ecole/observation/pseudocosts.hpp"
 #include "ecole/observation/strong-branching-scores.hpp"
 #include "ecole/python/auto-class.hpp"
@@ -24,6 +33,19 @@ namespace ecole::observation {
 
 namespace py = pybind11;
 
+/**
+ * Read-only numpy view over an array shared between matrices.
+ *
+ * The view holds a reference on the shared array so that it outlives the matrix.
+ */
+template <typename T> auto shared_array_view(std::shared_ptr<xt::xtensor<T, 1> const> const& array) -> py::array_t<T> {
+	using Owner = std::shared_ptr<xt::xtensor<T, 1> const>;
+	auto owner = py::capsule{new Owner{array}, [](void* ptr) { delete static_cast<Owner*>(ptr); }};
+	auto view = py::array_t<T>{{array->size()}, {sizeof(T)}, array->data(), owner};
+	view.attr("flags").attr("writeable") = false;
+	return view;
+}
+
 /**
  * Helper function to bind the `before_reset` method of observation functions.
  */
@@ -50,17 +72,164 @@ template <typename PyClass, typename... Args> auto def_extract(PyClass pyclass,
 }
 
 /**
- * Observation module bindings definitions.
+ * Helper function to bind the `extract_into` method of observation functions.
  */
-void bind_submodule(py::module_ const& m) {
-	m.doc() = "Observation classes for Ecole.";
+template <typename PyClass, typename... Args> auto def_extract_into(PyClass pyclass, Args&&... args) {
+	return pyclass.def(
+		"extract_into",
+		&PyClass::type::extract_into,
+		py::arg("model"),
+		py::arg("done"),
+		py::arg("batch"),
+		py::call_guard<py::gil_scoped_release>(),
+		std::forward<Args>(args)...);
+}
 
-	xt::import_numpy();
+/**
+ * Helper function to bind `collate` for an observation function and its batch type.
+ */
+template <typename Func, typename Batch> void def_collate(py::module_ m) {
+	m.def(
+		"collate",
+		[](std::vector<Func*> const& obs_funcs,
+			 std::vector<scip::Model*> const& models,
+			 std::vector<bool> const& dones,
+			 Batch& batch) { collate(obs_funcs, models, dones, batch); },
+		py::arg("obs_funcs"),
+		py::arg("models"),
+		py::arg("dones"),
+		py::arg("batch"),
+		py::call_guard<py::gil_scoped_release>(),
+		R"(
+		Write the observations of many models in the same batch.
 
-	m.attr("Nothing") = py::type::of<Nothing>();
+		The batch is cleared, and the observation of every model is written with ``extract_into``, in order.
+		Models without an observation get an empty one, so that the offsets of observation ``i`` are always at index
+		``i``.
+	)");
+}
+
+/**
+ * Helper function to bind the `profiler` property of observation functions.
+ */
+template <typename PyClass> auto def_profiler(PyClass pyclass) {
+	return pyclass.def_property_readonly(
+		"profiler",
+		[](typename PyClass::type& func) -> FeatureProfiler& { return func.profiler(); },
+		py::return_value_policy::reference_internal,
+		"The :py:class:`FeatureProfiler` timing the groups of features, disabled by default.");
+}
+
+/**
+ * Bind the profiler of the time spent computing groups of features.
+ */
+void bind_feature_profiler(py::module_ const& m) {
+	py::class_<ProfiledGroup>(m, "ProfiledGroup", "Cumulative time spent computing a group of features.")
+		.def_readonly("name", &ProfiledGroup::name)
+		.def_readonly("n_calls", &ProfiledGroup::n_calls)
+		.def_readonly("wall_time", &ProfiledGroup::wall_time, "Elapsed time in seconds.")
+		.def_readonly(
+			"cpu_time", &ProfiledGroup::cpu_time, "CPU time of the process in seconds, including the one of worker threads.");
+
+	py::class_<FeatureProfiler>(m, "FeatureProfiler", R"(
+		Record the time spent in each group of features of an observation function.
+
+		When the profiler is disabled, which is the default, feature groups are not timed.
+	)")
+		.def(py::init<bool>(), py::arg("enabled") = false)
+		.def_property(
+			"enabled",
+			&FeatureProfiler::enabled,
+			&FeatureProfiler::enable,
+			"Whether groups are timed, disabling keeps the times recorded so far.")
+		.def("reset", &FeatureProfiler::reset, "Forget the times recorded so far.")
+		.def_property_readonly(
+			"groups",
+			&FeatureProfiler::groups,
+			"The groups recorded so far, in the order in which they were first recorded.")
+		.def(
+			"group",
+			&FeatureProfiler::group,
+			py::arg("name"),
+			py::return_value_policy::copy,
+			"The group with the given name, or ``None`` if it was never recorded.");
+}
 
-	using coo_matrix = decltype(NodeBipartiteObs::edge_features);
-	ecole::python::auto_class<coo_matrix>(m, "coo_matrix", R"(
+/**
+ * Build a feature mask from the features given in Python, selecting all features if None.
+ */
+template <typename Mask>
+auto make_feature_mask(std::optional<std::vector<typename Mask::feature_type>> const& features) -> Mask {
+	if (!features.has_value()) {
+		return Mask::all();
+	}
+	auto mask = Mask::none();
+	for (auto const feature : features.value()) {
+		mask.select(feature);
+	}
+	return mask;
+}
+
+/**
+ * Bind a batch matrix of a given type, wrapping memory of Numpy arrays.
+ */
+template <typename T> void bind_batch_matrix(py::module_ const& m, char const* name) {
+	using Array = py::array_t<T, py::array::c_style>;
+	using Offsets = py::array_t<std::size_t, py::array::c_style>;
+	py::class_<BatchMatrix<T>>(m, name, R"(
+		A row major matrix in which observations are written one after the other.
+
+		The matrix does not own its memory, it writes in Numpy arrays preallocated by the user, which can be reused
+		for every batch.
+		Observation ``i`` is written in rows ``data[offsets[i]:offsets[i+1]]``, and rows after the last observation
+		are padding.
+	)")
+		.def(
+			py::init([](py::array const& data, py::array const& offsets) {
+				// Numpy arrays of other types would be silently converted to a temporary copy
+				if (!py::isinstance<Array>(data) || !py::isinstance<Offsets>(offsets)) {
+					throw std::invalid_argument{"Arrays must be C contiguous and of the batch matrix type."};
+				}
+				auto data_arr = data.cast<Array>();
+				auto offsets_arr = offsets.cast<Offsets>();
+				if (data_arr.ndim() > 2) {
+					throw std::invalid_argument{"Data must be a matrix or a vector."};
+				}
+				auto const n_cols = data_arr.ndim() == 2 ? static_cast<std::size_t>(data_arr.shape(1)) : std::size_t{1};
+				return BatchMatrix<T>{
+					{data_arr.mutable_data(), static_cast<std::size_t>(data_arr.size())},
+					n_cols,
+					{offsets_arr.mutable_data(), static_cast<std::size_t>(offsets_arr.size())},
+				};
+			}),
+			py::arg("data"),
+			py::arg("offsets"),
+			py::keep_alive<1, 2>(),
+			py::keep_alive<1, 3>(),
+			R"(
+			Wrap preallocated arrays.
+
+			Parameters
+			----------
+			data:
+				A C contiguous matrix with one column per feature, or a vector for a single feature.
+			offsets:
+				A vector of unsigned integers with room for one more offset than the maximum number of observations.
+		)")
+		.def_property_readonly("n_observations", &BatchMatrix<T>::n_observations)
+		.def_property_readonly("n_rows", &BatchMatrix<T>::n_rows)
+		.def_property_readonly("n_cols", &BatchMatrix<T>::n_cols)
+		.def_property_readonly("capacity", &BatchMatrix<T>::capacity)
+		.def("pad", &BatchMatrix<T>::pad, py::arg("value"), "Fill the rows after the last observation.")
+		.def("clear", &BatchMatrix<T>::clear, "Forget about all observations.");
+}
+
+/**
+ * Bind the sparse matrices holding values of a given type.
+ */
+template <typename T> void bind_sparse_matrices(py::module_ const& m, std::string const& suffix) {
+	using coo_matrix = utility::coo_matrix<T>;
+	ecole::python::auto_class<coo_matrix>(m, ("coo_matrix" + suffix).c_str(), R"(
 		Sparse matrix in the coordinate format.
 
 		Similar to Scipy's ``scipy.sparse.coo_matrix`` or PyTorch ``torch.sparse``.
@@ -77,9 +246,46 @@ void bind_submodule(py::module_ const& m) {
 		.def_readwrite("shape", &coo_matrix::shape, "The dimension of the sparse matrix, as if it was dense.")
 		.def_property_readonly("nnz", &coo_matrix::nnz);
 
-	// Node bipartite observation
+	using csr_matrix = utility::csr_matrix<T>;
+	using index_array = typename csr_matrix::index_array;
+	ecole::python::auto_class<csr_matrix>(m, ("csr_matrix" + suffix).c_str(), R"(
+		Sparse matrix in the compressed sparse row format.
+
+		Similar to Scipy's ``scipy.sparse.csr_matrix``.
+		Index arrays are shared between matrices with the same sparsity pattern.
+	)")
+		.def_auto_copy()
+		.def_auto_pickle("values", "row_ptrs", "col_indices", "shape")
+		.def_readwrite_xtensor("values", &csr_matrix::values, "A vector of non zero values in the matrix, row by row.")
+		.def_property(
+			"row_ptrs",
+			[](csr_matrix const& self) { return shared_array_view(self.row_ptrs); },
+			[](csr_matrix& self, index_array ptrs) {
+				self.row_ptrs = std::make_shared<index_array const>(std::move(ptrs));
+			},
+			"The non zero values of row ``i`` are in ``values[row_ptrs[i]:row_ptrs[i+1]]``.")
+		.def_property(
+			"col_indices",
+			[](csr_matrix const& self) { return shared_array_view(self.col_indices); },
+			[](csr_matrix& self, index_array indices) {
+				self.col_indices = std::make_shared<index_array const>(std::move(indices));
+			},
+			"The column of every non zero value.")
+		.def_readwrite("shape", &csr_matrix::shape, "The dimension of the sparse matrix, as if it was dense.")
+		.def_property_readonly("nnz", &csr_matrix::nnz)
+		.def("to_coo", &csr_matrix::to_coo, "Convert to the coordinate format.");
+}
+
+/**
+ * Bind NodeBipartite and its observation for a given value type, returning the observation class.
+ */
+template <typename T> auto bind_node_bipartite(py::module_ const& m, std::string const& suffix) {
+	using Obs = BasicNodeBipartiteObs<T>;
+	using Func = BasicNodeBipartite<T>;
+	auto const obs_ref = ":py:class:`NodeBipartiteObs" + suffix + '`';
+
 	auto node_bipartite_obs =
-		ecole::python::auto_class<NodeBipartiteObs>(m, "NodeBipartiteObs", R"(
+		ecole::python::auto_class<Obs>(m, ("NodeBipartiteObs" + suffix).c_str(), R"(
 		Bipartite graph observation for branch-and-bound nodes.
 
 		The optimization problem is represented as an heterogenous bipartite graph.
@@ -92,8 +298,8 @@ void bind_submodule(py::module_ const& m) {
 		Each edge is associated with the coefficient of the variable in the constraint.
 	)")
 			.def_auto_copy()
-			.def_auto_pickle("variable_features", "row_features", "edge_features")
-			.def_readwrite_xtensor("variable_features", &NodeBipartiteObs::variable_features, R"rst(
+			.def_auto_pickle("variable_features", "row_features", "edge_features", "edge_features_csr")
+			.def_readwrite_xtensor("variable_features", &Obs::variable_features, R"rst(
 					A matrix where each row represents a variable, and each column a feature of the variable.
 
 					Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
@@ -101,48 +307,45 @@ void bind_submodule(py::module_ const& m) {
 				)rst")
 			.def_readwrite_xtensor(
 				"row_features",
-				&NodeBipartiteObs::row_features,
+				&Obs::row_features,
 				"A matrix where each row is represents a constraint, and each column a feature of the constraints.")
 			.def_readwrite(
 				"edge_features",
-				&NodeBipartiteObs::edge_features,
+				&Obs::edge_features,
 				"The constraint matrix of the optimization problem, with rows for contraints and "
-				"columns for variables.");
-
-	py::enum_<NodeBipartiteObs::VariableFeatures>(node_bipartite_obs, "VariableFeatures")
-		.value("objective", NodeBipartiteObs::VariableFeatures::objective)
-		.value("is_type_binary", NodeBipartiteObs::VariableFeatures::is_type_binary)
-		.value("is_type_integer", NodeBipartiteObs::VariableFeatures::is_type_integer)
-		.value("is_type_implicit_integer", NodeBipartiteObs::VariableFeatures::is_type_implicit_integer)
-		.value("is_type_continuous", NodeBipartiteObs::VariableFeatures::is_type_continuous)
-		.value("has_lower_bound", NodeBipartiteObs::VariableFeatures::has_lower_bound)
-		.value("has_upper_bound", NodeBipartiteObs::VariableFeatures::has_upper_bound)
-		.value("normed_reduced_cost", NodeBipartiteObs::VariableFeatures::normed_reduced_cost)
-		.value("solution_value", NodeBipartiteObs::VariableFeatures::solution_value)
-		.value("solution_frac", NodeBipartiteObs::VariableFeatures::solution_frac)
-		.value("is_solution_at_lower_bound", NodeBipartiteObs::VariableFeatures::is_solution_at_lower_bound)
-		.value("is_solution_at_upper_bound", NodeBipartiteObs::VariableFeatures::is_solution_at_upper_bound)
-		.value("scaled_age", NodeBipartiteObs::VariableFeatures::scaled_age)
-		.value("incumbent_value", NodeBipartiteObs::VariableFeatures::incumbent_value)
-		.value("average_incumbent_value", NodeBipartiteObs::VariableFeatures::average_incumbent_value)
-		.value("is_basis_lower", NodeBipartiteObs::VariableFeatures::is_basis_lower)
-		.value("is_basis_basic", NodeBipartiteObs::VariableFeatures::is_basis_basic)
-		.value("is_basis_upper", NodeBipartiteObs::VariableFeatures::is_basis_upper)
-		.value("is_basis_zero", NodeBipartiteObs::VariableFeatures ::is_basis_zero);
-
-	py::enum_<NodeBipartiteObs::RowFeatures>(node_bipartite_obs, "RowFeatures")
-		.value("bias", NodeBipartiteObs::RowFeatures::bias)
-		.value("objective_cosine_similarity", NodeBipartiteObs::RowFeatures::objective_cosine_similarity)
-		.value("is_tight", NodeBipartiteObs::RowFeatures::is_tight)
-		.value("dual_solution_value", NodeBipartiteObs::RowFeatures::dual_solution_value)
-		.value("scaled_age", NodeBipartiteObs::RowFeatures::scaled_age);
+				"columns for variables.")
+			.def_readwrite(
+				"edge_features_csr",
+				&Obs::edge_features_csr,
+				"The constraint matrix in the compressed sparse row format, when requested instead of ``edge_features``.");
 
-	auto node_bipartite = py::class_<NodeBipartite>(m, "NodeBipartite", R"(
+	auto node_bipartite = py::class_<Func>(m, ("NodeBipartite" + suffix).c_str(), (R"(
 		Bipartite graph observation function on branch-and bound node.
 
-		This observation function extract structured :py:class:`NodeBipartiteObs`.
-	)");
-	node_bipartite.def(py::init<bool>(), py::arg("cache") = false, R"(
+		This observation function extract structured )" + obs_ref + R"(.
+	)").c_str());
+	using VariableFeatures = NodeBipartiteFeatures::VariableFeatures;
+	using RowFeatures = NodeBipartiteFeatures::RowFeatures;
+	node_bipartite.def(
+		py::init([](bool cache,
+		            bool incremental,
+		            bool csr_edges,
+		            std::optional<std::vector<VariableFeatures>> const& variable_features,
+		            std::optional<std::vector<RowFeatures>> const& row_features) {
+			return Func{
+				cache,
+				incremental,
+				csr_edges,
+				make_feature_mask<NodeBipartiteFeatures::VariableFeaturesMask>(variable_features),
+				make_feature_mask<NodeBipartiteFeatures::RowFeaturesMask>(row_features),
+			};
+		}),
+		py::arg("cache") = false,
+		py::arg("incremental") = false,
+		py::arg("csr_edges") = false,
+		py::arg("variable_features") = py::none(),
+		py::arg("row_features") = py::none(),
+		R"(
 		Constructor for NodeBipartite.
 
 		Parameters
@@ -150,13 +353,67 @@ void bind_submodule(py::module_ const& m) {
 		cache :
 			Whether or not to cache static features within an episode.
 			Currently, this is only safe if cutting planes are disabled.
+		incremental :
+			Whether or not to update the previous observation with the changes in the LP, tracked using SCIP events,
+			rather than recomputing all features.
+			Static features, bound and incumbent features, and the static features and edges of the rows that did not
+			change in the LP are reused.
+			Features depending on the LP solution, which are most dynamic features, are still recomputed for all
+			variables and rows after every LP solve, so the saving is mostly on the rows and edges.
+		csr_edges :
+			Whether or not to extract edges in :py:attr:`NodeBipartiteObs.edge_features_csr` rather than in
+			:py:attr:`NodeBipartiteObs.edge_features`.
+			Index arrays are shared between successive observations when the LP rows are unchanged.
+		variable_features :
+			The :py:class:`NodeBipartiteObs.VariableFeatures` to compute, or ``None`` for all of them.
+			Other features are not computed, and the columns of the observation are the selected features, in the order
+			of the enum.
+		row_features :
+			The :py:class:`NodeBipartiteObs.RowFeatures` to compute, or ``None`` for all of them.
 	)");
 	def_before_reset(node_bipartite, "Cache some feature not expected to change during an episode.");
-	def_extract(node_bipartite, "Extract a new :py:class:`NodeBipartiteObs`.");
+	def_extract(node_bipartite, ("Extract a new " + obs_ref + ".").c_str());
+	def_extract_into(node_bipartite, "Write a new observation in the next rows of a batch.");
+	def_profiler(node_bipartite);
+
+	using Batch = NodeBipartiteBatch<T>;
+	py::class_<Batch>(m, ("NodeBipartiteBatch" + suffix).c_str(), R"(
+		Bipartite graph observations of many nodes written in preallocated arrays.
+
+		The graphs are written as a single disconnected graph.
+		Edge indices have shape ``(nnz, 2)``, with the row index in the first column and the variable index in the
+		second, shifted by the number of rows and variables of the previous observations in the batch.
+	)")
+		.def(
+			py::init<BatchMatrix<T>, BatchMatrix<T>, BatchMatrix<T>, BatchMatrix<std::size_t>>(),
+			py::arg("variable_features"),
+			py::arg("row_features"),
+			py::arg("edge_values"),
+			py::arg("edge_indices"),
+			py::keep_alive<1, 2>(),
+			py::keep_alive<1, 3>(),
+			py::keep_alive<1, 4>(),
+			py::keep_alive<1, 5>())
+		.def_readonly("variable_features", &Batch::variable_features)
+		.def_readonly("row_features", &Batch::row_features)
+		.def_readonly("edge_values", &Batch::edge_values)
+		.def_readonly("edge_indices", &Batch::edge_indices)
+		.def("clear", &Batch::clear, "Forget about all observations.");
+	def_collate<Func, Batch>(m);
+
+	return node_bipartite_obs;
+}
+
+/**
+ * Bind MilpBipartite and its observation for a given value type, returning the observation class.
+ */
+template <typename T> auto bind_milp_bipartite(py::module_ const& m, std::string const& suffix) {
+	using Obs = BasicMilpBipartiteObs<T>;
+	using Func = BasicMilpBipartite<T>;
+	auto const obs_ref = ":py:class:`MilpBipartiteObs" + suffix + '`';
 
-	// MILP bipartite observation
 	auto milp_bipartite_obs =
-		ecole::python::auto_class<MilpBipartiteObs>(m, "MilpBipartiteObs", R"(
+		ecole::python::auto_class<Obs>(m, ("MilpBipartiteObs" + suffix).c_str(), R"(
 		Bipartite graph observation that represents the most recent MILP during presolving.
 
 		The optimization problem is represented as an heterogenous bipartite graph.
@@ -170,7 +427,7 @@ void bind_submodule(py::module_ const& m) {
 	)")
 			.def_auto_copy()
 			.def_auto_pickle("variable_features", "constraint_features", "edge_features")
-			.def_readwrite_xtensor("variable_features", &MilpBipartiteObs::variable_features, R"rst(
+			.def_readwrite_xtensor("variable_features", &Obs::variable_features, R"rst(
 					A matrix where each row represents a variable, and each column a feature of the variable.
 
 					Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
@@ -178,13 +435,273 @@ void bind_submodule(py::module_ const& m) {
 				)rst")
 			.def_readwrite_xtensor(
 				"constraint_features",
-				&MilpBipartiteObs::constraint_features,
+				&Obs::constraint_features,
 				"A matrix where each row is represents a constraint, and each column a feature of the constraints.")
 			.def_readwrite(
 				"edge_features",
-				&MilpBipartiteObs::edge_features,
+				&Obs::edge_features,
 				"The constraint matrix of the optimization problem, with rows for contraints and columns for variables.");
 
+	auto milp_bipartite = py::class_<Func>(m, ("MilpBipartite" + suffix).c_str(), (R"(
+		Bipartite graph observation function for the sub-MILP at the latest branch-and-bound node.
+
+		This observation function extract structured )" + obs_ref + R"(.
+	)").c_str());
+	using VariableFeatures = MilpBipartiteFeatures::VariableFeatures;
+	milp_bipartite.def(
+		py::init([](bool normalize,
+		            std::size_t n_threads,
+		            std::optional<std::vector<VariableFeatures>> const& variable_features,
+		            std::optional<std::filesystem::path> const& cache_directory) {
+			return Func{
+				normalize,
+				n_threads,
+				make_feature_mask<MilpBipartiteFeatures::VariableFeaturesMask>(variable_features),
+				cache_directory.value_or(std::filesystem::path{})};
+		}),
+		py::arg("normalize") = false,
+		py::arg("n_threads") = 0,
+		py::arg("variable_features") = py::none(),
+		py::arg("cache_directory") = py::none(),
+		R"(
+		Constructor for MilpBipartite.
+
+		Parameters
+		----------
+		normalize :
+			Should the features be normalized?
+			This is recommended for some application such as deep learning models.
+		n_threads :
+			The number of threads used to extract the constraint matrix, 0 to extract it in the calling thread.
+			Threads are only used before the problem is transformed, and do not change the observation.
+		variable_features :
+			The :py:class:`MilpBipartiteObs.VariableFeatures` to compute, or ``None`` for all of them.
+			Other features are not computed, and the columns of the observation are the selected features, in the order
+			of the enum.
+		cache_directory :
+			A directory in which to cache the observations, shared between episodes and processes, or ``None`` to
+			always compute them.
+			Entries are keyed by :py:meth:`ecole.scip.Model.fingerprint`.
+	)");
+	def_before_reset(milp_bipartite, R"(Do nothing.)");
+	def_extract(milp_bipartite, ("Extract a new " + obs_ref + ".").c_str());
+	def_profiler(milp_bipartite);
+
+	return milp_bipartite_obs;
+}
+
+/**
+ * Bind Khalil2016 and its observation for a given value type, returning the observation class.
+ */
+template <typename T> auto bind_khalil2016(py::module_ const& m, std::string const& suffix) {
+	using Obs = BasicKhalil2016Obs<T>;
+	using Func = BasicKhalil2016<T>;
+	auto const obs_ref = ":py:class:`Khalil2016Obs" + suffix + '`';
+
+	auto khalil2016_obs = ecole::python::auto_class<Obs>(m, ("Khalil2016Obs" + suffix).c_str(), R"(
+		Branching candidates features from Khalil et al. (2016).
+
+		The observation is a matrix where rows represent all variables and columns represent features related
+		to these variables.
+		See [Khalil2016]_ for a complete reference on this observation function.
+
+		.. [Khalil2016]
+			Khalil, Elias Boutros, Pierre Le Bodic, Le Song, George Nemhauser, and Bistra Dilkina.
+			"`Learning to branch in mixed integer programming.
+			<https://dl.acm.org/doi/10.5555/3015812.3015920>`_"
+			*Thirtieth AAAI Conference on Artificial Intelligence*. 2016.
+	)");
+	khalil2016_obs.def_auto_copy()
+		.def_auto_pickle("features")
+		.def_readwrite_xtensor("features", &Obs::features, R"rst(
+			A matrix where each row represents a variable, and each column a feature of the variable.
+
+			Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
+			hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
+			Variables for which the features are not applicable are filled with ``NaN``.
+
+			The first :py:attr:`Khalil2016Obs.n_static_features` features columns are static (they do not
+			change through the solving process), and the remaining :py:attr:`Khalil2016Obs.n_dynamic_features`
+			are dynamic.
+		)rst")
+		.def_readonly_static("n_static_features", &Obs::n_static_features)
+		.def_readonly_static("n_dynamic_features", &Obs::n_dynamic_features);
+
+	auto khalil2016 = py::class_<Func>(m, ("Khalil2016" + suffix).c_str(), (R"(
+		Branching candidates features from Khalil et al. (2016).
+
+		This observation function extract structured )" + obs_ref + R"(.
+	)").c_str());
+	using Features = Khalil2016Features::Features;
+	khalil2016.def(
+		py::init([](bool pseudo_candidates,
+		            std::size_t n_threads,
+		            std::optional<std::vector<Features>> const& features,
+		            std::optional<std::filesystem::path> const& cache_directory) {
+			return Func{
+				pseudo_candidates,
+				n_threads,
+				make_feature_mask<Khalil2016Features::FeaturesMask>(features),
+				cache_directory.value_or(std::filesystem::path{})};
+		}),
+		py::arg("pseudo_candidates") = false,
+		py::arg("n_threads") = 0,
+		py::arg("features") = py::none(),
+		py::arg("cache_directory") = py::none(),
+		R"(
+		Create new observation.
+
+		Parameters
+		----------
+		pseudo_candidates:
+				Whether the pseudo branching variable candidates (``SCIPgetPseudoBranchCands``)
+				or LP branching variable candidates (``SCIPgetPseudoBranchCands``) are observed.
+		n_threads:
+				Number of threads used to compute the static features at the root node, or zero to compute them in
+				the calling thread.
+				The features do not depend on the number of threads.
+		features:
+				The :py:class:`Khalil2016Obs.Features` to compute, or ``None`` for all of them.
+				Other features are not computed, and the columns of the observation are the selected features, in the
+				order of the enum.
+		cache_directory:
+				A directory in which to cache the static features at the root node, shared between episodes and
+				processes, or ``None`` to always compute them.
+				Entries are keyed by :py:meth:`ecole.scip.Model.fingerprint`, which includes the LP at the root node.
+	)");
+	def_before_reset(khalil2016, R"(Reset static features cache.)");
+	def_extract(khalil2016, "Extract the observation matrix.");
+	def_extract_into(khalil2016, "Write the observation matrix in the next rows of a batch.");
+	def_profiler(khalil2016);
+	def_collate<Func, BatchMatrix<T>>(m);
+
+	return khalil2016_obs;
+}
+
+/**
+ * Bind Hutter2011 and its observation for a given value type, returning the observation class.
+ */
+template <typename T> auto bind_hutter2011(py::module_ const& m, std::string const& suffix) {
+	using Obs = BasicHutter2011Obs<T>;
+	using Func = BasicHutter2011<T>;
+	auto const obs_ref = ":py:class:`Hutter2011Obs" + suffix + '`';
+
+	auto hutter_obs = ecole::python::auto_class<Obs>(m, ("Hutter2011Obs" + suffix).c_str(), R"(
+		Instance features from Hutter et al. (2011).
+
+		The observation is a vector of features that globally characterize the instance.
+		See [Hutter2011]_ for a complete reference on this observation function.
+
+		.. [Hutter2011]
+			Hutter, Frank, Hoos, Holger H., and Leyton-Brown, Kevin.
+			"`Sequential model-based optimization for general algorithm configuration.
+			<https://doi.org/10.1007/978-3-642-25566-3_40>`_"
+			*International Conference on Learning and Intelligent Optimization*. 2011.
+	)");
+	hutter_obs.def_auto_copy()
+		.def_auto_pickle("features")
+		.def_readwrite_xtensor("features", &Obs::features, "A vector of instance features.");
+
+	auto hutter = py::class_<Func>(m, ("Hutter2011" + suffix).c_str(), (R"(
+		Instance features from Hutter et al. (2011).
+
+		This observation function extracts a structured )" + obs_ref + R"(.
+	)").c_str());
+	hutter.def(
+		py::init([](bool copy_model,
+		            std::size_t n_threads,
+		            std::size_t max_var_graph_edges,
+		            std::optional<std::filesystem::path> const& cache_directory) {
+			return Func{copy_model, n_threads, max_var_graph_edges, cache_directory.value_or(std::filesystem::path{})};
+		}),
+		py::arg("copy_model") = false,
+		py::arg("n_threads") = 0,
+		py::arg("max_var_graph_edges") = Func::default_max_var_graph_edges,
+		py::arg("cache_directory") = py::none(),
+		R"(
+		Create new observation.
+
+		Parameters
+		----------
+		copy_model:
+				Whether to solve the LP relaxation with SCIP on a copy of the model with all variables made continuous,
+				rather than directly in an LP interface loaded with the constraint matrix.
+				Both solve the same LP, but copying and solving the model is much slower.
+		n_threads:
+				Number of threads used to build the variable graph, or zero to build it in the calling thread.
+		max_var_graph_edges:
+				Maximum number of edges in the variable graph.
+				Variable graph features are NaN for larger graphs.
+		cache_directory:
+				A directory in which to cache the features, shared between episodes and processes, or ``None`` to
+				always compute them.
+				Entries are keyed by :py:meth:`ecole.scip.Model.fingerprint`.
+	)");
+	def_before_reset(hutter, R"(Do nothing.)");
+	def_extract(hutter, "Extract the observation matrix.");
+	def_profiler(hutter);
+
+	return hutter_obs;
+}
+
+/**
+ * Observation module bindings definitions.
+ */
+void bind_submodule(py::module_ const& m) {
+	m.doc() = "Observation classes for Ecole.";
+
+	xt::import_numpy();
+
+	m.attr("Nothing") = py::type::of<Nothing>();
+
+	bind_sparse_matrices<double>(m, "");
+	bind_sparse_matrices<float>(m, "_f32");
+
+	bind_batch_matrix<double>(m, "BatchMatrix");
+	bind_batch_matrix<float>(m, "BatchMatrixF32");
+	bind_batch_matrix<std::size_t>(m, "BatchIndexMatrix");
+
+	bind_feature_profiler(m);
+
+	// Node bipartite observation
+	auto node_bipartite_obs = bind_node_bipartite<double>(m, "");
+	auto node_bipartite_obs_f32 = bind_node_bipartite<float>(m, "F32");
+
+	py::enum_<NodeBipartiteObs::VariableFeatures>(node_bipartite_obs, "VariableFeatures")
+		.value("objective", NodeBipartiteObs::VariableFeatures::objective)
+		.value("is_type_binary", NodeBipartiteObs::VariableFeatures::is_type_binary)
+		.value("is_type_integer", NodeBipartiteObs::VariableFeatures::is_type_integer)
+		.value("is_type_implicit_integer", NodeBipartiteObs::VariableFeatures::is_type_implicit_integer)
+		.value("is_type_continuous", NodeBipartiteObs::VariableFeatures::is_type_continuous)
+		.value("has_lower_bound", NodeBipartiteObs::VariableFeatures::has_lower_bound)
+		.value("has_upper_bound", NodeBipartiteObs::VariableFeatures::has_upper_bound)
+		.value("normed_reduced_cost", NodeBipartiteObs::VariableFeatures::normed_reduced_cost)
+		.value("solution_value", NodeBipartiteObs::VariableFeatures::solution_value)
+		.value("solution_frac", NodeBipartiteObs::VariableFeatures::solution_frac)
+		.value("is_solution_at_lower_bound", NodeBipartiteObs::VariableFeatures::is_solution_at_lower_bound)
+		.value("is_solution_at_upper_bound", NodeBipartiteObs::VariableFeatures::is_solution_at_upper_bound)
+		.value("scaled_age", NodeBipartiteObs::VariableFeatures::scaled_age)
+		.value("incumbent_value", NodeBipartiteObs::VariableFeatures::incumbent_value)
+		.value("average_incumbent_value", NodeBipartiteObs::VariableFeatures::average_incumbent_value)
+		.value("is_basis_lower", NodeBipartiteObs::VariableFeatures::is_basis_lower)
+		.value("is_basis_basic", NodeBipartiteObs::VariableFeatures::is_basis_basic)
+		.value("is_basis_upper", NodeBipartiteObs::VariableFeatures::is_basis_upper)
+		.value("is_basis_zero", NodeBipartiteObs::VariableFeatures ::is_basis_zero);
+
+	py::enum_<NodeBipartiteObs::RowFeatures>(node_bipartite_obs, "RowFeatures")
+		.value("bias", NodeBipartiteObs::RowFeatures::bias)
+		.value("objective_cosine_similarity", NodeBipartiteObs::RowFeatures::objective_cosine_similarity)
+		.value("is_tight", NodeBipartiteObs::RowFeatures::is_tight)
+		.value("dual_solution_value", NodeBipartiteObs::RowFeatures::dual_solution_value)
+		.value("scaled_age", NodeBipartiteObs::RowFeatures::scaled_age);
+
+	node_bipartite_obs_f32.attr("VariableFeatures") = node_bipartite_obs.attr("VariableFeatures");
+	node_bipartite_obs_f32.attr("RowFeatures") = node_bipartite_obs.attr("RowFeatures");
+
+	// MILP bipartite observation
+	auto milp_bipartite_obs = bind_milp_bipartite<double>(m, "");
+	auto milp_bipartite_obs_f32 = bind_milp_bipartite<float>(m, "F32");
+
 	py::enum_<MilpBipartiteObs::VariableFeatures>(milp_bipartite_obs, "VariableFeatures")
 		.value("objective", MilpBipartiteObs::VariableFeatures::objective)
 		.value("is_type_binary", MilpBipartiteObs::VariableFeatures::is_type_binary)
@@ -199,22 +716,8 @@ void bind_submodule(py::module_ const& m) {
 	py::enum_<MilpBipartiteObs::ConstraintFeatures>(milp_bipartite_obs, "ConstraintFeatures")
 		.value("bias", MilpBipartiteObs::ConstraintFeatures::bias);
 
-	auto milp_bipartite = py::class_<MilpBipartite>(m, "MilpBipartite", R"(
-		Bipartite graph observation function for the sub-MILP at the latest branch-and-bound node.
-
-		This observation function extract structured :py:class:`MilpBipartiteObs`.
-	)");
-	milp_bipartite.def(py::init<bool>(), py::arg("normalize") = false, R"(
-		Constructor for MilpBipartite.
-
-		Parameters
-		----------
-		normalize :
-			Should the features be normalized?
-			This is recommended for some application such as deep learning models.
-	)");
-	def_before_reset(milp_bipartite, R"(Do nothing.)");
-	def_extract(milp_bipartite, "Extract a new :py:class:`MilpBipartiteObs`.");
+	milp_bipartite_obs_f32.attr("VariableFeatures") = milp_bipartite_obs.attr("VariableFeatures");
+	milp_bipartite_obs_f32.attr("ConstraintFeatures") = milp_bipartite_obs.attr("ConstraintFeatures");
 
 	// Strong branching observation
 	auto strong_branching_scores = py::class_<StrongBranchingScores>(m, "StrongBranchingScores", R"(
@@ -231,7 +734,8 @@ void bind_submodule(py::module_ const& m) {
 		hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
 		Variables for which a strong branching score is not applicable are filled with ``NaN``.
 	)");
-	strong_branching_scores.def(py::init<bool>(), py::arg("pseudo_candidates") = false, R"(
+	strong_branching_scores.def(
+		py::init<bool, std::size_t>(), py::arg("pseudo_candidates") = false, py::arg("n_threads") = 0, R"(
 		Constructor for StrongBranchingScores.
 
 		Parameters
@@ -239,10 +743,67 @@ void bind_submodule(py::module_ const& m) {
 		pseudo_candidates :
 			The parameter determines if strong branching scores are computed for
 			pseudo candidate variables (when true) or LP candidate variables (when false).
+		n_threads :
+			The number of threads used to evaluate the candidates, 0 to run SCIP ``vanillafullstrong`` branching
+			rule in the calling thread.
+			With threads, every thread solves the children of the candidates on its own copy of the node LP.
+			Scores are the same up to the tolerances of the LP solver.
 	)");
-	def_before_reset(strong_branching_scores, R"(Do nothing.)");
+	def_before_reset(strong_branching_scores, R"(Look up the parameters of the branching rule for the episode.)");
 	def_extract(strong_branching_scores, "Extract an array containing strong branching scores.");
 
+	// Partial strong branching observation
+	using PartialObs = PartialStrongBranchingScoresObs;
+	auto partial_strong_branching_scores_obs = ecole::python::auto_class<PartialObs>(
+		m, "PartialStrongBranchingScoresObs", R"(
+		Strong branching scores of the most promising candidates, and pseudocost scores of the others.
+
+		Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
+		hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
+	)");
+	partial_strong_branching_scores_obs.def_auto_copy()
+		.def_auto_pickle("scores", "is_exact")
+		.def_readwrite_xtensor(
+			"scores", &PartialObs::scores, "The score of every candidate, ``NaN`` for other variables.")
+		.def_readwrite_xtensor(
+			"is_exact",
+			&PartialObs::is_exact,
+			"Whether the score of a variable was computed with strong branching, rather than with its pseudocosts.");
+
+	auto partial_strong_branching_scores =
+		py::class_<PartialStrongBranchingScores>(m, "PartialStrongBranchingScores", R"(
+		Strong branching scores of the most promising candidates, within a budget.
+
+		Candidates are sorted by decreasing pseudocost score, and strong branching is run on them in that order
+		until one of the limits is reached.
+		The budgets are checked before every candidate, so the last one evaluated can exceed them.
+		Other candidates keep their pseudocost score, which uses the same score function as strong branching
+		but is only an estimate of it.
+		This observation can be used as a cheaper expert for imitation learning algorithms.
+	)");
+	partial_strong_branching_scores.def(
+		py::init<bool, std::optional<std::size_t>, std::optional<SCIP_Longint>, std::optional<double>>(),
+		py::arg("pseudo_candidates") = false,
+		py::arg("max_candidates") = py::none(),
+		py::arg("max_lp_iterations") = py::none(),
+		py::arg("time_limit") = py::none(),
+		R"(
+		Constructor for PartialStrongBranchingScores.
+
+		Parameters
+		----------
+		pseudo_candidates :
+			Whether to score the pseudo candidates rather than the LP candidates.
+		max_candidates :
+			The maximum number of candidates evaluated with strong branching, or ``None`` for no limit.
+		max_lp_iterations :
+			The maximum number of LP iterations of strong branching, or ``None`` for no limit.
+		time_limit :
+			The maximum time spent in strong branching, in seconds, or ``None`` for no limit.
+	)");
+	def_before_reset(partial_strong_branching_scores, R"(Do nothing.)");
+	def_extract(partial_strong_branching_scores, "Extract a new :py:class:`PartialStrongBranchingScoresObs`.");
+
 	// Pseudocosts observation
 	auto pseudocosts = py::class_<Pseudocosts>(m, "Pseudocosts", R"(
 		Pseudocosts observation function on branch-and-bound nodes.
@@ -263,36 +824,12 @@ void bind_submodule(py::module_ const& m) {
 	pseudocosts.def(py::init<>());
 	def_before_reset(pseudocosts, R"(Do nothing.)");
 	def_extract(pseudocosts, "Extract an array containing pseudocosts.");
+	def_extract_into(pseudocosts, "Write the pseudocosts in the next rows of a single column batch.");
+	def_collate<Pseudocosts, BatchMatrix<double>>(m);
 
 	// Khalil observation
-	auto khalil2016_obs = ecole::python::auto_class<Khalil2016Obs>(m, "Khalil2016Obs", R"(
-		Branching candidates features from Khalil et al. (2016).
-
-		The observation is a matrix where rows represent all variables and columns represent features related
-		to these variables.
-		See [Khalil2016]_ for a complete reference on this observation function.
-
-		.. [Khalil2016]
-			Khalil, Elias Boutros, Pierre Le Bodic, Le Song, George Nemhauser, and Bistra Dilkina.
-			"`Learning to branch in mixed integer programming.
-			<https://dl.acm.org/doi/10.5555/3015812.3015920>`_"
-			*Thirtieth AAAI Conference on Artificial Intelligence*. 2016.
-	)");
-	khalil2016_obs.def_auto_copy()
-		.def_auto_pickle("features")
-		.def_readwrite_xtensor("features", &Khalil2016Obs::features, R"rst(
-			A matrix where each row represents a variable, and each column a feature of the variable.
-
-			Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
-			hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
-			Variables for which the features are not applicable are filled with ``NaN``.
-
-			The first :py:attr:`Khalil2016Obs.n_static_features` features columns are static (they do not
-			change through the solving process), and the remaining :py:attr:`Khalil2016Obs.n_dynamic_features`
-			are dynamic.
-		)rst")
-		.def_readonly_static("n_static_features", &Khalil2016Obs::n_static_features)
-		.def_readonly_static("n_dynamic_features", &Khalil2016Obs::n_dynamic_features);
+	auto khalil2016_obs = bind_khalil2016<double>(m, "");
+	auto khalil2016_obs_f32 = bind_khalil2016<float>(m, "F32");
 
 	py::enum_<Khalil2016Obs::Features>(khalil2016_obs, "Features")
 		.value("obj_coef", Khalil2016Obs::Features::obj_coef)
@@ -368,39 +905,11 @@ void bind_submodule(py::module_ const& m) {
 		.value("active_coef_weight4_min", Khalil2016Obs::Features::active_coef_weight4_min)
 		.value("active_coef_weight4_max", Khalil2016Obs::Features::active_coef_weight4_max);
 
-	auto khalil2016 = py::class_<Khalil2016>(m, "Khalil2016", R"(
-		Branching candidates features from Khalil et al. (2016).
-
-		This observation function extract structured :py:class:`Khalil2016Obs`.
-	)");
-	khalil2016.def(py::init<bool>(), py::arg("pseudo_candidates") = false, R"(
-		Create new observation.
-
-		Parameters
-		----------
-		pseudo_candidates:
-				Whether the pseudo branching variable candidates (``SCIPgetPseudoBranchCands``)
-				or LP branching variable candidates (``SCIPgetPseudoBranchCands``) are observed.
-	)");
-	def_before_reset(khalil2016, R"(Reset static features cache.)");
-	def_extract(khalil2016, "Extract the observation matrix.");
+	khalil2016_obs_f32.attr("Features") = khalil2016_obs.attr("Features");
 
 	// Hutter2011 observation
-	auto hutter_obs = ecole::python::auto_class<Hutter2011Obs>(m, "Hutter2011Obs", R"(
-		Instance features from Hutter et al. (2011).
-
-		The observation is a vector of features that globally characterize the instance.
-		See [Hutter2011]_ for a complete reference on this observation function.
-
-		.. [Hutter2011]
-			Hutter, Frank, Hoos, Holger H., and Leyton-Brown, Kevin.
-			"`Sequential model-based optimization for general algorithm configuration.
-			<https://doi.org/10.1007/978-3-642-25566-3_40>`_"
-			*International Conference on Learning and Intelligent Optimization*. 2011.
-	)");
-	hutter_obs.def_auto_copy()
-		.def_auto_pickle("features")
-		.def_readwrite_xtensor("features", &Hutter2011Obs::features, "A vector of instance features.");
+	auto hutter_obs = bind_hutter2011<double>(m, "");
+	auto hutter_obs_f32 = bind_hutter2011<float>(m, "F32");
 
 	py::enum_<Hutter2011Obs::Features>(hutter_obs, "Features")
 		.value("nb_variables", Hutter2011Obs::Features::nb_variables)
@@ -420,6 +929,8 @@ void bind_submodule(py::module_ const& m) {
 		.value("node_degree_std", Hutter2011Obs::Features::node_degree_std)
 		.value("node_degree_25q", Hutter2011Obs::Features::node_degree_25q)
 		.value("node_degree_75q", Hutter2011Obs::Features::node_degree_75q)
+		.value("clustering_coef_mean", Hutter2011Obs::Features::clustering_coef_mean)
+		.value("clustering_coef_std", Hutter2011Obs::Features::clustering_coef_std)
 		.value("edge_density", Hutter2011Obs::Features::edge_density)
 		.value("lp_slack_mean", Hutter2011Obs::Features::lp_slack_mean)
 		.value("lp_slack_max", Hutter2011Obs::Features::lp_slack_max)
@@ -437,14 +948,7 @@ void bind_submodule(py::module_ const& m) {
 		.value("ratio_unbounded_discrete_vars", Hutter2011Obs::Features::ratio_unbounded_discrete_vars)
 		.value("ratio_continuous_vars", Hutter2011Obs::Features::ratio_continuous_vars);
 
-	auto hutter = py::class_<Hutter2011>(m, "Hutter2011", R"(
-		Instance features from Hutter et al. (2011).
-
-		This observation function extracts a structured :py:class:`Hutter2011Obs`.
-	)");
-	hutter.def(py::init<>());
-	def_before_reset(hutter, R"(Do nothing.)");
-	def_extract(hutter, "Extract the observation matrix.");
+	hutter_obs_f32.attr("Features") = hutter_obs.attr("Features");
 }
 
 }  // namespace ecole::observation
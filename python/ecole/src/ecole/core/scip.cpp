@@ -1,5 +1,8 @@
 #include <algorithm>
+#include <cstddef>
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <pybind11/operators.h>
@@ -8,7 +11,9 @@
 
 #include "ecole/python/auto-class.hpp"
 #include "ecole/scip/callback.hpp"
+#include "ecole/scip/compiled-params.hpp"
 #include "ecole/scip/model.hpp"
+#include "ecole/scip/param-snapshot.hpp"
 #include "ecole/scip/scimpl.hpp"
 
 #include "core.hpp"
@@ -150,6 +155,7 @@ void bind_submodule(py::module_ m) {
 		.def(py::self != py::self)  // NOLINT(misc-redundant-expression)  pybind specific syntax
 
 		.def("copy_orig", &Model::copy_orig, py::call_guard<py::gil_scoped_release>())
+		.def("fork", &Model::fork, py::call_guard<py::gil_scoped_release>())
 		.def(
 			"as_pyscipopt",
 			[](scip::Model& model) {
@@ -165,11 +171,27 @@ void bind_submodule(py::module_ m) {
 
 		.def_property("name", &Model::name, &Model::set_name)
 		.def_property_readonly("stage", &Model::stage)
+		.def("fingerprint", &Model::fingerprint, py::call_guard<py::gil_scoped_release>(), R"(
+			A hash of the content of the problem in its current state.
+
+			Models holding the same problem in the same state, for instance read from the same file, have the same
+			fingerprint, whatever their name.
+			The fingerprint covers the variables, the objective, and the linear data of the constraints, along with
+			the columns and rows of the LP while solving.
+		)")
 
 		.def("get_param", &Model::get_param<Param>, py::arg("name"))
 		.def("set_param", &Model::set_param<Param>, py::arg("name"), py::arg("value"))
 		.def("get_params", &Model::get_params)
-		.def("set_params", &Model::set_params, py::arg("name_values"))
+		.def(
+			"set_params",
+			py::overload_cast<std::map<std::string, Param>>(&Model::set_params),
+			py::arg("name_values"))
+		.def(
+			"set_params",
+			py::overload_cast<CompiledParams const&>(&Model::set_params),
+			py::arg("params"),
+			"Set parameters resolved in advance, which avoids looking them up by name.")
 		.def("disable_cuts", &Model::disable_cuts)
 		.def("disable_presolve", &Model::disable_presolve)
 		.def("write_problem", &Model::write_problem, py::arg("filepath"), py::call_guard<py::gil_scoped_release>())
@@ -196,6 +218,58 @@ void bind_submodule(py::module_ m) {
 				return self.solve_iter(args);
 			})
 		.def("solve_iter_continue", &Model::solve_iter_continue);
+
+	py::class_<CompiledParams>(m, "CompiledParams", R"(
+		A set of parameter values resolved and validated once, to be set repeatedly on models.
+
+		Parameters are resolved to their type and position in SCIP, and the values are converted to that type and
+		checked.
+		Models with the same plugins as the one used to compile, such as models created with the default plugins,
+		then have their parameters set directly through their handle, without looking them up by name.
+	)")
+		.def(
+			py::init<Model const&, std::map<std::string, Param> const&>(),
+			py::arg("model"),
+			py::arg("name_values"),
+			R"(
+				Resolve the parameters in the given model.
+
+				Raises a ScipError if a parameter does not exist, or if its value has an incompatible type or is not
+				valid.
+			)")
+		.def("apply", &CompiledParams::apply, py::arg("model"), "Set the parameters on a model.")
+		.def("__len__", &CompiledParams::size);
+
+	py::class_<ParamSnapshot>(m, "ParamSnapshot", R"(
+		The values of all the parameters of a model, in the order SCIP stores them.
+
+		Taking a snapshot reads the parameters through their handle and does not store their names, so it is cheap
+		enough to save and restore the solver configuration around a computation.
+		It can be applied or compared to models with the same parameters as the one it was taken from.
+	)")
+		.def(py::init<Model const&>(), py::arg("model"), "Read the current value of all the parameters of the model.")
+		.def(
+			"apply",
+			&ParamSnapshot::apply,
+			py::arg("model"),
+			R"(
+				Set the parameters of a model to the values of the snapshot.
+
+				Only the parameters whose current value differs are changed, and their number is returned.
+				Raises a ScipError if the model does not have the same parameters as the snapshot.
+			)")
+		.def(
+			"diff",
+			&ParamSnapshot::diff,
+			py::arg("other"),
+			"Positions of the parameters whose value differs between two snapshots.")
+		.def("__len__", &ParamSnapshot::size)
+		.def("__getitem__", [](ParamSnapshot const& self, std::size_t i) {
+			if (i >= self.size()) {
+				throw py::index_error{};
+			}
+			return self[i];
+		});
 }
 
 }  // namespace ecole::scip
@@ -1,6 +1,7 @@
 """Ecole collection of environments."""
 
 import ecole
+from ecole.core.environment import BranchingPool, ConfiguringPool, PrimalSearchPool
 
 
 class Environment:
@@ -51,6 +52,7 @@ class Environment:
             information_function, self.__DefaultInformationFunction__()
         )
         self.scip_params = scip_params if scip_params is not None else {}
+        self._compiled_scip_params = None
         self.model = None
         self.dynamics = self.__Dynamics__(**dynamics_kwargs)
         self.can_transition = False
@@ -105,7 +107,7 @@ class Environment:
                 self.model = instance.copy_orig()
             else:
                 self.model = ecole.core.scip.Model.from_file(instance)
-            self.model.set_params(self.scip_params)
+            self.model.set_params(self._get_compiled_scip_params())
 
             self.dynamics.set_dynamics_random_state(self.model, self.rng)
 
@@ -133,6 +135,14 @@ class Environment:
             self.can_transition = False
             raise e
 
+    def _get_compiled_scip_params(self):
+        """Compile the SCIP parameters on the current model, unless unchanged since last compiled."""
+        cache = self._compiled_scip_params
+        if cache is None or cache[0] != self.scip_params:
+            compiled = ecole.core.scip.CompiledParams(self.model, self.scip_params)
+            self._compiled_scip_params = (dict(self.scip_params), compiled)
+        return self._compiled_scip_params[1]
+
     def step(self, action, *dynamics_args, **dynamics_kwargs):
         """Transition from one state to another.
 
@@ -55,3 +55,35 @@ def test_scip_params(model):
     env = MockEnvironment(scip_params={"concurrent/paramsetprefix": "testname"})
     env.reset(model)
     assert env.model.get_param("concurrent/paramsetprefix") == "testname"
+
+    # Modified parameters are used on the next reset
+    env.scip_params["concurrent/paramsetprefix"] = "othername"
+    env.reset(model)
+    assert env.model.get_param("concurrent/paramsetprefix") == "othername"
+
+
+def test_BranchingPool(model):
+    """Reset and step environments in parallel, with one result per environment."""
+    pool = ecole.environment.BranchingPool(3, n_threads=2)
+    pool.seed(0)
+    assert len(pool) == 3
+    observations, action_sets, rewards, dones, _ = pool.reset([model] * 3)
+    assert len(observations) == len(action_sets) == len(rewards) == len(dones) == 3
+    assert model.stage == ecole.scip.Stage.Problem  # Models are copied
+
+    actions = [
+        ecole.Default if done else int(action_set[0]) for done, action_set in zip(dones, action_sets)
+    ]
+    observations, action_sets, rewards, dones, _ = pool.step(actions)
+    assert len(dones) == 3
+    for obs, done in zip(observations, dones):
+        assert done or isinstance(obs, ecole.observation.NodeBipartiteObs)
+
+
+def test_ConfiguringPool(problem_file):
+    """Reset from files and configure environments in parallel."""
+    pool = ecole.environment.ConfiguringPool(2, n_threads=2)
+    _, _, _, dones, _ = pool.reset([str(problem_file)] * 2)
+    assert not any(dones)
+    _, _, _, dones, _ = pool.step([{"limits/nodes": 1}] * 2)
+    assert all(dones)
@@ -115,3 +115,26 @@ def test_CapacitatedFacilityLocationGenerator_parameters():
     )
     assert generator.ratio == -1
     assert generator.demand_interval == (1, 5)
+
+
+def test_PrefetchingGenerator(instance_generator):
+    """Wrap every generator and iterate in worker threads."""
+    generator = ecole.instance.PrefetchingGenerator(instance_generator, n_workers=2, queue_size=2)
+    assert generator.n_workers == 2
+    for model in itertools.islice(generator, 3):
+        assert isinstance(model, ecole.scip.Model)
+
+
+def test_PrefetchingGenerator_rejects_other_objects():
+    """Only generators from ecole.instance can be copied to the workers."""
+    with pytest.raises(ValueError):
+        ecole.instance.PrefetchingGenerator(object())
+
+
+def test_PrefetchingGenerator_keeps_sampling_mode(tmp_dataset):
+    """Files are read in the order of the wrapped generator, each one once when removing them."""
+    files = ecole.instance.FileGenerator(directory=str(tmp_dataset), sampling_mode="remove")
+    generator = ecole.instance.PrefetchingGenerator(files, n_workers=2)
+    names = [model.name for model in generator]
+    assert names == [model.name for model in files]
+    assert len(set(names)) == len(names) == 3
@@ -27,12 +27,18 @@ def pytest_generate_tests(metafunc):
         all_observation_functions = (
             ecole.observation.Nothing(),
             ecole.observation.NodeBipartite(),
+            ecole.observation.NodeBipartiteF32(),
             ecole.observation.MilpBipartite(),
+            ecole.observation.MilpBipartiteF32(),
             ecole.observation.StrongBranchingScores(True),
             ecole.observation.StrongBranchingScores(False),
+            ecole.observation.StrongBranchingScores(n_threads=2),
+            ecole.observation.PartialStrongBranchingScores(max_candidates=2),
             ecole.observation.Pseudocosts(),
             ecole.observation.Khalil2016(),
+            ecole.observation.Khalil2016F32(),
             ecole.observation.Hutter2011(),
+            ecole.observation.Hutter2011F32(),
         )
         metafunc.parametrize("observation_function", all_observation_functions)
 
@@ -101,6 +107,28 @@ def test_NodeBipartite_observation(model):
     assert len(obs.RowFeatures.__members__) == obs.row_features.shape[1]
 
 
+def test_NodeBipartite_csr_edges_share_indices(model):
+    """Observations with an unchanged sparsity pattern expose the same index memory."""
+    obs_func = ecole.observation.NodeBipartite(csr_edges=True)
+    first = make_obs(obs_func, model).edge_features_csr
+    second = obs_func.extract(model, False).edge_features_csr
+    assert_array(first.row_ptrs, dtype=np.uint64)
+    assert_array(first.col_indices, dtype=np.uint64)
+    assert np.shares_memory(first.row_ptrs, second.row_ptrs)
+    assert np.shares_memory(first.col_indices, second.col_indices)
+    assert not first.col_indices.flags.writeable
+
+
+def test_NodeBipartiteF32_observation(model):
+    """Observation of NodeBipartiteF32 holds single precision arrays."""
+    obs = make_obs(ecole.observation.NodeBipartiteF32(), model)
+    assert isinstance(obs, ecole.observation.NodeBipartiteObsF32)
+    assert_array(obs.variable_features, ndim=2, dtype=np.float32)
+    assert_array(obs.row_features, ndim=2, dtype=np.float32)
+    assert_array(obs.edge_features.values, dtype=np.float32)
+    assert obs.VariableFeatures is ecole.observation.NodeBipartiteObs.VariableFeatures
+
+
 def test_MilpBipartite_observation(model):
     """Observation of MilpBipartite is a type with array attributes."""
     obs = make_obs(ecole.observation.MilpBipartite(), model, stage=ecole.scip.Stage.Problem)
@@ -121,6 +149,23 @@ def test_StrongBranchingScores_observation(model):
     assert_array(obs)
 
 
+def test_StrongBranchingScores_n_threads(model):
+    """Scores computed in threads are the same as with SCIP branching rule."""
+    obs_serial = make_obs(ecole.observation.StrongBranchingScores(), model.copy_orig())
+    obs_threads = make_obs(ecole.observation.StrongBranchingScores(n_threads=2), model.copy_orig())
+    assert_array(obs_threads)
+    assert np.allclose(obs_serial, obs_threads, rtol=1e-5, equal_nan=True)
+
+
+def test_PartialStrongBranchingScores_observation(model):
+    """Observation of PartialStrongBranchingScores is a type with array attributes."""
+    obs = make_obs(ecole.observation.PartialStrongBranchingScores(max_lp_iterations=100), model)
+    assert isinstance(obs, ecole.observation.PartialStrongBranchingScoresObs)
+    assert_array(obs.scores)
+    assert_array(obs.is_exact, ndim=1, dtype=bool)
+    assert np.all(~obs.is_exact | ~np.isnan(obs.scores))
+
+
 def test_Pseudocosts_observation(model):
     """Observation of Pseudocosts is a numpy array."""
     obs = make_obs(ecole.observation.Pseudocosts(), model)
@@ -136,6 +181,60 @@ def test_Khalil2016_observation(model):
     assert len(obs.Features.__members__) == obs.features.shape[1]
 
 
+def test_Khalil2016_feature_mask(model):
+    """Only the selected features are in the observation, in the order of the enum."""
+    Features = ecole.observation.Khalil2016Obs.Features
+    full_obs = make_obs(ecole.observation.Khalil2016(), model)
+    selected = [Features.slack, Features.obj_coef]
+    obs = make_obs(ecole.observation.Khalil2016(features=selected), model)
+    assert obs.features.shape == (full_obs.features.shape[0], 2)
+    np.testing.assert_array_equal(obs.features[:, 0], full_obs.features[:, int(Features.obj_coef)])
+    np.testing.assert_array_equal(obs.features[:, 1], full_obs.features[:, int(Features.slack)])
+
+
+def test_Khalil2016_profiler(model):
+    """The time spent in each group of features is recorded when enabled."""
+    obs_func = ecole.observation.Khalil2016()
+    assert not obs_func.profiler.enabled
+    obs_func.profiler.enabled = True
+    make_obs(obs_func, model)
+
+    groups = {group.name: group for group in obs_func.profiler.groups}
+    assert groups["static features"].n_calls == 1
+    assert all(group.wall_time >= 0 and group.cpu_time >= 0 for group in groups.values())
+    assert obs_func.profiler.group("unknown") is None
+    obs_func.profiler.reset()
+    assert obs_func.profiler.groups == []
+
+
+def test_Khalil2016_cache_directory(model, tmp_path):
+    """Static features are stored in the cache directory and reused."""
+    obs = make_obs(ecole.observation.Khalil2016(cache_directory=tmp_path), model.copy_orig())
+    assert len(list(tmp_path.iterdir())) == 1
+    cached_obs = make_obs(ecole.observation.Khalil2016(cache_directory=tmp_path), model)
+    assert np.array_equal(obs.features, cached_obs.features, equal_nan=True)
+    assert len(list(tmp_path.iterdir())) == 1
+
+
+def test_Khalil2016_collate(model):
+    """Observations collated in a batch are the same as extracted ones."""
+    obs_funcs = [ecole.observation.Khalil2016(), ecole.observation.Khalil2016()]
+    obs = make_obs(obs_funcs[0], model)
+    n_vars, n_features = obs.features.shape
+    data = np.empty((3 * n_vars, n_features))
+    offsets = np.empty(4, dtype=np.uint64)
+    batch = ecole.observation.BatchMatrix(data, offsets)
+
+    ecole.observation.collate(obs_funcs, [model, model], [False, False], batch)
+    assert batch.n_observations == 2
+    assert batch.n_rows == 2 * n_vars
+    assert list(offsets[:3]) == [0, n_vars, 2 * n_vars]
+    np.testing.assert_array_equal(data[n_vars : 2 * n_vars], obs.features)
+
+    with pytest.raises(ValueError):
+        ecole.observation.BatchMatrix(data.astype(np.float32), offsets)
+
+
 def test_Hutter2011_observation(model):
     """Observation of Hutter2011 is a numpy vector."""
     obs = make_obs(ecole.observation.Hutter2011(), model, stage=ecole.scip.Stage.Problem)
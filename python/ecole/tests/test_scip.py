@@ -83,6 +83,13 @@ def test_name(model):
     assert model.name == "foo"
 
 
+def test_fingerprint(model, problem_file):
+    """Models of the same problem have the same fingerprint, whatever their name."""
+    other = ecole.scip.Model.from_file(problem_file)
+    other.name = "other"
+    assert model.fingerprint() == other.fingerprint()
+
+
 def test_stage(model):
     assert model.stage == ecole.scip.Stage.Problem
 
@@ -133,6 +140,35 @@ def test_set_params(model):
         assert model.get_param(name) == params[name]
 
 
+def test_set_compiled_params(model):
+    params = {name: "v" if param_type is str else param_type(1) for name, param_type in names_types}
+    compiled = ecole.scip.CompiledParams(model, params)
+    assert len(compiled) == len(params)
+
+    other = model.copy_orig()
+    other.set_params(compiled)
+    for name, _ in names_types:
+        assert other.get_param(name) == params[name]
+
+
+def test_compiled_params_are_validated(model):
+    with pytest.raises(ecole.scip.ScipError):
+        ecole.scip.CompiledParams(model, {"not/a/param": 1})
+    with pytest.raises(ecole.scip.ScipError):
+        ecole.scip.CompiledParams(model, {"limits/solutions": -5})
+
+
+def test_param_snapshot(model):
+    snapshot = ecole.scip.ParamSnapshot(model)
+    assert len(snapshot) == len(model.get_params())
+
+    params = {name: "v" if param_type is str else param_type(1) for name, param_type in names_types}
+    model.set_params(params)
+    assert len(snapshot.diff(ecole.scip.ParamSnapshot(model))) > 0
+    assert snapshot.apply(model) > 0
+    assert snapshot.diff(ecole.scip.ParamSnapshot(model)) == []
+
+
 @pytest.mark.slow
 def test_transform_prob(model):
     model.transform_prob()